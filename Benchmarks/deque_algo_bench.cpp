@@ -0,0 +1,82 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "../Headers/Deque.h"
+#include "../Headers/Vector.h"
+
+// bulk algorithms over a deque: MyStl::copy, fill, equal and for_each run per block on raw pointers, the
+// element loops below step a Deque_Iterator and check for the end of a block on every element
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+template <typename T>
+void run(const std::string& name, std::size_t n, std::size_t rounds){
+    MyStl::Deque<T> d;
+    for (std::size_t i = 0; i < n; ++i) d.push_back(static_cast<T>(i));
+    MyStl::Vector<T> v(n);
+    std::int64_t sum = 0;
+
+    double loop_copy = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r){
+            T* out = v.data();
+            for (auto it = d.begin(); it != d.end(); ++it) *out++ = *it;
+            sum += v[r % n];
+        }
+    });
+    double seg_copy = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r){
+            MyStl::copy(d.begin(), d.end(), v.data());
+            sum += v[r % n];
+        }
+    });
+    double seg_copy_in = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r){
+            MyStl::copy(v.data(), v.data() + n, d.begin());
+            sum += d[r % n];
+        }
+    });
+    double loop_fill = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r){
+            for (auto it = d.begin(); it != d.end(); ++it) *it = static_cast<T>(r);
+            sum += d[r % n];
+        }
+    });
+    double seg_fill = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r){
+            MyStl::fill(d.begin(), d.end(), static_cast<T>(r));
+            sum += d[r % n];
+        }
+    });
+    MyStl::copy(d.begin(), d.end(), v.data());
+    double seg_equal = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r) sum += MyStl::equal(d.begin(), d.end(), v.data());
+    });
+    double seg_for_each = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r){
+            MyStl::for_each(d.begin(), d.end(), [&sum](const T& x){sum += x;});
+        }
+    });
+
+    double gb = static_cast<double>(n) * sizeof(T) * rounds / 1e6;
+    std::cout << name << ", " << n << " elements, GB/s: copy out " << gb / loop_copy << " element loop vs "
+              << gb / seg_copy << " per block, copy in " << gb / seg_copy_in << ", fill " << gb / loop_fill
+              << " vs " << gb / seg_fill << ", equal " << gb / seg_equal << ", for_each " << gb / seg_for_each
+              << " (checksum " << sum << ")" << std::endl;
+}
+
+int main(){
+    run<char>("char", 1 << 20, 500);
+    run<std::int32_t>("int32", 1 << 20, 200);
+    run<double>("double", 1 << 20, 200);
+
+    return 0;
+}
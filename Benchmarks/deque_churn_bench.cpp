@@ -0,0 +1,72 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "../Headers/Deque.h"
+
+// a deque used as a FIFO queue under steady load: a fixed window of elements, one push_back and one pop_front
+// per round. Blocks emptied at the front are reused at the back, build with -DDEQUE_MAX_SPARE_BLOCKS=0 for the
+// numbers without the spare block cache
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static std::size_t block_allocations = 0;
+
+// std::allocator that counts the element block allocations, the map goes through a rebound copy
+template <typename T>
+struct Counting_Allocator : std::allocator<T> {
+    using value_type = T;
+
+    template <typename U> struct rebind {using other = Counting_Allocator<U>;};
+
+    Counting_Allocator() = default;
+
+    template <typename U> Counting_Allocator(const Counting_Allocator<U>&) {}
+
+    T* allocate(std::size_t n){
+        if (!std::is_pointer<T>::value) ++block_allocations;
+        return std::allocator<T>::allocate(n);
+    }
+};
+
+template <typename DequeT>
+void churn(const std::string& name, std::size_t window, std::size_t rounds){
+    DequeT d;
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < window; ++i) d.push_back(static_cast<std::int64_t>(i));
+
+    block_allocations = 0;
+    double ms = time_ms([&](){
+        for (std::size_t i = 0; i < rounds; ++i){
+            sum += d.front();
+            d.pop_front();
+            d.push_back(static_cast<std::int64_t>(i));
+        }
+    });
+
+    std::cout << name << ", window " << window << ": " << rounds / ms / 1000 << " Mops/s, "
+              << block_allocations << " block allocations, map of " << d.map_size() << " slots recentered "
+              << d.map_stats().recenters << " times, reallocated " << d.map_stats().reallocations
+              << " times (checksum " << sum << ")" << std::endl;
+}
+
+int main(){
+    constexpr std::size_t rounds = 50000000;
+    std::cout << "spare blocks kept: " << DEQUE_MAX_SPARE_BLOCKS << std::endl;
+
+    for (std::size_t window : {16, 1000, 100000}){
+        churn<MyStl::Deque<std::int64_t, Counting_Allocator<std::int64_t>>>("512 B blocks", window, rounds);
+        churn<MyStl::Deque<std::int64_t, Counting_Allocator<std::int64_t>, 4096>>("4 KiB blocks", window, rounds);
+    }
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <functional>
+#include <random>
+#include <string>
+
+#include "../Headers/Vector.h"
+#include "../Headers/set.h"
+#include "../Headers/flat_set.h"
+
+// lookups of random keys in set and flat_set, the latter once with the default branchless search and once
+// with the plain binary search, then bulk inserting a batch of new keys into an existing flat_set
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// same keys, but not arithmetic, so flat_set falls back to the branchy binary search
+struct Key {
+    std::uint64_t v;
+
+    bool operator<(const Key& other) const {return v < other.v;}
+};
+
+int main(){
+    std::mt19937_64 rng(42);
+    std::size_t sink = 0;
+    constexpr std::size_t lookups = 2000000;
+
+    for (std::size_t n : {1000, 100000, 10000000}){
+        MyStl::Vector<std::uint64_t> keys;
+        MyStl::Vector<Key> wrapped;
+        keys.reserve(n);
+        wrapped.reserve(n);
+        for (std::size_t i = 0; i < n; ++i){
+            keys.push_back(i * 7 + 3);
+            wrapped.push_back(Key{i * 7 + 3});
+        }
+
+        MyStl::Vector<std::uint64_t> probes;
+        probes.reserve(lookups);
+        for (std::size_t i = 0; i < lookups; ++i) probes.push_back(rng() % (n * 7 + 3));
+
+        MyStl::set<std::uint64_t> tree(MyStl::sorted_unique, keys.begin(), keys.end());
+        MyStl::flat_set<std::uint64_t> flat(MyStl::sorted_unique, keys.begin(), keys.end());
+        MyStl::flat_set<Key> flat_binary(MyStl::sorted_unique, wrapped.begin(), wrapped.end());
+
+        double tree_ms = time_ms([&](){
+            for (auto p : probes) sink += tree.find(p) != tree.end();
+        });
+
+        double branchless_ms = time_ms([&](){
+            for (auto p : probes) sink += flat.find(p) != flat.end();
+        });
+
+        double binary_ms = time_ms([&](){
+            for (auto p : probes) sink += flat_binary.find(Key{p}) != flat_binary.end();
+        });
+
+        double lookup_ns = 1e6 / lookups;
+        std::cout << n << " keys: set::find " << tree_ms * lookup_ns << " ns, flat_set::find branchless "
+                  << branchless_ms * lookup_ns << " ns, binary " << binary_ms * lookup_ns << " ns" << std::endl;
+
+        // a tenth of n new keys at once, against inserting them one by one
+        MyStl::Vector<std::uint64_t> batch;
+        for (std::size_t i = 0; i < n / 10; ++i) batch.push_back(rng() % (n * 7 + 3));
+
+        MyStl::flat_set<std::uint64_t> bulk(flat);
+        double bulk_ms = time_ms([&](){bulk.insert(batch.begin(), batch.end());});
+
+        MyStl::flat_set<std::uint64_t> single(flat);
+        double single_ms = -1;
+        if (n <= 100000){
+            single_ms = time_ms([&](){
+                for (auto k : batch) single.insert(k);
+            });
+        }
+        sink += bulk.size() + single.size();
+
+        std::cout << "    inserting " << batch.size() << " keys: range insert " << bulk_ms << " ms, one by one "
+                  << (single_ms < 0 ? "skipped" : std::to_string(single_ms) + " ms") << std::endl;
+    }
+
+    std::cout << "(checksum " << sink << ")" << std::endl;
+    return 0;
+}
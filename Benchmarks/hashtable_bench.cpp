@@ -0,0 +1,73 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../Headers/tree.h"
+#include "../Headers/unordered_set.h"
+
+// find() throughput of the Swiss table unordered_set against the _RB_tree behind set,
+// half of the lookups hit and half miss, keys are random 64 bit integers
+
+using Clock = std::chrono::steady_clock;
+
+struct Identity{
+    const std::uint64_t& operator()(const std::uint64_t& x) const {return x;}
+};
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+template <typename Table>
+std::size_t lookups(const Table& t, const std::vector<std::uint64_t>& probes){
+    std::size_t hits = 0;
+    for (auto key : probes) hits += t.find(key) != t.end();
+    return hits;
+}
+
+int main(int argc, char** argv){
+    // the largest size needs around a gigabyte, pass a smaller maximum on small machines
+    const std::size_t max_keys = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    const std::size_t probe_count = 4000000;
+    std::size_t sink = 0;
+
+    using Tree = MyStl::_RB_tree<std::uint64_t, std::uint64_t, Identity, std::less<std::uint64_t>>;
+
+    for (std::size_t n = 1000; n <= max_keys; n *= 10){
+        std::mt19937_64 gen(n);
+        std::vector<std::uint64_t> keys(n);
+        for (auto& k : keys) k = gen();
+
+        // every other probe is a key that was inserted, the rest are (almost surely) absent
+        std::vector<std::uint64_t> probes(probe_count);
+        for (std::size_t i = 0; i < probe_count; ++i){
+            probes[i] = (i & 1) ? keys[gen() % n] : gen();
+        }
+
+        double tree_ms, hash_ms;
+        {
+            Tree tree;
+            for (auto k : keys) tree.insert_unique(k);
+            tree_ms = time_ms([&](){sink += lookups(tree, probes);});
+        }
+        {
+            MyStl::unordered_set<std::uint64_t> table;
+            for (auto k : keys) table.insert(k);
+            hash_ms = time_ms([&](){sink += lookups(table, probes);});
+        }
+
+        std::cout << n << " keys: _RB_tree::find " << tree_ms * 1e6 / probe_count << " ns, unordered_set::find "
+                  << hash_ms * 1e6 / probe_count << " ns (" << tree_ms / hash_ms << "x)" << std::endl;
+    }
+
+    std::cout << "(checksum " << sink << ")" << std::endl;
+    return 0;
+}
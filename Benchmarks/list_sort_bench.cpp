@@ -0,0 +1,50 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <random>
+#include <string>
+
+#include "../Headers/List.h"
+
+// List::sort on 1e6 to 1e7 nodes of random integers, with std::list::sort on the same values for reference.
+// The second sort gets the already sorted list, whose nodes the first sort left scattered in memory
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+template <typename ListT>
+void run(const std::string& name, std::size_t n){
+    std::mt19937_64 rng(42);
+    ListT l;
+    for (std::size_t i = 0; i < n; ++i) l.push_back(static_cast<std::int64_t>(rng() % (n * 4)));
+
+    double random_ms = time_ms([&](){l.sort();});
+    double sorted_ms = time_ms([&](){l.sort();});
+
+    bool ok = true;
+    std::int64_t prev = INT64_MIN, sum = 0;
+    for (auto x : l){
+        ok = ok && prev <= x;
+        prev = x;
+        sum += x;
+    }
+
+    std::cout << name << ", " << n << " nodes: random " << random_ms << " ms, already sorted " << sorted_ms
+              << " ms, sorted: " << ok << " (checksum " << sum << ")" << std::endl;
+}
+
+int main(){
+    for (std::size_t n : {1000000, 3000000, 10000000}){
+        run<MyStl::List<std::int64_t>>("MyStl::List", n);
+        run<std::list<std::int64_t>>("std::list", n);
+    }
+
+    return 0;
+}
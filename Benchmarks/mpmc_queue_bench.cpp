@@ -0,0 +1,94 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Headers/Deque.h"
+#include "../Headers/MpmcQueue.h"
+
+// half the threads push a share of a fixed number of items, the other half pop them, for 2 to 64 threads:
+// MpmcQueue against a Deque behind a mutex. Waiting consumers yield, numbers past the machine's core count
+// show how the queues hold up when threads get descheduled
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// the baseline, push and try_pop with the same signatures as MpmcQueue's
+class Locked_Deque{
+    private:
+        std::mutex _mutex;
+        MyStl::Deque<std::int64_t> _deque;
+
+    public:
+        void push(std::int64_t value){
+            std::lock_guard<std::mutex> lock(_mutex);
+            _deque.push_back(value);
+        }
+
+        bool try_pop(std::int64_t& value){
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_deque.empty()) return false;
+
+            value = _deque.front();
+            _deque.pop_front();
+            return true;
+        }
+};
+
+template <typename Queue>
+void run(const std::string& name, std::size_t threads, std::size_t count){
+    Queue queue;
+    std::size_t producers = threads / 2, consumers = threads - producers;
+    std::size_t per_producer = count / producers;
+    std::atomic<std::size_t> popped{0};
+    std::atomic<std::int64_t> sum{0};
+
+    double ms = time_ms([&](){
+        std::vector<std::thread> pool;
+        for (std::size_t p = 0; p < producers; ++p){
+            pool.emplace_back([&, p](){
+                for (std::size_t i = 0; i < per_producer; ++i) queue.push(static_cast<std::int64_t>(p * per_producer + i));
+            });
+        }
+        for (std::size_t c = 0; c < consumers; ++c){
+            pool.emplace_back([&](){
+                std::int64_t value, local = 0;
+                while (popped.load(std::memory_order_relaxed) < producers * per_producer){
+                    if (queue.try_pop(value)){
+                        local += value;
+                        popped.fetch_add(1, std::memory_order_relaxed);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+                sum += local;
+            });
+        }
+        for (auto& t : pool) t.join();
+    });
+
+    std::cout << name << ", " << threads << " threads: " << producers * per_producer / ms / 1000 << " Mitems/s (checksum "
+              << sum << ")" << std::endl;
+}
+
+int main(){
+    constexpr std::size_t count = 4000000;
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+    for (std::size_t threads : {2, 4, 8, 16, 32, 64}){
+        run<MyStl::MpmcQueue<std::int64_t>>("MpmcQueue", threads, count);
+        run<Locked_Deque>("mutex + Deque", threads, count);
+    }
+
+    return 0;
+}
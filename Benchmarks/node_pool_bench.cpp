@@ -0,0 +1,79 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <functional>
+#include <random>
+#include <string>
+
+#include "../Headers/List.h"
+#include "../Headers/tree.h"
+#include "../Headers/NodePool.h"
+
+// insert/erase throughput of List and _RB_tree, per-node std::allocator vs NodePool
+
+using Clock = std::chrono::steady_clock;
+
+struct Identity{
+    const int& operator()(const int& x) const {return x;}
+};
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void report(const std::string& name, double baseline_ms, double pool_ms, std::size_t ops){
+    std::cout << name << ": std::allocator " << ops / baseline_ms / 1000 << " Mops/s, NodePool "
+              << ops / pool_ms / 1000 << " Mops/s (" << baseline_ms / pool_ms << "x)" << std::endl;
+}
+
+// keeps a window of live elements, pushing at the back and popping at the front
+template <typename ListT>
+std::int64_t list_churn(std::size_t window, std::size_t rounds){
+    ListT l;
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < window; ++i) l.push_back(static_cast<int>(i));
+    for (std::size_t i = 0; i < rounds; ++i){
+        sum += l.front();
+        l.pop_front();
+        l.push_back(static_cast<int>(i));
+    }
+    return sum;
+}
+
+// inserts and erases random keys so that the tree size stays around half of the key range
+template <typename TreeT>
+std::size_t tree_churn(std::size_t key_range, std::size_t rounds){
+    TreeT t;
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, static_cast<int>(key_range) - 1);
+    std::size_t hits = 0;
+    for (std::size_t i = 0; i < rounds; ++i){
+        t.insert_unique(dist(gen));
+        hits += t.erase(dist(gen));
+    }
+    return hits + t.size();
+}
+
+int main(){
+    const std::size_t window = 100000, rounds = 2000000;
+    std::int64_t sink = 0;
+
+    double list_std = time_ms([&](){sink += list_churn<MyStl::List<int>>(window, rounds);});
+    double list_pool = time_ms([&](){sink += list_churn<MyStl::List<int, MyStl::NodePool<int>>>(window, rounds);});
+    report("List push_back/pop_front", list_std, list_pool, 2 * rounds);
+
+    using Std_Tree = MyStl::_RB_tree<int, int, Identity, std::less<int>>;
+    using Pool_Tree = MyStl::_RB_tree<int, int, Identity, std::less<int>, MyStl::NodePool<int>>;
+    // small trees stay in cache so allocation dominates, large ones are dominated by the search
+    for (std::size_t key_range : {2000, 200000}){
+        double tree_std = time_ms([&](){sink += tree_churn<Std_Tree>(key_range, rounds);});
+        double tree_pool = time_ms([&](){sink += tree_churn<Pool_Tree>(key_range, rounds);});
+        report("_RB_tree insert_unique/erase, " + std::to_string(key_range) + " keys", tree_std, tree_pool, 2 * rounds);
+    }
+
+    std::cout << "(checksum " << sink << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "../Headers/ParallelAlgorithm.h"
+#include "../Headers/Vector.h"
+
+// the same algorithms with execution::seq and execution::par over a large Vector, the parallel ones spread
+// over Thread_Pool::default_pool(), i.e. one thread per hardware thread unless MYSTL_DEFAULT_POOL_THREADS says otherwise
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+template <typename Policy>
+void run(const std::string& name, const Policy& policy, std::size_t n, std::size_t rounds){
+    MyStl::Vector<std::uint32_t> v(n), w(n), out(n);
+    for (std::size_t i = 0; i < n; ++i) v[i] = static_cast<std::uint32_t>(i * 2654435761u);
+    std::int64_t sum = 0;
+
+    double fill = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r){
+            MyStl::fill(policy, w.begin(), w.end(), static_cast<std::uint32_t>(r));
+            sum += w[r % n];
+        }
+    });
+    double copy = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r){
+            MyStl::copy(policy, v.begin(), v.end(), w.begin());
+            sum += w[r % n];
+        }
+    });
+    double equal = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r) sum += MyStl::equal(policy, v.begin(), v.end(), w.begin());
+    });
+    // a little arithmetic per element, so the work isn't only memory traffic
+    double for_each = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r){
+            MyStl::for_each(policy, w.begin(), w.end(), [](std::uint32_t& x){
+                for (int k = 0; k < 8; ++k) x = x * 1664525u + 1013904223u;
+            });
+            sum += w[r % n];
+        }
+    });
+    double copy_if = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r){
+            auto end = MyStl::copy_if(policy, v.begin(), v.end(), out.begin(), [](std::uint32_t x){return x % 3 == 0;});
+            sum += end - out.begin();
+        }
+    });
+
+    std::cout << name << ", " << n << " elements, ms per call: fill " << fill / rounds << ", copy " << copy / rounds
+              << ", equal " << equal / rounds << ", for_each " << for_each / rounds << ", copy_if " << copy_if / rounds
+              << " (checksum " << sum << ")" << std::endl;
+}
+
+int main(){
+    std::cout << "threads: " << MyStl::Thread_Pool::default_pool().concurrency() << std::endl;
+
+    const std::size_t n = 1 << 25;
+    run("seq", MyStl::execution::seq, n, 5);
+    run("par", MyStl::execution::par, n, 5);
+
+    return 0;
+}
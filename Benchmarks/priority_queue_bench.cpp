@@ -0,0 +1,117 @@
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../Headers/PriorityQueue.h"
+#include "../Headers/Vector.h"
+
+// a timer queue under the hold model: the earliest deadline is taken out and goes back in a random period
+// later, with the queue size staying fixed. std::priority_queue against MyStl::priority_queue with 2 and 4
+// children per node, popping and pushing separately and with replace_top. Then filling a queue in bulk,
+// push by push against push_range
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+struct Timer{
+    std::uint64_t deadline;
+    std::uint64_t id;
+};
+
+struct Later{
+    bool operator()(const Timer& lhs, const Timer& rhs) const {return lhs.deadline > rhs.deadline;}
+};
+
+template <typename Queue>
+std::uint64_t hold(Queue& q, std::size_t rounds, bool replace){
+    std::mt19937_64 gen(7);
+    std::uint64_t checksum = 0;
+    for (std::size_t i = 0; i < rounds; ++i){
+        Timer t = q.top();
+        checksum += t.deadline;
+        t.deadline += 1 + gen() % 1000000;
+        if (replace) q.replace_top(t);
+        else{
+            q.pop();
+            q.push(t);
+        }
+    }
+    return checksum;
+}
+
+template <typename Queue>
+std::uint64_t hold_std(Queue& q, std::size_t rounds){
+    std::mt19937_64 gen(7);
+    std::uint64_t checksum = 0;
+    for (std::size_t i = 0; i < rounds; ++i){
+        Timer t = q.top();
+        checksum += t.deadline;
+        t.deadline += 1 + gen() % 1000000;
+        q.pop();
+        q.push(t);
+    }
+    return checksum;
+}
+
+void run_hold(std::size_t n, std::size_t rounds){
+    std::mt19937_64 gen(42);
+    MyStl::Vector<Timer> timers;
+    for (std::size_t i = 0; i < n; ++i) timers.push_back(Timer{gen() % 1000000, i});
+
+    std::priority_queue<Timer, std::vector<Timer>, Later> q_std(Later(), std::vector<Timer>(timers.data(), timers.data() + n));
+    MyStl::priority_queue<Timer, MyStl::Vector<Timer>, Later> q_2(Later(), timers), q_2r(Later(), timers);
+    MyStl::priority_queue<Timer, MyStl::Vector<Timer>, Later, 4> q_4(Later(), timers), q_4r(Later(), timers);
+
+    std::uint64_t c_std = 0, c_2 = 0, c_2r = 0, c_4 = 0, c_4r = 0;
+    double t_std = time_ms([&](){c_std = hold_std(q_std, rounds);});
+    double t_2 = time_ms([&](){c_2 = hold(q_2, rounds, false);});
+    double t_2r = time_ms([&](){c_2r = hold(q_2r, rounds, true);});
+    double t_4 = time_ms([&](){c_4 = hold(q_4, rounds, false);});
+    double t_4r = time_ms([&](){c_4r = hold(q_4r, rounds, true);});
+
+    bool same = c_std == c_2 && c_std == c_2r && c_std == c_4 && c_std == c_4r;
+    std::cout << n << " timers, " << rounds << " rounds, ms: std::priority_queue " << t_std << ", binary " << t_2
+              << ", binary replace_top " << t_2r << ", 4-ary " << t_4 << ", 4-ary replace_top " << t_4r
+              << (same ? "" : " MISMATCH") << " (checksum " << c_std << ")" << std::endl;
+}
+
+template <std::size_t Arity>
+void run_fill(std::size_t n){
+    std::mt19937_64 gen(42);
+    MyStl::Vector<Timer> timers;
+    for (std::size_t i = 0; i < n; ++i) timers.push_back(Timer{gen(), i});
+
+    MyStl::priority_queue<Timer, MyStl::Vector<Timer>, Later, Arity> q_push, q_range;
+    double t_push = time_ms([&](){for (const Timer& t : timers) q_push.push(t);});
+    double t_range = time_ms([&](){q_range.push_range(timers.begin(), timers.end());});
+
+    std::uint64_t checksum = 0;
+    bool same = true;
+    for (std::size_t i = 0; i < 1000; ++i){
+        same = same && q_push.top().deadline == q_range.top().deadline;
+        checksum += q_range.top().id;
+        q_push.pop();
+        q_range.pop();
+    }
+    std::cout << n << " timers into a " << Arity << "-ary queue, ms: push each " << t_push << ", push_range " << t_range
+              << (same ? "" : " MISMATCH") << " (checksum " << checksum << ")" << std::endl;
+}
+
+int main(){
+    for (std::size_t n : {1000, 100000, 4000000}) run_hold(n, 4000000);
+    run_fill<2>(10000000);
+    run_fill<4>(10000000);
+
+    return 0;
+}
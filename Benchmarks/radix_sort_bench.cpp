@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "../Headers/Sort.h"
+#include "../Headers/Vector.h"
+
+// MyStl::radix_sort with 8, 11 and 16 bit digits against the comparison sorts, on random keys over their whole range
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+struct Order{
+    std::uint64_t id;
+    std::uint32_t price;
+    std::uint32_t quantity;
+};
+
+template <typename T, typename Key, typename Make>
+void run(const std::string& name, std::size_t n, Key key, Make make){
+    MyStl::Vector<T> input;
+    input.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) input.push_back(make());
+    auto less = [&key](const T& lhs, const T& rhs){return key(lhs) < key(rhs);};
+
+    MyStl::Vector<T> v(input);
+    double t_std = time_ms([&](){std::sort(v.data(), v.data() + n, less);});
+    MyStl::Vector<T> sorted(v);
+
+    v = input;
+    double t_pdq = time_ms([&](){MyStl::sort(v.begin(), v.end(), less);});
+    v = input;
+    double t_8 = time_ms([&](){MyStl::radix_sort<8>(v.begin(), v.end(), key);});
+    v = input;
+    double t_11 = time_ms([&](){MyStl::radix_sort<11>(v.begin(), v.end(), key);});
+    v = input;
+    double t_16 = time_ms([&](){MyStl::radix_sort<16>(v.begin(), v.end(), key);});
+
+    bool same = true;
+    for (std::size_t i = 0; i < n; ++i) same = same && key(v[i]) == key(sorted[i]);
+    std::cout << name << ", " << n << " elements, ms: std::sort " << t_std << ", MyStl::sort " << t_pdq
+              << ", radix_sort 8 bit digits " << t_8 << ", 11 bit " << t_11 << ", 16 bit " << t_16
+              << (same ? "" : " MISMATCH") << std::endl;
+}
+
+int main(){
+    std::mt19937_64 gen(42);
+    for (std::size_t n : {100000, 10000000}){
+        run<std::uint32_t>("uint32", n, MyStl::Radix_Identity(), [&](){return static_cast<std::uint32_t>(gen());});
+        run<std::uint64_t>("uint64", n, MyStl::Radix_Identity(), [&](){return gen();});
+        run<double>("double", n, MyStl::Radix_Identity(), [&](){return static_cast<double>(static_cast<std::int64_t>(gen())) / 1e6;});
+        run<Order>("Order by price", n, [](const Order& o){return o.price;},
+                   [&](){return Order{gen(), static_cast<std::uint32_t>(gen()), 1};});
+    }
+
+    return 0;
+}
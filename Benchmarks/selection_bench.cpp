@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "../Headers/Deque.h"
+#include "../Headers/Sort.h"
+#include "../Headers/Vector.h"
+
+// the 99th percentile and the 100 largest of a batch of latencies, picked out by selection against sorting the
+// whole batch first. Top_K reads the values one at a time as if they were arriving and never holds more than k
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void percentile(const MyStl::Vector<double>& input){
+    std::size_t n = input.size(), p99 = n * 99 / 100;
+    MyStl::Vector<double> v_sort(input), v_std(input), v_nth(input);
+    MyStl::Deque<double> d_nth;
+    for (double x : input) d_nth.push_back(x);
+
+    double t_sort = time_ms([&](){MyStl::sort(v_sort.begin(), v_sort.end());});
+    double t_std = time_ms([&](){std::nth_element(v_std.data(), v_std.data() + p99, v_std.data() + n);});
+    double t_nth = time_ms([&](){MyStl::nth_element(v_nth.begin(), v_nth.begin() + p99, v_nth.end());});
+    double t_deque = time_ms([&](){MyStl::nth_element(d_nth.begin(), d_nth.begin() + p99, d_nth.end());});
+
+    bool same = v_sort[p99] == v_std[p99] && v_sort[p99] == v_nth[p99] && v_sort[p99] == *(d_nth.begin() + p99);
+    std::cout << "99th percentile of " << n << ", ms: MyStl::sort " << t_sort << ", std::nth_element " << t_std
+              << ", MyStl::nth_element " << t_nth << ", on a Deque " << t_deque
+              << (same ? "" : " MISMATCH") << " (checksum " << v_nth[p99] << ")" << std::endl;
+}
+
+void largest(const MyStl::Vector<double>& input, std::size_t k){
+    std::size_t n = input.size();
+    MyStl::Vector<double> v_sort(input), v_std(input), v_partial(input), v_top;
+
+    double t_sort = time_ms([&](){MyStl::sort(v_sort.begin(), v_sort.end(), std::greater<double>());});
+    double t_std = time_ms([&](){std::partial_sort(v_std.data(), v_std.data() + k, v_std.data() + n, std::greater<double>());});
+    double t_partial = time_ms([&](){MyStl::partial_sort(v_partial.begin(), v_partial.begin() + k, v_partial.end(), std::greater<double>());});
+    double t_top = time_ms([&](){
+        MyStl::Top_K<double> top(k);
+        for (double x : input) top.push(x);
+        v_top = top.sorted();
+    });
+
+    bool same = v_top.size() == k;
+    double sum = 0;
+    for (std::size_t i = 0; same && i < k; ++i){
+        same = v_sort[i] == v_std[i] && v_sort[i] == v_partial[i] && v_sort[i] == v_top[i];
+        sum += v_top[i];
+    }
+    std::cout << k << " largest of " << n << ", ms: MyStl::sort " << t_sort << ", std::partial_sort " << t_std
+              << ", MyStl::partial_sort " << t_partial << ", Top_K " << t_top
+              << (same ? "" : " MISMATCH") << " (checksum " << sum << ")" << std::endl;
+}
+
+int main(){
+    std::mt19937_64 gen(42);
+    std::lognormal_distribution<double> latency(3.0, 1.0);
+    for (std::size_t n : {100000, 10000000}){
+        MyStl::Vector<double> input;
+        input.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) input.push_back(latency(gen));
+
+        percentile(input);
+        largest(input, 100);
+        largest(input, 10000);
+    }
+
+    return 0;
+}
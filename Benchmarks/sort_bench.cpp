@@ -0,0 +1,65 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "../Headers/Deque.h"
+#include "../Headers/Sort.h"
+#include "../Headers/Vector.h"
+
+// MyStl::sort against std::sort on the same input, for the input shapes quicksorts tend to differ on. std::sort
+// only gets the Vector since MyStl's other iterators don't carry std::iterator_traits, the Deque column shows
+// what the block structure costs MyStl::sort
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+template <typename T, typename Make>
+void run(const std::string& type, const std::string& shape, std::size_t n, Make make){
+    MyStl::Vector<T> input;
+    input.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) input.push_back(make(i));
+
+    MyStl::Vector<T> v_std(input), v_mystl(input);
+    MyStl::Deque<T> d_mystl;
+    for (const T& x : input) d_mystl.push_back(x);
+
+    double t_std = time_ms([&](){std::sort(v_std.data(), v_std.data() + n);});
+    double t_mystl = time_ms([&](){MyStl::sort(v_mystl.begin(), v_mystl.end());});
+    double t_deque = time_ms([&](){MyStl::sort(d_mystl.begin(), d_mystl.end());});
+
+    bool same = v_std == v_mystl && MyStl::equal(d_mystl.begin(), d_mystl.end(), v_std.begin());
+    std::cout << type << ", " << shape << ", " << n << " elements, ms: std::sort " << t_std << ", MyStl::sort "
+              << t_mystl << ", on a Deque " << t_deque << (same ? "" : " MISMATCH") << std::endl;
+}
+
+template <typename T, typename Random>
+void shapes(const std::string& type, std::size_t n, Random random){
+    std::mt19937_64 gen(42);
+    MyStl::Vector<T> sorted;
+    for (std::size_t i = 0; i < n; ++i) sorted.push_back(random(gen));
+    std::sort(sorted.data(), sorted.data() + n);
+
+    run<T>(type, "random", n, [&](std::size_t){return random(gen);});
+    run<T>(type, "sorted", n, [&](std::size_t i){return sorted[i];});
+    run<T>(type, "reversed", n, [&](std::size_t i){return sorted[n - 1 - i];});
+    run<T>(type, "sorted + 1% swapped", n, [&](std::size_t i){return gen() % 100 == 0 ? random(gen) : sorted[i];});
+    run<T>(type, "16 distinct values", n, [&](std::size_t){return sorted[gen() % 16 * (n / 16)];});
+}
+
+int main(){
+    const std::size_t n = 10000000;
+    shapes<std::int32_t>("int32", n, [](std::mt19937_64& gen){return static_cast<std::int32_t>(gen());});
+    shapes<double>("double", n, [](std::mt19937_64& gen){return static_cast<double>(gen() % 1000000007) / 3.0;});
+    shapes<std::string>("string", n / 10, [](std::mt19937_64& gen){return std::to_string(gen() % 100000000);});
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Headers/Deque.h"
+#include "../Headers/SpscRing.h"
+#include "../Headers/Vector.h"
+
+// one producer thread, one consumer thread: SpscRing with single and batch pushes and pops against a Deque
+// behind a mutex. Throughput moves a stream of integers one way, latency bounces one integer back and forth
+// between two queues and reports the round trip. Waiting threads yield, so the numbers stay meaningful on
+// machines with fewer cores than threads
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// the baseline, try_push and try_pop with the same signatures as SpscRing's
+class Locked_Deque{
+    private:
+        std::mutex _mutex;
+        MyStl::Deque<std::int64_t> _deque;
+
+    public:
+        bool try_push(std::int64_t value){
+            std::lock_guard<std::mutex> lock(_mutex);
+            _deque.push_back(value);
+            return true;
+        }
+
+        template <typename InputIt>
+        InputIt try_push(InputIt first, InputIt last){
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (; first != last; ++first) _deque.push_back(*first);
+            return first;
+        }
+
+        bool try_pop(std::int64_t& value){
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_deque.empty()) return false;
+
+            value = _deque.front();
+            _deque.pop_front();
+            return true;
+        }
+
+        template <typename Container>
+        std::size_t try_pop(Container& out, std::size_t max_count){
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::size_t count = 0;
+            for (; count < max_count && !_deque.empty(); ++count){
+                out.push_back(_deque.front());
+                _deque.pop_front();
+            }
+            return count;
+        }
+};
+
+template <typename Queue>
+void throughput(const std::string& name, Queue& queue, std::size_t count, std::size_t batch){
+    std::int64_t sum = 0;
+    double ms = time_ms([&](){
+        std::thread consumer([&](){
+            std::size_t seen = 0;
+            std::int64_t value;
+            MyStl::Vector<std::int64_t> out;
+            while (seen < count){
+                if (batch == 1){
+                    if (queue.try_pop(value)){
+                        sum += value;
+                        ++seen;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                } else {
+                    out.clear();
+                    if (queue.try_pop(out, batch) == 0) std::this_thread::yield();
+                    seen += out.size();
+                    for (auto x : out) sum += x;
+                }
+            }
+        });
+
+        MyStl::Vector<std::int64_t> in;
+        for (std::size_t i = 0; i < count; i += batch){
+            if (batch == 1){
+                while (!queue.try_push(static_cast<std::int64_t>(i))) std::this_thread::yield();
+                continue;
+            }
+
+            in.clear();
+            for (std::size_t j = i; j < i + batch && j < count; ++j) in.push_back(static_cast<std::int64_t>(j));
+            auto first = in.begin();
+            while ((first = queue.try_push(first, in.end())) != in.end()) std::this_thread::yield();
+        }
+        consumer.join();
+    });
+
+    std::cout << name << ", batches of " << batch << ": " << count / ms / 1000 << " Mitems/s (checksum " << sum << ")"
+              << std::endl;
+}
+
+template <typename Queue>
+void latency(const std::string& name, Queue& ping, Queue& pong, std::size_t rounds){
+    std::vector<double> samples;
+    samples.reserve(rounds);
+
+    std::thread echo([&](){
+        std::int64_t value;
+        for (std::size_t i = 0; i < rounds; ++i){
+            while (!ping.try_pop(value)) std::this_thread::yield();
+            while (!pong.try_push(value)) std::this_thread::yield();
+        }
+    });
+
+    std::int64_t value, sum = 0;
+    for (std::size_t i = 0; i < rounds; ++i){
+        auto start = Clock::now();
+        while (!ping.try_push(static_cast<std::int64_t>(i))) std::this_thread::yield();
+        while (!pong.try_pop(value)) std::this_thread::yield();
+        samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+        sum += value;
+    }
+    echo.join();
+
+    std::sort(samples.begin(), samples.end());
+    std::cout << name << " round trip: median " << samples[samples.size() / 2] << " ns, p99 "
+              << samples[samples.size() * 99 / 100] << " ns (checksum " << sum << ")" << std::endl;
+}
+
+int main(){
+    constexpr std::size_t count = 20000000;
+    constexpr std::size_t rounds = 200000;
+
+    for (std::size_t batch : {1, 64}){
+        MyStl::SpscRing<std::int64_t> ring(4096);
+        throughput("SpscRing", ring, count, batch);
+        Locked_Deque locked;
+        throughput("mutex + Deque", locked, count, batch);
+    }
+
+    MyStl::SpscRing<std::int64_t> ring_ping(1024), ring_pong(1024);
+    latency("SpscRing", ring_ping, ring_pong, rounds);
+    Locked_Deque locked_ping, locked_pong;
+    latency("mutex + Deque", locked_ping, locked_pong, rounds);
+
+    return 0;
+}
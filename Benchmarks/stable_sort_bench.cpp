@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "../Headers/Deque.h"
+#include "../Headers/Sort.h"
+#include "../Headers/Vector.h"
+
+// MyStl::stable_sort against std::stable_sort and MyStl::sort on inputs that are mostly in order already:
+// a sorted range with a few elements swapped, a sorted range with unsorted elements appended, and
+// separately sorted batches laid end to end. Random input is there as the case without any order to use
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+struct Event{
+    std::uint64_t time;
+    std::uint64_t id;
+};
+
+void run(const std::string& shape, const MyStl::Vector<Event>& input){
+    auto earlier = [](const Event& lhs, const Event& rhs){return lhs.time < rhs.time;};
+    std::size_t n = input.size();
+
+    MyStl::Vector<Event> v_std(input), v_stable(input), v_sort(input);
+    MyStl::Deque<Event> d_stable;
+    for (const Event& e : input) d_stable.push_back(e);
+
+    double t_std = time_ms([&](){std::stable_sort(v_std.data(), v_std.data() + n, earlier);});
+    double t_stable = time_ms([&](){MyStl::stable_sort(v_stable.begin(), v_stable.end(), earlier);});
+    double t_deque = time_ms([&](){MyStl::stable_sort(d_stable.begin(), d_stable.end(), earlier);});
+    double t_sort = time_ms([&](){MyStl::sort(v_sort.begin(), v_sort.end(), earlier);});
+
+    bool same = true;
+    for (std::size_t i = 0; i < n; ++i) same = same && v_std[i].id == v_stable[i].id && v_std[i].id == d_stable[i].id;
+    std::cout << shape << ", " << n << " elements, ms: std::stable_sort " << t_std << ", MyStl::stable_sort "
+              << t_stable << ", on a Deque " << t_deque << ", MyStl::sort (not stable) " << t_sort
+              << (same ? "" : " MISMATCH") << std::endl;
+}
+
+int main(){
+    const std::size_t n = 4000000;
+    std::mt19937_64 gen(42);
+    auto sorted = [&](std::size_t count){
+        MyStl::Vector<Event> v;
+        for (std::size_t i = 0; i < count; ++i) v.push_back(Event{gen() % (4 * n), i});
+        std::stable_sort(v.data(), v.data() + count, [](const Event& lhs, const Event& rhs){return lhs.time < rhs.time;});
+        for (std::size_t i = 0; i < count; ++i) v[i].id = i;
+        return v;
+    };
+
+    MyStl::Vector<Event> random;
+    for (std::size_t i = 0; i < n; ++i) random.push_back(Event{gen() % (4 * n), i});
+    run("random", random);
+
+    run("sorted", sorted(n));
+
+    MyStl::Vector<Event> swapped = sorted(n);
+    for (std::size_t i = 0; i < n / 100; ++i) std::swap(swapped[gen() % n], swapped[gen() % n]);
+    run("sorted, 1% swapped", swapped);
+
+    MyStl::Vector<Event> appended = sorted(n - n / 100);
+    for (std::size_t i = n - n / 100; i < n; ++i) appended.push_back(Event{gen() % (4 * n), i});
+    run("sorted, 1% appended", appended);
+
+    MyStl::Vector<Event> batches;
+    for (std::size_t b = 0; b < 64; ++b){
+        MyStl::Vector<Event> batch = sorted(n / 64);
+        for (Event& e : batch){
+            e.id = batches.size();
+            batches.push_back(e);
+        }
+    }
+    run("64 sorted batches", batches);
+
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <functional>
+#include <string>
+
+#include "../Headers/Vector.h"
+#include "../Headers/set.h"
+
+// building a set from a sorted snapshot: one insert at a time, appending with an end() hint, and the O(n) bulk build,
+// then copying the built set and destroying the copy
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(){
+    std::size_t sink = 0;
+
+    for (std::size_t n : {10000, 1000000, 10000000}){
+        MyStl::Vector<std::uint64_t> keys;
+        keys.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) keys.push_back(i * 7 + 3);
+
+        double single_ms = time_ms([&](){
+            MyStl::set<std::uint64_t> s;
+            for (auto k : keys) s.insert(k);
+            sink += s.size();
+        });
+
+        double hint_ms = time_ms([&](){
+            MyStl::set<std::uint64_t> s;
+            for (auto k : keys) s.insert(s.end(), k);
+            sink += s.size();
+        });
+
+        double bulk_ms = time_ms([&](){
+            MyStl::set<std::uint64_t> s(MyStl::sorted_unique, keys.begin(), keys.end());
+            sink += s.size();
+        });
+
+        MyStl::set<std::uint64_t> snapshot(keys.begin(), keys.end());
+        MyStl::set<std::uint64_t>* copy = nullptr;
+        double copy_ms = time_ms([&](){copy = new MyStl::set<std::uint64_t>(snapshot);});
+        double destroy_ms = time_ms([&](){delete copy;});
+
+        std::cout << n << " keys: insert " << single_ms << " ms, insert at end() " << hint_ms
+                  << " ms, sorted_unique build " << bulk_ms << " ms (" << single_ms / bulk_ms << "x), copy "
+                  << copy_ms << " ms, destroy " << destroy_ms << " ms" << std::endl;
+    }
+
+    std::cout << "(checksum " << sink << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "../Headers/List.h"
+#include "../Headers/UnrolledList.h"
+#include "../Headers/Vector.h"
+
+// iteration over 1e7 elements with a range for and with MyStl::for_each, and inserts in the middle of a
+// 1e5 element sequence through an iterator that is already there, for Vector, List and UnrolledList
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+template <typename Seq>
+void iterate(const std::string& name, std::size_t n, std::size_t rounds){
+    Seq seq;
+    for (std::size_t i = 0; i < n; ++i) seq.push_back(static_cast<std::int64_t>(i));
+
+    std::int64_t sum = 0;
+    double loop_ms = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r){
+            for (auto x : seq) sum += x;
+        }
+    });
+    double for_each_ms = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r){
+            MyStl::for_each(seq.begin(), seq.end(), [&sum](std::int64_t x){sum += x;});
+        }
+    });
+
+    std::cout << name << ", " << n << " elements: range for " << loop_ms / rounds << " ms, for_each "
+              << for_each_ms / rounds << " ms per pass (checksum " << sum << ")" << std::endl;
+}
+
+// walks the sequence once and inserts an element after every step-th one
+template <typename Seq>
+void insert_while_walking(const std::string& name, std::size_t n, std::size_t step){
+    Seq seq;
+    for (std::size_t i = 0; i < n; ++i) seq.push_back(static_cast<std::int64_t>(i));
+
+    std::size_t inserted = 0;
+    double ms = time_ms([&](){
+        std::size_t pos = 0;
+        for (auto it = seq.begin(); it != seq.end(); ++pos){
+            if (pos % step == 0){
+                it = seq.insert(it, -1);
+                ++inserted;
+                ++it;
+            }
+            ++it;
+        }
+    });
+
+    std::int64_t sum = 0;
+    for (auto x : seq) sum += x;
+    std::cout << name << ", " << n << " elements: " << inserted << " inserts while walking " << ms << " ms (checksum "
+              << sum << ")" << std::endl;
+}
+
+int main(){
+    iterate<MyStl::Vector<std::int64_t>>("Vector", 10000000, 10);
+    iterate<MyStl::UnrolledList<std::int64_t>>("UnrolledList", 10000000, 10);
+    iterate<MyStl::List<std::int64_t>>("List", 10000000, 10);
+
+    insert_while_walking<MyStl::Vector<std::int64_t>>("Vector", 100000, 10);
+    insert_while_walking<MyStl::UnrolledList<std::int64_t>>("UnrolledList", 100000, 10);
+    insert_while_walking<MyStl::List<std::int64_t>>("List", 100000, 10);
+
+    return 0;
+}
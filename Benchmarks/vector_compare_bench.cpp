@@ -0,0 +1,97 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "../Headers/Vector.h"
+
+// comparing and copying whole vectors of integers: Vector's == and < and MyStl::copy and fill go through
+// memcmp, memmove and memset, the element loops below are what they did before. The two vectors only
+// differ in their last element so every comparison reads both of them to the end
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+template <typename T>
+bool loop_equal(const MyStl::Vector<T>& a, const MyStl::Vector<T>& b){
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i){
+        if (a[i] != b[i]) return false;
+    }
+
+    return true;
+}
+
+template <typename T>
+bool loop_less(const MyStl::Vector<T>& a, const MyStl::Vector<T>& b){
+    std::size_t n = a.size() < b.size() ? a.size() : b.size();
+    for (std::size_t i = 0; i < n; ++i){
+        if (a[i] < b[i]) return true;
+        if (b[i] < a[i]) return false;
+    }
+
+    return a.size() < b.size();
+}
+
+template <typename T>
+void run(const std::string& name, std::size_t n, std::size_t rounds){
+    MyStl::Vector<T> a(n), b(n), out(n);
+    for (std::size_t i = 0; i < n; ++i) a[i] = b[i] = static_cast<T>(i * 7 + 3);
+    MyStl::Vector<T> same(a);
+    b[n - 1] = static_cast<T>(a[n - 1] + 1);
+    std::int64_t sum = 0;
+
+    double old_equal = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r) sum += loop_equal(a, same);
+    });
+    double new_equal = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r) sum += (a == same);
+    });
+    double old_less = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r) sum += loop_less(a, b);
+    });
+    double new_less = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r) sum += (a < b);
+    });
+    double old_copy = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r){
+            const T* in = a.data();
+            T* to = out.data();
+            for (std::size_t i = 0; i < n; ++i) to[i] = in[i];
+            sum += out[r % n];
+        }
+    });
+    double new_copy = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r){
+            MyStl::copy(a.data(), a.data() + n, out.data());
+            sum += out[r % n];
+        }
+    });
+    double new_fill = time_ms([&](){
+        for (std::size_t r = 0; r < rounds; ++r){
+            MyStl::fill(out.data(), out.data() + n, static_cast<T>(r));
+            sum += out[r % n];
+        }
+    });
+
+    double gb = static_cast<double>(n) * sizeof(T) * rounds / 1e6;
+    std::cout << name << ", " << n << " elements, GB/s: == " << gb / old_equal << " element loop vs "
+              << gb / new_equal << ", < " << gb / old_less << " vs " << gb / new_less << ", copy "
+              << gb / old_copy << " vs " << gb / new_copy << ", fill " << gb / new_fill
+              << " (checksum " << sum << ")" << std::endl;
+}
+
+int main(){
+    run<char>("char", 1 << 20, 1000);
+    run<unsigned char>("unsigned char", 1 << 20, 1000);
+    run<std::int32_t>("int32", 1 << 20, 300);
+    run<std::uint64_t>("uint64", 1 << 20, 200);
+
+    return 0;
+}
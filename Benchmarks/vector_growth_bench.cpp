@@ -0,0 +1,64 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "../Headers/Vector.h"
+
+// push_back throughput and memory overhead of each Vector growth policy
+
+using Clock = std::chrono::steady_clock;
+
+template <typename F>
+double time_ms(F f){
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+template <typename Growth>
+void run(const std::string& name){
+    using Vec = MyStl::Vector<std::uint64_t, std::allocator<std::uint64_t>, Growth>;
+    std::uint64_t sink = 0;
+
+    // one big vector, growth cost dominated by copying
+    const std::size_t big = 1 << 24, big_rounds = 5;
+    double big_ms = time_ms([&](){
+        for (std::size_t r = 0; r < big_rounds; ++r){
+            Vec v;
+            for (std::size_t i = 0; i < big; ++i) v.push_back(i);
+            sink += v.back();
+        }
+    });
+
+    // many small vectors with log-uniform sizes, growth cost dominated by allocation
+    const std::size_t num_small = 200000;
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> log_size(0.0, 10.0);
+    std::size_t elements = 0, capacity = 0;
+    double small_ms = time_ms([&](){
+        for (std::size_t r = 0; r < num_small; ++r){
+            Vec v;
+            std::size_t n = static_cast<std::size_t>(std::exp2(log_size(gen)));
+            for (std::size_t i = 0; i < n; ++i) v.push_back(i);
+            elements += v.size();
+            capacity += v.capacity();
+        }
+    });
+
+    std::cout << name << ": big push_back " << big * big_rounds / big_ms / 1000 << " Mops/s, small push_back "
+              << elements / small_ms / 1000 << " Mops/s, bytes per element "
+              << static_cast<double>(capacity * sizeof(std::uint64_t)) / elements 
+              << " (checksum " << sink << ")" << std::endl;
+}
+
+int main(){
+    run<MyStl::Double_Growth>("2x");
+    run<MyStl::One_And_Half_Growth>("1.5x");
+    run<MyStl::Golden_Growth>("golden ratio");
+    run<MyStl::Page_Growth<MyStl::One_And_Half_Growth>>("1.5x, page rounded");
+
+    return 0;
+}
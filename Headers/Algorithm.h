@@ -3,11 +3,68 @@
 
 #include <type_traits>
 #include <memory>
+#include <utility>
+#include <cassert>
+#include <cstring>
+#include <cstddef>
+
+#include "Iterator.h"
+
+// asks the CPU to start loading the cache line at address, a no-op where there is no way to say so
+#ifndef MYSTL_PREFETCH
+#if defined(__GNUC__)
+#define MYSTL_PREFETCH(address) __builtin_prefetch(address)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define MYSTL_PREFETCH(address) _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#else
+#define MYSTL_PREFETCH(address) ((void)0)
+#endif
+#endif
 
 namespace MyStl
 {
-template<typename InputIt1, typename InputIt2> 
-bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2){
+// tags promising that a range is sorted, with no equal keys for sorted_unique
+struct sorted_unique_t {explicit sorted_unique_t() = default;};
+struct sorted_equivalent_t {explicit sorted_equivalent_t() = default;};
+
+constexpr sorted_unique_t sorted_unique{};
+constexpr sorted_equivalent_t sorted_equivalent{};
+
+/* segmented iterators walk a sequence stored as a run of contiguous segments, e.g. the blocks of a Deque.
+   A container specializes this to derive from std::true_type and provide
+       segment_iterator, local_iterator     the latter a raw pointer into a segment
+       segment(it), local(it)               where it points
+       begin(seg), end(seg)                 the pointer range of a whole segment
+       compose(seg, local)                  the iterator again, local may be end(seg)
+   and copy, fill, equal and for_each then run a plain pointer loop over each segment instead of 
+   checking for the end of a segment on every step */
+template<typename Iter>
+struct Segmented_Iterator_Traits : std::false_type {};
+
+/* when the byte functions give the same result as the element loops */
+template<typename From, typename To>
+struct Is_Memcpy_Copyable : std::integral_constant<bool, std::is_pointer<From>::value && std::is_pointer<To>::value
+    && std::is_same<typename std::remove_const<typename std::remove_pointer<From>::type>::type, 
+                    typename std::remove_pointer<To>::type>::value
+    && std::is_trivially_copy_assignable<typename std::remove_pointer<To>::type>::value> {};
+
+// integers and pointers are equal exactly when their bytes are, unlike floats or padded structs
+template<typename It1, typename It2>
+struct Is_Memcmp_Comparable : std::integral_constant<bool, std::is_pointer<It1>::value && std::is_pointer<It2>::value
+    && std::is_same<typename std::remove_const<typename std::remove_pointer<It1>::type>::type, 
+                    typename std::remove_const<typename std::remove_pointer<It2>::type>::type>::value
+    && (std::is_integral<typename std::remove_pointer<It1>::type>::value 
+        || std::is_pointer<typename std::remove_pointer<It1>::type>::value)> {};
+
+template<typename It, typename T>
+struct Is_Memset_Fillable : std::integral_constant<bool, std::is_pointer<It>::value
+    && std::is_integral<typename std::remove_pointer<It>::type>::value
+    && !std::is_const<typename std::remove_pointer<It>::type>::value
+    && sizeof(typename std::remove_pointer<It>::type) == 1 && std::is_integral<T>::value> {};
+
+template<typename InputIt1, typename InputIt2>
+bool equal_step(InputIt1 first1, InputIt1 last1, InputIt2& first2, std::false_type){
     for (; first1 != last1; ++first1, ++first2){
         if (*first1 != *first2) return false;
     }
@@ -15,6 +72,80 @@ bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2){
     return true;
 }
 
+template<typename InputIt1, typename InputIt2>
+bool equal_step(InputIt1 first1, InputIt1 last1, InputIt2& first2, std::true_type){
+    auto n = last1 - first1;
+    if (n > 0 && std::memcmp(first1, first2, n * sizeof(*first1)) != 0) return false;
+
+    first2 += n;
+    return true;
+}
+
+template<typename InputIt1, typename InputIt2>
+bool equal_into_segments(InputIt1 first1, InputIt1 last1, InputIt2& first2, std::false_type){
+    return equal_step(first1, last1, first2, std::false_type());
+}
+
+template<typename InputIt1, typename InputIt2>
+bool equal_into_segments(InputIt1 first1, InputIt1 last1, InputIt2& first2, std::true_type){
+    using Traits = Segmented_Iterator_Traits<InputIt2>;
+    using Local = typename Traits::local_iterator;
+
+    auto seg = Traits::segment(first2);
+    Local local = Traits::local(first2);
+    while (true){
+        auto n = last1 - first1;
+        auto room = Traits::end(seg) - local;
+        if (n <= room){
+            if (!equal_step(first1, last1, local, Is_Memcmp_Comparable<InputIt1, Local>())) return false;
+            first2 = Traits::compose(seg, local);
+            return true;
+        }
+
+        if (!equal_step(first1, first1 + room, local, Is_Memcmp_Comparable<InputIt1, Local>())) return false;
+        first1 += room;
+        local = Traits::begin(++seg);
+    }
+}
+
+template<typename InputIt1, typename InputIt2>
+bool equal_second(InputIt1 first1, InputIt1 last1, InputIt2& first2, std::false_type){
+    return equal_step(first1, last1, first2, Is_Memcmp_Comparable<InputIt1, InputIt2>());
+}
+
+// the second range is cut where its segments end, which needs to know how much of the first is left
+template<typename InputIt1, typename InputIt2>
+bool equal_second(InputIt1 first1, InputIt1 last1, InputIt2& first2, std::true_type){
+    return equal_into_segments(first1, last1, first2, Is_Random_Access_Iterator<InputIt1>());
+}
+
+template<typename InputIt1, typename InputIt2>
+bool equal_first(InputIt1 first1, InputIt1 last1, InputIt2& first2, std::false_type){
+    return equal_second(first1, last1, first2, Segmented_Iterator_Traits<InputIt2>());
+}
+
+template<typename InputIt1, typename InputIt2>
+bool equal_first(InputIt1 first1, InputIt1 last1, InputIt2& first2, std::true_type){
+    using Traits = Segmented_Iterator_Traits<InputIt1>;
+
+    auto seg_first = Traits::segment(first1), seg_last = Traits::segment(last1);
+    if (seg_first == seg_last){
+        return equal_second(Traits::local(first1), Traits::local(last1), first2, Segmented_Iterator_Traits<InputIt2>());
+    }
+
+    if (!equal_second(Traits::local(first1), Traits::end(seg_first), first2, Segmented_Iterator_Traits<InputIt2>())) return false;
+    for (++seg_first; seg_first != seg_last; ++seg_first){
+        if (!equal_second(Traits::begin(seg_first), Traits::end(seg_first), first2, Segmented_Iterator_Traits<InputIt2>())) return false;
+    }
+
+    return equal_second(Traits::begin(seg_last), Traits::local(last1), first2, Segmented_Iterator_Traits<InputIt2>());
+}
+
+template<typename InputIt1, typename InputIt2> 
+bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2){
+    return equal_first(first1, last1, first2, Segmented_Iterator_Traits<InputIt1>());
+}
+
 template<typename InputIt1, typename InputIt2, typename F> 
 bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2, F& pred){
     for (; first1 != last1; ++first1, ++first2){
@@ -61,13 +192,111 @@ void destroy(T* p){
     destroy_unchecked(p, std::is_trivially_destructible<T>{});
 }
 
+/* types whose objects can be moved to another address by copying their bytes and 
+   forgetting about the source, specialize it for types that qualify without being 
+   trivially copyable, e.g. unique_ptr like handles */
+template<typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+/* whether constructing and destroying through Alloc is plain placement new and dtor call */
+template<typename Alloc, typename T>
+struct Is_Default_Construct_Alloc
+{
+    private:
+        template <typename A> static std::true_type check_construct(...);
+        template <typename A> static std::false_type 
+        check_construct(decltype(std::declval<A&>().construct(std::declval<T*>(), std::declval<T&&>()))*);
+
+        template <typename A> static std::true_type check_destroy(...);
+        template <typename A> static std::false_type 
+        check_destroy(decltype(std::declval<A&>().destroy(std::declval<T*>()))*);
+    public:
+        constexpr static const bool value = decltype(check_construct<Alloc>(nullptr))::value 
+                                         && decltype(check_destroy<Alloc>(nullptr))::value;
+};
+
+template<typename T>
+struct Is_Default_Construct_Alloc<std::allocator<T>, T> : std::true_type {};
+
+// when a container may memcpy its elements to new storage, which bypasses Alloc's construct and destroy
+template<typename Alloc, typename T>
+struct Is_Bitwise_Relocatable : std::integral_constant<bool,
+    is_trivially_relocatable<T>::value && Is_Default_Construct_Alloc<Alloc, T>::value> {};
+
+/* allocator propagation, release is called to give back everything obtained 
+   from lhs before it gets replaced by an allocator that compares unequal */
+template<typename Alloc, typename F>
+void alloc_on_copy_unchecked(Alloc& lhs, const Alloc& rhs, F release, std::true_type){
+    if (lhs != rhs) release();
+    lhs = rhs;
+}
+
+template<typename Alloc, typename F>
+void alloc_on_copy_unchecked(Alloc&, const Alloc&, F, std::false_type){}
+
+template<typename Alloc, typename F>
+void alloc_on_copy(Alloc& lhs, const Alloc& rhs, F release){
+    alloc_on_copy_unchecked(lhs, rhs, release, 
+        typename std::allocator_traits<Alloc>::propagate_on_container_copy_assignment());
+}
+
+template<typename Alloc>
+void alloc_on_swap_unchecked(Alloc& lhs, Alloc& rhs, std::true_type){
+    std::swap(lhs, rhs);
+}
+
+template<typename Alloc>
+void alloc_on_swap_unchecked(Alloc& lhs, Alloc& rhs, std::false_type){
+    assert(lhs == rhs && "swapping containers with unequal allocators that don't propagate");
+    (void)lhs, (void)rhs;
+}
+
+template<typename Alloc>
+void alloc_on_swap(Alloc& lhs, Alloc& rhs){
+    alloc_on_swap_unchecked(lhs, rhs, typename std::allocator_traits<Alloc>::propagate_on_container_swap());
+}
+
 template<typename ForwardIt, typename T>
-void fill(ForwardIt first, ForwardIt last, const T& value){
+void fill_contiguous(ForwardIt first, ForwardIt last, const T& value, std::false_type){
     for (; first != last; ++first) {*first = value;}
 }
 
+template<typename ForwardIt, typename T>
+void fill_contiguous(ForwardIt first, ForwardIt last, const T& value, std::true_type){
+    using U = typename std::remove_pointer<ForwardIt>::type;
+    if (first != last) std::memset(first, static_cast<unsigned char>(static_cast<U>(value)), last - first);
+}
+
+template<typename ForwardIt, typename T>
+void fill_segmented(ForwardIt first, ForwardIt last, const T& value, std::false_type){
+    fill_contiguous(first, last, value, Is_Memset_Fillable<ForwardIt, T>());
+}
+
+template<typename ForwardIt, typename T>
+void fill_segmented(ForwardIt first, ForwardIt last, const T& value, std::true_type){
+    using Traits = Segmented_Iterator_Traits<ForwardIt>;
+    using Local = typename Traits::local_iterator;
+
+    auto seg_first = Traits::segment(first), seg_last = Traits::segment(last);
+    if (seg_first == seg_last){
+        fill_contiguous(Traits::local(first), Traits::local(last), value, Is_Memset_Fillable<Local, T>());
+        return;
+    }
+
+    fill_contiguous(Traits::local(first), Traits::end(seg_first), value, Is_Memset_Fillable<Local, T>());
+    for (++seg_first; seg_first != seg_last; ++seg_first){
+        fill_contiguous(Traits::begin(seg_first), Traits::end(seg_first), value, Is_Memset_Fillable<Local, T>());
+    }
+    fill_contiguous(Traits::begin(seg_last), Traits::local(last), value, Is_Memset_Fillable<Local, T>());
+}
+
+template<typename ForwardIt, typename T>
+void fill(ForwardIt first, ForwardIt last, const T& value){
+    fill_segmented(first, last, value, Segmented_Iterator_Traits<ForwardIt>());
+}
+
 template<class InputIt, class OutputIt>
-OutputIt copy(InputIt first, InputIt last, OutputIt d_first){
+OutputIt copy_contiguous(InputIt first, InputIt last, OutputIt d_first, std::false_type){
     while(first != last){
         *(d_first++) = *(first++);
     }
@@ -75,6 +304,76 @@ OutputIt copy(InputIt first, InputIt last, OutputIt d_first){
     return d_first;
 }
 
+// memmove since the ranges may overlap, as long as d_first is not inside [first, last)
+template<class InputIt, class OutputIt>
+OutputIt copy_contiguous(InputIt first, InputIt last, OutputIt d_first, std::true_type){
+    auto n = last - first;
+    if (n > 0) std::memmove(d_first, first, n * sizeof(*first));
+
+    return d_first + n;
+}
+
+template<class InputIt, class OutputIt>
+OutputIt copy_into_segments(InputIt first, InputIt last, OutputIt d_first, std::false_type){
+    return copy_contiguous(first, last, d_first, std::false_type());
+}
+
+template<class InputIt, class OutputIt>
+OutputIt copy_into_segments(InputIt first, InputIt last, OutputIt d_first, std::true_type){
+    using Traits = Segmented_Iterator_Traits<OutputIt>;
+    using Local = typename Traits::local_iterator;
+
+    auto seg = Traits::segment(d_first);
+    Local local = Traits::local(d_first);
+    while (true){
+        auto n = last - first;
+        auto room = Traits::end(seg) - local;
+        if (n <= room) return Traits::compose(seg, copy_contiguous(first, last, local, Is_Memcpy_Copyable<InputIt, Local>()));
+
+        copy_contiguous(first, first + room, local, Is_Memcpy_Copyable<InputIt, Local>());
+        first += room;
+        local = Traits::begin(++seg);
+    }
+}
+
+template<class InputIt, class OutputIt>
+OutputIt copy_segmented_out(InputIt first, InputIt last, OutputIt d_first, std::false_type){
+    return copy_contiguous(first, last, d_first, Is_Memcpy_Copyable<InputIt, OutputIt>());
+}
+
+// the output is cut where its segments end, which needs to know how much input is left
+template<class InputIt, class OutputIt>
+OutputIt copy_segmented_out(InputIt first, InputIt last, OutputIt d_first, std::true_type){
+    return copy_into_segments(first, last, d_first, Is_Random_Access_Iterator<InputIt>());
+}
+
+template<class InputIt, class OutputIt>
+OutputIt copy_segmented_in(InputIt first, InputIt last, OutputIt d_first, std::false_type){
+    return copy_segmented_out(first, last, d_first, Segmented_Iterator_Traits<OutputIt>());
+}
+
+template<class InputIt, class OutputIt>
+OutputIt copy_segmented_in(InputIt first, InputIt last, OutputIt d_first, std::true_type){
+    using Traits = Segmented_Iterator_Traits<InputIt>;
+
+    auto seg_first = Traits::segment(first), seg_last = Traits::segment(last);
+    if (seg_first == seg_last){
+        return copy_segmented_out(Traits::local(first), Traits::local(last), d_first, Segmented_Iterator_Traits<OutputIt>());
+    }
+
+    d_first = copy_segmented_out(Traits::local(first), Traits::end(seg_first), d_first, Segmented_Iterator_Traits<OutputIt>());
+    for (++seg_first; seg_first != seg_last; ++seg_first){
+        d_first = copy_segmented_out(Traits::begin(seg_first), Traits::end(seg_first), d_first, Segmented_Iterator_Traits<OutputIt>());
+    }
+
+    return copy_segmented_out(Traits::begin(seg_last), Traits::local(last), d_first, Segmented_Iterator_Traits<OutputIt>());
+}
+
+template<class InputIt, class OutputIt>
+OutputIt copy(InputIt first, InputIt last, OutputIt d_first){
+    return copy_segmented_in(first, last, d_first, Segmented_Iterator_Traits<InputIt>());
+}
+
 template<typename ForwardIt, typename T>
 void uninitialized_fill_unchecked(ForwardIt first, ForwardIt last, const T& value, std::true_type){
     fill(first, last, value);
@@ -124,6 +423,32 @@ ForwardIt uninitialized_copy(InputIt first, InputIt last, ForwardIt d_first){
     return uninitialized_copy_unchecked(first, last, d_first, std::is_trivially_copy_assignable<typename Iterator_Traits<InputIt>::value_type>{});
 }
 
+template<typename ForwardIt1, typename ForwardIt2>
+void iter_swap(ForwardIt1 a, ForwardIt2 b){
+    using std::swap;
+    swap(*a, *b);
+}
+
+template<typename BidirIt>
+void reverse(BidirIt first, BidirIt last){
+    while (first != last && first != --last){
+        MyStl::iter_swap(first, last);
+        ++first;
+    }
+}
+
+// returns where *first ended up
+template<typename RandomIt>
+RandomIt rotate(RandomIt first, RandomIt middle, RandomIt last){
+    if (first == middle) return last;
+    if (middle == last) return first;
+
+    MyStl::reverse(first, middle);
+    MyStl::reverse(middle, last);
+    MyStl::reverse(first, last);
+    return first + (last - middle);
+}
+
 template<class BidirIt1, class BidirIt2>
 BidirIt2 copy_backward(BidirIt1 first, BidirIt1 last, BidirIt2 d_last){ //returns the last element copied (the one originally pointed to by first)
     while (last != first){
@@ -133,8 +458,13 @@ BidirIt2 copy_backward(BidirIt1 first, BidirIt1 last, BidirIt2 d_last){ //return
     return d_last;
 }
 
+// how many bytes lexicographical_compare hands to memcmp at a time before looking for the element that differs
+#ifndef MYSTL_COMPARE_BLOCK_BYTES
+#define MYSTL_COMPARE_BLOCK_BYTES 256
+#endif
+
 template <typename InputIt1, typename InputIt2>
-bool lexicographical_compare(InputIt1 first_1, InputIt1 last_1, InputIt2 first_2, InputIt2 last_2){
+bool lexicographical_compare_step(InputIt1 first_1, InputIt1 last_1, InputIt2 first_2, InputIt2 last_2, std::false_type){
     while  (first_1 != last_1 && first_2 != last_2){
         if (*first_1 < *first_2) return true;
         else if (*first_2 < *first_1) return false;
@@ -145,6 +475,35 @@ bool lexicographical_compare(InputIt1 first_1, InputIt1 last_1, InputIt2 first_2
     return (first_1 == last_1 && first_2 != last_2);
 }
 
+/* memcmp orders by unsigned bytes, which is the element order only for unsigned single bytes. For
+   anything else it just skips the equal prefix a block at a time, and the first differing block is
+   then searched element by element. memcmp itself is picked by the C library for the CPU it runs on */
+template <typename InputIt1, typename InputIt2>
+bool lexicographical_compare_step(InputIt1 first_1, InputIt1 last_1, InputIt2 first_2, InputIt2 last_2, std::true_type){
+    using T = typename std::remove_const<typename std::remove_pointer<InputIt1>::type>::type;
+    auto n_1 = last_1 - first_1, n_2 = last_2 - first_2;
+    auto n = n_1 < n_2 ? n_1 : n_2;
+
+    if (sizeof(T) == 1 && std::is_unsigned<T>::value){
+        int diff = n > 0 ? std::memcmp(first_1, first_2, n) : 0;
+        return diff != 0 ? diff < 0 : n_1 < n_2;
+    }
+
+    const decltype(n) block = MYSTL_COMPARE_BLOCK_BYTES / sizeof(T) > 0 ? MYSTL_COMPARE_BLOCK_BYTES / sizeof(T) : 1;
+    decltype(n) i = 0;
+    while (n - i >= block && std::memcmp(first_1 + i, first_2 + i, block * sizeof(T)) == 0) i += block;
+    for (; i < n; ++i){
+        if (first_1[i] != first_2[i]) return first_1[i] < first_2[i];
+    }
+
+    return n_1 < n_2;
+}
+
+template <typename InputIt1, typename InputIt2>
+bool lexicographical_compare(InputIt1 first_1, InputIt1 last_1, InputIt2 first_2, InputIt2 last_2){
+    return lexicographical_compare_step(first_1, last_1, first_2, last_2, Is_Memcmp_Comparable<InputIt1, InputIt2>());
+}
+
 template <typename InputIt1, typename InputIt2, typename F>
 bool lexicographical_compare(InputIt1 first_1, InputIt1 last_1, InputIt2 first_2, InputIt2 last_2, F pred){
     while  (first_1 != last_1 && first_2 != last_2){
@@ -158,11 +517,37 @@ bool lexicographical_compare(InputIt1 first_1, InputIt1 last_1, InputIt2 first_2
 }
 
 template<typename InputIt, typename F>
-F for_each(InputIt first, InputIt last, F func){
+void for_each_contiguous(InputIt first, InputIt last, F& func){
     for (; first != last; ++first){
         func(*first);
     }
+}
+
+template<typename InputIt, typename F>
+void for_each_segmented(InputIt first, InputIt last, F& func, std::false_type){
+    for_each_contiguous(first, last, func);
+}
+
+template<typename InputIt, typename F>
+void for_each_segmented(InputIt first, InputIt last, F& func, std::true_type){
+    using Traits = Segmented_Iterator_Traits<InputIt>;
 
+    auto seg_first = Traits::segment(first), seg_last = Traits::segment(last);
+    if (seg_first == seg_last){
+        for_each_contiguous(Traits::local(first), Traits::local(last), func);
+        return;
+    }
+
+    for_each_contiguous(Traits::local(first), Traits::end(seg_first), func);
+    for (++seg_first; seg_first != seg_last; ++seg_first){
+        for_each_contiguous(Traits::begin(seg_first), Traits::end(seg_first), func);
+    }
+    for_each_contiguous(Traits::begin(seg_last), Traits::local(last), func);
+}
+
+template<typename InputIt, typename F>
+F for_each(InputIt first, InputIt last, F func){
+    for_each_segmented(first, last, func, Segmented_Iterator_Traits<InputIt>());
     return func;
 }
 
@@ -176,6 +561,256 @@ OutputIt copy_if(InputIt first, InputIt last, OutputIt d_first, F pred){
     }
     return d_first;
 }
+
+/* binary searches, [first, last) must be partitioned with respect to value */
+template<typename ForwardIt, typename T, typename Compare>
+ForwardIt lower_bound(ForwardIt first, ForwardIt last, const T& value, Compare comp){
+    auto count = MyStl::distance(first, last);
+    while (count > 0){
+        auto half = count / 2;
+        auto mid = first;
+        MyStl::advance(mid, half);
+        if (comp(*mid, value)){
+            first = ++mid;
+            count -= half + 1;
+        }else count = half;
+    }
+
+    return first;
+}
+
+template<typename ForwardIt, typename T>
+ForwardIt lower_bound(ForwardIt first, ForwardIt last, const T& value){
+    return MyStl::lower_bound(first, last, value, [](const auto& lhs, const T& rhs){return lhs < rhs;});
+}
+
+template<typename ForwardIt, typename T, typename Compare>
+ForwardIt upper_bound(ForwardIt first, ForwardIt last, const T& value, Compare comp){
+    auto count = MyStl::distance(first, last);
+    while (count > 0){
+        auto half = count / 2;
+        auto mid = first;
+        MyStl::advance(mid, half);
+        if (!comp(value, *mid)){
+            first = ++mid;
+            count -= half + 1;
+        }else count = half;
+    }
+
+    return first;
+}
+
+template<typename ForwardIt, typename T>
+ForwardIt upper_bound(ForwardIt first, ForwardIt last, const T& value){
+    return MyStl::upper_bound(first, last, value, [](const T& lhs, const auto& rhs){return lhs < rhs;});
+}
+
+/* same results as lower_bound and upper_bound, but the loop only ever moves base by a 
+   select instead of a branch, so there is nothing for the predictor to get wrong and the 
+   trip count depends on the length alone. Worth it when comparing is cheap, e.g. integers */
+template<typename RandomIt, typename T, typename Compare>
+RandomIt branchless_lower_bound(RandomIt first, RandomIt last, const T& value, Compare comp){
+    auto n = last - first;
+    if (n == 0) return first;
+
+    while (n > 1){
+        auto half = n / 2;
+        first = comp(first[half], value) ? first + half : first;
+        n -= half;
+    }
+
+    return first + comp(*first, value);
+}
+
+template<typename RandomIt, typename T, typename Compare>
+RandomIt branchless_upper_bound(RandomIt first, RandomIt last, const T& value, Compare comp){
+    auto n = last - first;
+    if (n == 0) return first;
+
+    while (n > 1){
+        auto half = n / 2;
+        first = comp(value, first[half]) ? first : first + half;
+        n -= half;
+    }
+
+    return first + !comp(value, *first);
+}
+
+/* heaps: [first, first + len) is a max heap by comp where the children of i are at Arity * i + 1 up to
+   Arity * i + Arity. The std style functions below are the binary ones. A 4-ary heap is half as deep and
+   the 4 children of a node are next to each other, so sifting down touches half as many cache lines
+   for a few more comparisons per level, which pays off once the heap outgrows the cache */
+
+// picks the winner with selects, prefetching the level or two below all the children to hide the misses
+template<std::size_t Arity, typename RandomIt, typename Compare>
+std::ptrdiff_t heap_greatest_child(RandomIt first, std::ptrdiff_t child, std::ptrdiff_t len, Compare& comp){
+    std::ptrdiff_t greatest = child;
+    if (len - child >= static_cast<std::ptrdiff_t>(Arity)){
+        using T = typename Iterator_Traits<RandomIt>::value_type;
+        const std::ptrdiff_t per_line = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+        std::ptrdiff_t below = child, count = Arity;
+        do{
+            below = Arity * below + 1;
+            count *= Arity;
+            for (std::ptrdiff_t i = below; i < below + count && i < len; i += per_line) MYSTL_PREFETCH(&*(first + i));
+        }while (count < 8);
+
+        for (std::size_t i = 1; i < Arity; ++i){
+            greatest = comp(*(first + greatest), *(first + (child + i))) ? child + i : greatest;
+        }
+        return greatest;
+    }
+
+    for (++child; child < len; ++child){
+        if (comp(*(first + greatest), *(first + child))) greatest = child;
+    }
+    return greatest;
+}
+
+// fills the hole with value, moving it down past greater children
+template<std::size_t Arity, typename RandomIt, typename T, typename Compare>
+void heap_sift_down(RandomIt first, std::ptrdiff_t hole, std::ptrdiff_t len, T value, Compare& comp){
+    for (std::ptrdiff_t child = Arity * hole + 1; child < len; child = Arity * hole + 1){
+        child = heap_greatest_child<Arity>(first, child, len, comp);
+        if (!comp(value, *(first + child))) break;
+
+        *(first + hole) = std::move(*(first + child));
+        hole = child;
+    }
+    *(first + hole) = std::move(value);
+}
+
+// fills the hole with value, moving it up past smaller parents
+template<std::size_t Arity, typename RandomIt, typename T, typename Compare>
+void heap_sift_up(RandomIt first, std::ptrdiff_t hole, T value, Compare& comp){
+    while (hole > 0){
+        std::ptrdiff_t parent = (hole - 1) / static_cast<std::ptrdiff_t>(Arity);
+        if (!comp(*(first + parent), value)) break;
+
+        *(first + hole) = std::move(*(first + parent));
+        hole = parent;
+    }
+    *(first + hole) = std::move(value);
+}
+
+// Floyd's heap construction, sifting down every parent from the last one up, O(len)
+template<std::size_t Arity, typename RandomIt, typename Compare>
+void heap_make(RandomIt first, std::ptrdiff_t len, Compare& comp){
+    using T = typename Iterator_Traits<RandomIt>::value_type;
+    if (len < 2) return;
+
+    for (std::ptrdiff_t parent = (len - 2) / static_cast<std::ptrdiff_t>(Arity) + 1; parent > 0; --parent){
+        T value = std::move(*(first + (parent - 1)));
+        heap_sift_down<Arity>(first, parent - 1, len, std::move(value), comp);
+    }
+}
+
+template<std::size_t Arity, typename RandomIt, typename Compare>
+void heap_push(RandomIt first, std::ptrdiff_t len, Compare& comp){
+    using T = typename Iterator_Traits<RandomIt>::value_type;
+    if (len < 2) return;
+
+    T value = std::move(*(first + (len - 1)));
+    heap_sift_up<Arity>(first, len - 1, std::move(value), comp);
+}
+
+/* moves the top to first + len - 1. The value from the back that takes its place is about as small as
+   any in the heap, so rather than comparing it on the way down, the hole goes all the way to a leaf
+   along the greatest children and the value is sifted up from there, which is rarely far */
+template<std::size_t Arity, typename RandomIt, typename Compare>
+void heap_pop(RandomIt first, std::ptrdiff_t len, Compare& comp){
+    using T = typename Iterator_Traits<RandomIt>::value_type;
+    if (len < 2) return;
+
+    T value = std::move(*(first + (len - 1)));
+    *(first + (len - 1)) = std::move(*first);
+
+    std::ptrdiff_t hole = 0;
+    --len;
+    for (std::ptrdiff_t child = 1; child < len; child = Arity * hole + 1){
+        child = heap_greatest_child<Arity>(first, child, len, comp);
+        *(first + hole) = std::move(*(first + child));
+        hole = child;
+    }
+    heap_sift_up<Arity>(first, hole, std::move(value), comp);
+}
+
+// pops the top to the back over and over, leaving the range sorted
+template<std::size_t Arity, typename RandomIt, typename Compare>
+void heap_sort(RandomIt first, std::ptrdiff_t len, Compare& comp){
+    for (; len > 1; --len) heap_pop<Arity>(first, len, comp);
+}
+
+template<std::size_t Arity, typename RandomIt, typename Compare>
+std::ptrdiff_t heap_until(RandomIt first, std::ptrdiff_t len, Compare& comp){
+    for (std::ptrdiff_t child = 1; child < len; ++child){
+        if (comp(*(first + (child - 1) / static_cast<std::ptrdiff_t>(Arity)), *(first + child))) return child;
+    }
+
+    return len;
+}
+
+// *(last - 1) joins the heap [first, last - 1)
+template<typename RandomIt, typename Compare>
+void push_heap(RandomIt first, RandomIt last, Compare comp){
+    heap_push<2>(first, last - first, comp);
+}
+
+template<typename RandomIt>
+void push_heap(RandomIt first, RandomIt last){
+    MyStl::push_heap(first, last, [](const auto& lhs, const auto& rhs){return lhs < rhs;});
+}
+
+// swaps the top to last - 1 and makes [first, last - 1) a heap again
+template<typename RandomIt, typename Compare>
+void pop_heap(RandomIt first, RandomIt last, Compare comp){
+    heap_pop<2>(first, last - first, comp);
+}
+
+template<typename RandomIt>
+void pop_heap(RandomIt first, RandomIt last){
+    MyStl::pop_heap(first, last, [](const auto& lhs, const auto& rhs){return lhs < rhs;});
+}
+
+template<typename RandomIt, typename Compare>
+void make_heap(RandomIt first, RandomIt last, Compare comp){
+    heap_make<2>(first, last - first, comp);
+}
+
+template<typename RandomIt>
+void make_heap(RandomIt first, RandomIt last){
+    MyStl::make_heap(first, last, [](const auto& lhs, const auto& rhs){return lhs < rhs;});
+}
+
+template<typename RandomIt, typename Compare>
+void sort_heap(RandomIt first, RandomIt last, Compare comp){
+    heap_sort<2>(first, last - first, comp);
+}
+
+template<typename RandomIt>
+void sort_heap(RandomIt first, RandomIt last){
+    MyStl::sort_heap(first, last, [](const auto& lhs, const auto& rhs){return lhs < rhs;});
+}
+
+template<typename RandomIt, typename Compare>
+RandomIt is_heap_until(RandomIt first, RandomIt last, Compare comp){
+    return first + heap_until<2>(first, last - first, comp);
+}
+
+template<typename RandomIt>
+RandomIt is_heap_until(RandomIt first, RandomIt last){
+    return MyStl::is_heap_until(first, last, [](const auto& lhs, const auto& rhs){return lhs < rhs;});
+}
+
+template<typename RandomIt, typename Compare>
+bool is_heap(RandomIt first, RandomIt last, Compare comp){
+    return MyStl::is_heap_until(first, last, comp) == last;
+}
+
+template<typename RandomIt>
+bool is_heap(RandomIt first, RandomIt last){
+    return MyStl::is_heap_until(first, last) == last;
+}
 } // namespace MyStl
 
 
@@ -122,7 +122,7 @@ namespace MyStl{
 
     template<class T, std::size_t N>
     bool operator<(const MyStl::Array<T,N>& lhs, const MyStl::Array<T,N>& rhs){
-        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        return MyStl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
     }
 
     template<class T, std::size_t N>
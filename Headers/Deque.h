@@ -4,19 +4,39 @@
 #include <memory>
 #include <assert.h>
 #include <stdexcept>
+#include <algorithm>
 
 #include "Iterator.h"
 #include "Algorithm.h"
 
 #define DEQUE_INITIAL_MINIMUN_MAP_SIZE 8
 
+// blocks freed at one end are kept for the other end up to this many, 0 frees them right away
+#ifndef DEQUE_MAX_SPARE_BLOCKS
+#define DEQUE_MAX_SPARE_BLOCKS 4
+#endif
+
 namespace MyStl
 {
-    template <typename T> class Deque;
+    // elements per block when a block takes about BlockBytes, at least one
+    template <typename T, std::size_t BlockBytes>
+    struct Deque_Block_Size : std::integral_constant<std::size_t, sizeof(T) < BlockBytes ? BlockBytes / sizeof(T) : 1> {};
+
+    // how often a deque had to make room in its map, see Deque::map_resize
+    struct Deque_Map_Stats{
+        std::size_t recenters = 0;       // used slots moved back to the middle of the same map
+        std::size_t reallocations = 0;   // used slots moved to a bigger map
+    };
 
-    template<typename T, typename Reference, typename Pointer>
+    /* BlockBytes sets the size of the blocks holding the elements, larger blocks mean fewer
+       allocations and map slots, e.g. 4096 for page sized blocks */
+    template <typename T, typename Alloc = std::allocator<T>, std::size_t BlockBytes = 512> class Deque;
+
+    template<typename T, typename Reference, typename Pointer, std::size_t BlockSize>
     class Deque_Iterator: public Iterator<Random_Access_Iterator_Tag, T, ptrdiff_t, Pointer, Reference>{
-        friend class Deque<T>;
+        template <typename, typename, std::size_t> friend class Deque;
+        template <typename, typename, typename, std::size_t> friend class Deque_Iterator;
+        template <typename> friend struct Segmented_Iterator_Traits;
         
         public:
             using map_ptr = T**;
@@ -26,7 +46,7 @@ namespace MyStl
             using reference = Reference;
             using pointer = Pointer;
             using difference_type = ptrdiff_t;
-            static constexpr size_type block_size = sizeof(T) < 512 ? 512/sizeof(T) : 1;
+            static constexpr size_type block_size = BlockSize;
 
         private:
             map_ptr map_node;
@@ -50,6 +70,12 @@ namespace MyStl
             Deque_Iterator(map_ptr map, value_ptr p_val): map_node(map), cur(p_val), 
                 first(*map), last(*map + block_size){}
 
+            // iterator to const_iterator
+            template <typename R, typename P,
+                      typename std::enable_if<std::is_convertible<P, Pointer>::value, bool>::type = true>
+            Deque_Iterator(const Deque_Iterator<T, R, P, BlockSize>& other): map_node(other.map_node), 
+                cur(other.cur), first(other.first), last(other.last){}
+
             //TODO: Deque_Iterator(size_type off, deque* p_deque)
 
         public:
@@ -65,11 +91,11 @@ namespace MyStl
                 return *this;
             }
 
-            reference operator*(){
+            reference operator*() const {
                 return *cur;
             }
 
-            pointer operator->(){
+            pointer operator->() const {
                 return cur;
             }
 
@@ -115,10 +141,10 @@ namespace MyStl
                         cur = first + (distance_from_first - node_diff * block_size);
                     }
                 }else{      //move backward
-                    const difference_type node_diff = distance_from_first 
-                                        / static_cast<difference_type>(block_size) - 1;
+                    const difference_type node_diff = -((-distance_from_first - 1) 
+                                        / static_cast<difference_type>(block_size)) - 1;
                     change_node_by(node_diff);
-                    cur = last + (distance_from_first - node_diff 
+                    cur = first + (distance_from_first - node_diff 
                                         * static_cast<difference_type>(block_size));
                 }
 
@@ -129,12 +155,12 @@ namespace MyStl
                 return operator+=(-n);
             }
 
-            Deque_Iterator& operator+(difference_type n) const {
+            Deque_Iterator operator+(difference_type n) const {
                 Deque_Iterator temp = *this;
                 return temp.operator+=(n);
             }
 
-            Deque_Iterator& operator-(difference_type n) const {
+            Deque_Iterator operator-(difference_type n) const {
                 Deque_Iterator temp = *this;
                 return temp.operator+=(-n);
             }
@@ -173,32 +199,59 @@ namespace MyStl
             }
     };
 
-    template <typename T>
+    // every block is a segment, so copy, fill, equal and for_each run over raw pointer ranges
+    template <typename T, typename Reference, typename Pointer, std::size_t BlockSize>
+    struct Segmented_Iterator_Traits<Deque_Iterator<T, Reference, Pointer, BlockSize>> : std::true_type {
+        using iterator = Deque_Iterator<T, Reference, Pointer, BlockSize>;
+        using segment_iterator = T**;
+        using local_iterator = Pointer;
+
+        static segment_iterator segment(const iterator& it) {return it.map_node;}
+
+        static local_iterator local(const iterator& it) {return it.cur;}
+
+        static local_iterator begin(segment_iterator seg) {return *seg;}
+
+        static local_iterator end(segment_iterator seg) {return *seg + BlockSize;}
+
+        // the end of a block is the start of the next one, which exists as long as it is not past the deque's end
+        static iterator compose(segment_iterator seg, local_iterator local) {
+            if (local == end(seg)) return iterator(seg + 1, *(seg + 1));
+            return iterator(seg, const_cast<T*>(local));
+        }
+    };
+
+    template <typename T, typename Alloc, std::size_t BlockBytes>
     class Deque{
         public:
             using value_type = T;
-            using allocator_type = std::allocator<T>;
+            using allocator_type = Alloc;
             using size_type = std::size_t;
             using difference_type = std::ptrdiff_t;
             using reference = value_type&;
             using const_reference = const value_type&;
-            using pointer = typename allocator_type::pointer;
-            using const_pointer = typename allocator_type::const_pointer;
-            using iterator = Deque_Iterator<value_type, value_type&, value_type*>;
-            using const_iterator = Deque_Iterator<value_type, const value_type&, const value_type*>;
+            using pointer = typename std::allocator_traits<Alloc>::pointer;
+            using const_pointer = typename std::allocator_traits<Alloc>::const_pointer;
+            static constexpr size_type block_size = Deque_Block_Size<T, BlockBytes>::value;
+
+            using iterator = Deque_Iterator<value_type, value_type&, value_type*, block_size>;
+            using const_iterator = Deque_Iterator<value_type, const value_type&, const value_type*, block_size>;
             using reverse_iterator = Reverse_Iterator<iterator>;
             using const_reverse_iterator = Reverse_Iterator<const_iterator>;
 
             using map_ptr = pointer*;
-            using map_allocator = std::allocator<pointer>;
-
-            const size_type block_size = sizeof(T) < 512 ? 512/sizeof(T) : 1;
+            using map_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<pointer>;
 
-            allocator_type _get_al(){return allocator_type();}
-            
-            map_allocator _get_map_al(){return map_allocator();}
+            static_assert(std::is_same<pointer, T*>::value, "Deque only supports allocators with raw pointers");
 
         private:
+            using alloc_traits = std::allocator_traits<allocator_type>;
+            using map_traits = std::allocator_traits<map_allocator>;
+
+            allocator_type _al;
+
+            map_allocator _map_al;
+
             iterator _begin;
 
             iterator _end;
@@ -207,35 +260,61 @@ namespace MyStl
 
             size_type _map_size;
 
+            // emptied blocks kept for reuse, so a deque used as a queue stops calling the allocator
+            pointer _spare_blocks[DEQUE_MAX_SPARE_BLOCKS > 0 ? DEQUE_MAX_SPARE_BLOCKS : 1] = {};
+
+            size_type _spare_count = 0;
+
+            Deque_Map_Stats _map_stats;
+
         public:
             /* ctor and dtor */
-            Deque(){
+            Deque(): Deque(Alloc()){}
+
+            explicit Deque(const Alloc& al): _al(al), _map_al(al){
                 fill_init_n(0, value_type());
             }
 
-            Deque(size_type count, const T& value){
+            Deque(size_type count, const T& value, const Alloc& al = Alloc()): _al(al), _map_al(al){
                 fill_init_n(count, value);
             }
 
-            explicit Deque(size_type count){
+            explicit Deque(size_type count, const Alloc& al = Alloc()): _al(al), _map_al(al){
                 fill_init_n(count, value_type());
             }
             
             template<class InputIt,typename std::enable_if<MyStl::Is_Input_Iterator<InputIt>::value, bool>::type = true> 
-            Deque(InputIt first, InputIt last){
-                assert(first < last);
+            Deque(InputIt first, InputIt last, const Alloc& al = Alloc()): _al(al), _map_al(al){
+                assert(first <= last);
 
                 copy_init(first, last);
             }
 
-            Deque(const Deque& other): Deque(other._begin, other._end){}
+            Deque(const Deque& other)
+                : Deque(other._begin, other._end, alloc_traits::select_on_container_copy_construction(other._al)){}
 
-            Deque(Deque&& other): _begin(std::move(other._begin)), _end(std::move(other._end)), 
+            Deque(const Deque& other, const Alloc& al): Deque(other._begin, other._end, al){}
+
+            Deque(Deque&& other): _al(std::move(other._al)), _map_al(std::move(other._map_al)), 
+                                _begin(std::move(other._begin)), _end(std::move(other._end)), 
                                 _map(other._map), _map_size(other._map_size){
                 other._map = nullptr;
+                take_spare_blocks(other);
             }
 
-            Deque(std::initializer_list<T> init): Deque(init.begin(), init.end()){}
+            Deque(Deque&& other, const Alloc& al): _al(al), _map_al(al), _map(nullptr), _map_size(0){
+                if (_al == other._al){
+                    steal(other);
+                }else{
+                    // blocks of other can't be released by al, so elements have to be moved one by one
+                    fill_init_n(0, value_type());
+                    for (auto i = other._begin; i != other._end; ++i){
+                        emplace_back(std::move(*i));
+                    }
+                }
+            }
+
+            Deque(std::initializer_list<T> init, const Alloc& al = Alloc()): Deque(init.begin(), init.end(), al){}
 
             ~Deque(){
                 tidy();
@@ -243,48 +322,48 @@ namespace MyStl
 
             Deque& operator=(const Deque& other){
                 if (&other != this){
-                    Deque<T> temp(other);
-                    swap(temp);
+                    MyStl::alloc_on_copy(_al, other._al, [this](){tidy();});
+                    _map_al = map_allocator(_al);
+
+                    Deque temp(other, _al);
+                    swap_data(temp);
                 }
 
                 return *this;
             }
 
             Deque& operator=(Deque&& other){
-                tidy();
-                _begin = std::move(other._begin);
-                _end = std::move(other._end);
-                _map = other._map;
-                _map_size = other._map_size;
-
-                other._map = nullptr;
-                other._map_size = 0;
+                if (&other != this){
+                    move_assign(other, typename alloc_traits::propagate_on_container_move_assignment());
+                }
 
                 return *this;
             }
 
             Deque& operator=(std::initializer_list<T> ilist){
-                Deque<T> temp(ilist);
-                swap(temp);
+                Deque temp(ilist, _al);
+                swap_data(temp);
                 return *this;
             }
 
             void assign (size_type count, const T& value){
-                Deque<T> temp(count, value);
+                Deque temp(count, value, _al);
 
-                swap(temp);
+                swap_data(temp);
             }
 
             template<class InputIt,typename std::enable_if<MyStl::Is_Input_Iterator<InputIt>::value, bool>::type = true> 
             void assign(InputIt first, InputIt last){
-                Deque<T> temp(first, last);
-                swap(temp);
+                Deque temp(first, last, _al);
+                swap_data(temp);
             }
 
             void assign(std::initializer_list<T> ilist){
                 assign(ilist.begin(), ilist.end());
             }
 
+            allocator_type get_allocator() const noexcept {return _al;}
+
         public:
             /* member access */
             reference at(size_type pos){
@@ -339,7 +418,7 @@ namespace MyStl
                 return _begin;
             }
 
-            const_reference cbegin() const noexcept {
+            const_iterator cbegin() const noexcept {
                 return _begin;
             }
 
@@ -351,7 +430,7 @@ namespace MyStl
                 return _end;
             }
 
-            const_reference cend() const noexcept {
+            const_iterator cend() const noexcept {
                 return _end;
             }
 
@@ -393,25 +472,24 @@ namespace MyStl
                 return static_cast<size_type>(-1) / sizeof(value_type);
             }
 
+            // gives back the blocks that hold no element, the map itself keeps its size
             void shrink_to_fit(){
-                for (auto i = _map; i < _begin.map_node; ++i){
-                    if (_map_size > static_cast<size_type>(DEQUE_INITIAL_MINIMUN_MAP_SIZE)){
-                        _get_al().deallocate(*i, block_size);
-                        _get_map_al().deallocate(i, 1);
-                        ++_map;
-                        --_map_size;
+                for (auto i = _map; i != _map + _map_size; ++i){
+                    if (*i && (i < _begin.map_node || i > _end.map_node)){
+                        alloc_traits::deallocate(_al, *i, block_size);
+                        *i = nullptr;
                     }
                 }
 
-                for (auto j = _map + _map_size; j > _end.map_node; --j){
-                    if (_map_size > static_cast<size_type>(DEQUE_INITIAL_MINIMUN_MAP_SIZE)){
-                        _get_al().deallocate(*j, block_size);
-                        _get_map_al().deallocate(j, 1);
-                        --_map_size;
-                    }
-                }
+                release_spare_blocks();
             }
 
+            size_type map_size() const noexcept {return _map_size;}
+
+            const Deque_Map_Stats& map_stats() const noexcept {return _map_stats;}
+
+            void reset_map_stats() noexcept {_map_stats = Deque_Map_Stats();}
+
         public:
             /*  modifiers  */
             void clear() noexcept {
@@ -425,17 +503,26 @@ namespace MyStl
                     destroy_range(_end.first, _end.cur);
                 }
 
-                _begin.change_node_to(_map + _map_size / 2);
+                // keep one block, moved to the middle of the map so both ends have room to grow
+                pointer kept = *_begin.map_node;
+                for (auto i = _begin.map_node; i <= _end.map_node; ++i){
+                    if (*i != kept) release_block(*i);
+                    *i = nullptr;
+                }
+
+                map_ptr middle = _map + _map_size / 2;
+                if (*middle) release_block(*middle);
+                *middle = kept;
+                _begin.change_node_to(middle);
                 _begin.cur = _begin.first;
                 _end = _begin;
             }
 
             void swap(Deque& other){
                 if (&other != this){
-                    std::swap(_begin, other._begin);
-                    std::swap(_end, other._end);
-                    std::swap(_map, other._map);
-                    std::swap(_map_size, other._map_size);
+                    MyStl::alloc_on_swap(_al, other._al);
+                    MyStl::alloc_on_swap(_map_al, other._map_al);
+                    swap_data(other);
                 }
             }
 
@@ -444,7 +531,7 @@ namespace MyStl
                     add_block_front(1);
                 }
                 try{
-                    _get_al().construct((--_begin).cur, std::forward<Args>(args)...);
+                    alloc_traits::construct(_al, (--_begin).cur, std::forward<Args>(args)...);
                 }catch(...){
                     ++_begin;
                     throw;
@@ -456,7 +543,7 @@ namespace MyStl
                     add_block_back(1);
                 }
                 try{
-                    _get_al().construct((_end++).cur, std::forward<Args>(args)...);
+                    alloc_traits::construct(_al, (_end++).cur, std::forward<Args>(args)...);
                 }catch(...){
                     --_end;
                     throw;
@@ -496,22 +583,22 @@ namespace MyStl
                 
                 size_type elem_before = pos - _begin, elem_after = _end - pos;
                 if (pos.cur == _begin.cur){
-                    MyStl::destroy(_begin.cur);
+                    alloc_traits::destroy(_al, _begin.cur);
                     ++_begin;
                 }
                 else if (pos.cur == (_end - 1).cur){
-                    MyStl::destroy((_end - 1).cur);
+                    alloc_traits::destroy(_al, (_end - 1).cur);
                     --_end;
                 }
                 else{
                     auto next = pos + 1;
                     if (size() - elem_before >= elem_after){    //pos in the first half
                         MyStl::copy_backward(_begin, pos, next);
-                        MyStl::destroy(_begin.cur);
+                        alloc_traits::destroy(_al, _begin.cur);
                         ++_begin;
                     }else{   //pos in the second half
                         MyStl::copy(pos + 1, _end, pos);
-                        MyStl::destroy((_end - 1).cur);
+                        alloc_traits::destroy(_al, (_end - 1).cur);
                         --_end;
                     }
                 }
@@ -561,10 +648,10 @@ namespace MyStl
                 assert(!empty());
 
                 --_end;
-                MyStl::destroy(_end.cur);
+                alloc_traits::destroy(_al, _end.cur);
 
                 if (_end.cur == _end.last - 1){ //last block is totally empty after deletion
-                    _get_al().deallocate(*(_end.map_node + 1), block_size);
+                    release_block(*(_end.map_node + 1));
                     *(_end.map_node + 1) = nullptr;
                 }
             }
@@ -572,11 +659,11 @@ namespace MyStl
             void pop_front(){
                 assert(!empty());
 
-                MyStl::destroy(_begin.cur);
+                alloc_traits::destroy(_al, _begin.cur);
                 ++_begin;
 
                 if (_begin.cur == _begin.first){    //first block totally empty after deletion
-                    _get_al().deallocate(*(_begin.map_node - 1), block_size);
+                    release_block(*(_begin.map_node - 1));
                     *(_begin.map_node - 1) = nullptr;
                 }
             }
@@ -666,13 +753,13 @@ namespace MyStl
                     auto _pos = _begin + elem_before;
 
                     if (elem_before >= count){  //overlap
-                        MyStl::uninitialized_copy(_begin, _begin + count, _begin - count);
+                        uninitialized_copy(_begin, _begin + count, _begin - count);
                         MyStl::copy(_begin + count, _pos, _begin);
                         MyStl::fill(_pos - count, _pos, value);
                         _begin -= count;
                     }else{
-                        auto fill_start_iter = MyStl::uninitialized_copy(_begin, _pos, _begin - count);
-                        MyStl::uninitialized_fill(fill_start_iter, _begin, value);
+                        auto fill_start_iter = uninitialized_copy(_begin, _pos, _begin - count);
+                        uninitialized_fill(fill_start_iter, _begin, value);
                         MyStl::fill(_begin, _pos, value);
                         _begin -= count;
                     }
@@ -685,14 +772,15 @@ namespace MyStl
                     auto _pos = _end - elem_after;
                     
                     if (elem_after >= count){
-                        MyStl::uninitialized_copy(_end - count, _end, _end);
+                        uninitialized_copy(_end - count, _end, _end);
                         MyStl::copy_backward(_pos, _end - count, _end);
                         MyStl::fill(_pos, _pos + count, value);
                         _end += count;
                     }else{
-                        MyStl::uninitialized_copy(_pos, _end, _pos + count);
+                        uninitialized_copy(_pos, _end, _pos + count);
                         MyStl::fill(_pos, _end, value);
-                        MyStl::uninitialized_fill(_end, _pos + count, value);
+                        uninitialized_fill(_end, _pos + count, value);
+                        _end += count;
                     }
                 }
                 
@@ -720,6 +808,7 @@ namespace MyStl
                     auto _pos = _begin + elem_before;
                     insert(_pos, *first);
                     ++elem_before;
+                    ++first;
                 }
 
                 return _begin + original_elem_before;
@@ -739,15 +828,15 @@ namespace MyStl
                     auto _pos = _begin + elem_before;
 
                     if (elem_before >= count){  //overlap
-                        MyStl::uninitialized_copy(_begin, _begin + count, _begin - count);
+                        uninitialized_copy(_begin, _begin + count, _begin - count);
                         auto copy_start = MyStl::copy(_begin + count, _pos, _begin);
                         MyStl::copy(first, last, copy_start);
                         _begin -= count;
                     }else{
                         auto mid = first;
                         MyStl::advance(mid, count - elem_before);
-                        auto copy_start = MyStl::uninitialized_copy(_begin, _pos, _begin - count);
-                        MyStl::uninitialized_copy(first, mid, copy_start);
+                        auto copy_start = uninitialized_copy(_begin, _pos, _begin - count);
+                        uninitialized_copy(first, mid, copy_start);
                         MyStl::copy(mid, last, _begin);
                         _begin -= count;
                     }
@@ -760,15 +849,15 @@ namespace MyStl
                     auto _pos = _end - elem_after;
                     
                     if (elem_after >= count){
-                        MyStl::uninitialized_copy(_end - count, _end, _end);
+                        uninitialized_copy(_end - count, _end, _end);
                         MyStl::copy_backward(_pos, _end - count, _end);
                         MyStl::copy(first, last, _pos);
                         _end += count;
                     }else{
                         auto mid = first;
-                        MyStl::advance(mid, count - elem_after);
-                        auto copy_start = MyStl::uninitialized_copy(mid, last, _end);
-                        MyStl::uninitialized_copy(_pos, _end, copy_start);
+                        MyStl::advance(mid, elem_after);
+                        auto copy_start = uninitialized_copy(mid, last, _end);
+                        uninitialized_copy(_pos, _end, copy_start);
                         MyStl::copy(first, mid, _pos);
                         _end += count;
                     }
@@ -782,18 +871,22 @@ namespace MyStl
                 _map_size = MyStl::max(num_block + 2, static_cast<size_type>(DEQUE_INITIAL_MINIMUN_MAP_SIZE));
 
                 try{
-                    _map = _get_map_al().allocate(_map_size);
+                    _map = map_traits::allocate(_map_al, _map_size);
                 }catch(...){
                     _map = nullptr;
                     throw;
                 }
+                std::fill(_map, _map + _map_size, nullptr);     //slots without a block must stay null so tidy() can skip them
 
                 map_ptr block_begin = _map + (_map_size - num_block) / 2;
 
                 try{
                     create_blocks_n(block_begin, num_block);
                 }catch(...){
-                    _get_map_al().deallocate(_map, _map_size);
+                    for (auto i = block_begin; i != block_begin + num_block; ++i){
+                        if (*i) alloc_traits::deallocate(_al, *i, block_size);
+                    }
+                    map_traits::deallocate(_map_al, _map, _map_size);
                     _map = nullptr;
                     throw;
                 }
@@ -804,30 +897,44 @@ namespace MyStl
                 _end.cur = _end.first + (num_elem % block_size);
             }
 
+            // slots that still hold a block keep it, on failure the blocks made so far stay in the map for tidy()
             void create_blocks_n(map_ptr begin, size_type n){
-                auto cur = begin;
+                for (auto cur = begin; cur != begin + n; ++cur){
+                    if (!*cur) *cur = acquire_block();
+                }
+            }
 
-                try{
-                    for (size_type i = 0; i < n; ++i, ++cur){
-                        *(begin + i) = _get_al().allocate(block_size);
-                    }
-                }catch(...){
-                    for (; cur != begin; --cur){
-                        _get_al().deallocate(*(cur - 1), block_size);
-                        cur = nullptr;
-                    }
-                    throw;
+            pointer acquire_block(){
+                if (_spare_count) return _spare_blocks[--_spare_count];
+
+                return alloc_traits::allocate(_al, block_size);
+            }
+
+            void release_block(pointer block){
+                if (_spare_count < DEQUE_MAX_SPARE_BLOCKS) _spare_blocks[_spare_count++] = block;
+                else alloc_traits::deallocate(_al, block, block_size);
+            }
+
+            void release_spare_blocks() noexcept {
+                while (_spare_count){
+                    alloc_traits::deallocate(_al, _spare_blocks[--_spare_count], block_size);
                 }
             }
 
+            void take_spare_blocks(Deque& other) noexcept {
+                std::copy(other._spare_blocks, other._spare_blocks + other._spare_count, _spare_blocks);
+                _spare_count = other._spare_count;
+                other._spare_count = 0;
+            }
+
             void fill_init_n(size_type n, const value_type& value){
                 init_map_n(n);
 
                 for (auto cur = _begin.map_node; cur != _end.map_node; ++cur){
-                    MyStl::uninitialized_fill(*cur, *cur + block_size, value);
+                    uninitialized_fill(*cur, *cur + block_size, value);
                 }
 
-                MyStl::uninitialized_fill(*_end.map_node, _end.cur, value);
+                uninitialized_fill(*_end.map_node, _end.cur, value);
             }
 
             template <typename InputIt>
@@ -835,13 +942,45 @@ namespace MyStl
                 init_map_n(static_cast<size_type>(last - first));
 
                 for (auto i = _begin; first != last; ++first, ++i){
-                    _get_al().construct(i.cur, *first);
+                    alloc_traits::construct(_al, i.cur, *first);
+                }
+            }
+
+            template <typename InputIt, typename ForwardIt>
+            ForwardIt uninitialized_copy(InputIt first, InputIt last, ForwardIt result){
+                ForwardIt cur = result;
+                try{
+                    for (; first != last; ++first, ++cur){
+                        alloc_traits::construct(_al, &*cur, *first);
+                    }
+                }catch(...){
+                    for (; result != cur; ++result){
+                        alloc_traits::destroy(_al, &*result);
+                    }
+                    throw;
+                }
+
+                return cur;
+            }
+
+            template <typename ForwardIt>
+            void uninitialized_fill(ForwardIt first, ForwardIt last, const value_type& value){
+                ForwardIt cur = first;
+                try{
+                    for (; cur != last; ++cur){
+                        alloc_traits::construct(_al, &*cur, value);
+                    }
+                }catch(...){
+                    for (; first != cur; ++first){
+                        alloc_traits::destroy(_al, &*first);
+                    }
+                    throw;
                 }
             }
 
             void destroy_range(pointer first, pointer last){
                 for (auto cur = first; cur != last; ++cur){
-                    _get_al().destroy(cur);
+                    alloc_traits::destroy(_al, cur);
                 }
             }
 
@@ -849,107 +988,146 @@ namespace MyStl
                 if (_map){
                     clear();
                     for (auto i = _map; i < _map + _map_size; ++i){
-                        _get_al().deallocate(*i, block_size);
+                        if (*i) alloc_traits::deallocate(_al, *i, block_size);
                     }
 
-                    _get_map_al().deallocate(_map, _map_size);
+                    map_traits::deallocate(_map_al, _map, _map_size);
                     _map = nullptr;
                 }
+                release_spare_blocks();
             }
 
-            void add_block_front(size_type num_blk_require){      
-                if (_begin.map_node - _map >= num_blk_require){   // if the number of map nodes are greater than or equal to n
-                    decltype(_map) cur = _begin.map_node - num_blk_require;
-                    try{
-                        for (; cur != _begin.map_node; ++cur){
-                            *cur = _get_al().allocate(block_size);
-                        }
-                    }catch(...){
-                        for (; cur != _begin.map_node - num_blk_require - 1; --cur){
-                            _get_al().deallocate(*(cur - 1), block_size);
-                        }
-                    }
+            void swap_data(Deque& other) noexcept {
+                std::swap(_begin, other._begin);
+                std::swap(_end, other._end);
+                std::swap(_map, other._map);
+                std::swap(_map_size, other._map_size);
+                std::swap(_spare_blocks, other._spare_blocks);
+                std::swap(_spare_count, other._spare_count);
+            }
+
+            // take over the map and blocks of other, which must be releasable by this allocator
+            void steal(Deque& other) noexcept {
+                _begin = other._begin;
+                _end = other._end;
+                _map = other._map;
+                _map_size = other._map_size;
+                take_spare_blocks(other);
+
+                other._map = nullptr;
+                other._map_size = 0;
+            }
+
+            void move_assign(Deque& other, std::true_type){
+                tidy();
+                _al = std::move(other._al);
+                _map_al = std::move(other._map_al);
+                steal(other);
+            }
+
+            void move_assign(Deque& other, std::false_type){
+                if (_al == other._al){
+                    tidy();
+                    steal(other);
                 }else{
+                    clear();
+                    for (auto i = other._begin; i != other._end; ++i){
+                        emplace_back(std::move(*i));
+                    }
+                }
+            }
+
+            void add_block_front(size_type num_blk_require){
+                if (static_cast<size_type>(_begin.map_node - _map) < num_blk_require){
                     map_resize(num_blk_require, true);
                 }
+
+                create_blocks_n(_begin.map_node - num_blk_require, num_blk_require);
             }
 
             void add_block_back(size_type num_blk_require){
-                if (_map_size - (_end.map_node - _map) - 1 >= num_blk_require){
-                    decltype(_map) cur = _end.map_node + 1;
-                    try{
-                        for (size_t i = 0; i < num_blk_require; ++i, ++cur){
-                            *cur = _get_al().allocate(block_size);
-                        }
-                    }catch(...){
-                        for (; cur != _end.map_node; --cur){
-                            _get_al().deallocate(*(cur - 1), block_size);
-                        }
-                    }
-                }else{
+                if (_map_size - (_end.map_node - _map) - 1 < num_blk_require){
                     map_resize(num_blk_require, false);
                 }
+
+                create_blocks_n(_end.map_node + 1, num_blk_require);
             }
 
+            /* makes at least num_new_blocks free slots at the requested end. A deque used as a queue keeps
+               drifting towards one end of its map while the other end empties, so as long as the map is
+               more than twice as large as what is needed the used slots are moved back to the middle in
+               place. Otherwise the map grows geometrically, which keeps the reallocations amortized O(1) */
             void map_resize(size_type num_new_blocks, bool front){
-                auto new_map_size = MyStl::max(_map_size * 2, _map_size + num_new_blocks);
-                decltype(_map) new_map = _get_map_al().allocate(new_map_size);
-                decltype(_map) new_beg, new_end;
-
-                if (front){
-                    //keep the # of blocks at the back unchanged
-                    size_t block_at_back = ((_map + _map_size) - _end.map_node) - 1;
-                    new_end = new_map + (new_map_size - block_at_back);
-                    new_beg = new_end - _map_size;
-                    create_blocks_n(new_beg, _map_size);
-                    for (auto cur_new = new_beg, cur_original = _begin.map_node; 
-                         cur_original != _end.map_node; 
-                         ++cur_new, ++cur_original){
-                             *cur_new = *cur_original;
+                size_type used_nodes = _end.map_node - _begin.map_node + 1;
+                size_type needed_nodes = used_nodes + num_new_blocks;
+
+                // blocks parked outside the used slots would be overwritten or left behind
+                for (auto i = _map; i != _map + _map_size; ++i){
+                    if (*i && (i < _begin.map_node || i > _end.map_node)){
+                        release_block(*i);
+                        *i = nullptr;
                     }
+                }
+
+                map_ptr new_beg;
+                if (_map_size > 2 * needed_nodes){
+                    new_beg = _map + (_map_size - needed_nodes) / 2 + (front ? num_new_blocks : 0);
+                    if (new_beg < _begin.map_node) std::copy(_begin.map_node, _end.map_node + 1, new_beg);
+                    else std::copy_backward(_begin.map_node, _end.map_node + 1, new_beg + used_nodes);
+
+                    // null the slots the move left behind
+                    if (new_beg < _begin.map_node) std::fill(MyStl::max(new_beg + used_nodes, _begin.map_node), _end.map_node + 1, nullptr);
+                    else std::fill(_begin.map_node, MyStl::min(new_beg, _end.map_node + 1), nullptr);
+                    ++_map_stats.recenters;
                 }else{
-                    size_t block_at_front = _begin.map_node - _map;
-                    new_beg = new_map + block_at_front;
-                    new_end = new_beg + _map_size;
-                    create_blocks_n(new_beg, _map_size);
-                    for (auto cur_new = new_beg, cur_original = _begin.map_node; 
-                         cur_original != _end.map_node; 
-                         ++cur_new, ++cur_original){
-                             *cur_new = *cur_original;
-                    }
+                    size_type new_map_size = _map_size + MyStl::max(_map_size, num_new_blocks) + 2;
+                    map_ptr new_map = map_traits::allocate(_map_al, new_map_size);
+                    std::fill(new_map, new_map + new_map_size, nullptr);
+
+                    new_beg = new_map + (new_map_size - needed_nodes) / 2 + (front ? num_new_blocks : 0);
+                    std::copy(_begin.map_node, _end.map_node + 1, new_beg);
+                    map_traits::deallocate(_map_al, _map, _map_size);
+
+                    _map = new_map;
+                    _map_size = new_map_size;
+                    ++_map_stats.reallocations;
                 }
 
-                _get_map_al().deallocate(_map, _map_size);
-                _map = new_map;
-                _map_size = new_map_size;
-                _begin = iterator(new_beg, *new_beg + (_begin.cur - _begin.first));
-                _end = iterator(new_end - 1, *(new_end - 1) + (_end.cur - _end.first));
+                reseat(_begin, new_beg);
+                reseat(_end, new_beg + used_nodes - 1);
+            }
+
+            // points it at the same element after its block moved to slot node
+            static void reseat(iterator& it, map_ptr node){
+                auto offset = it.cur - it.first;
+                it.change_node_to(node);
+                it.cur = it.first + offset;
             }
     };
     
-    template <typename T>
-    bool operator==(const Deque<T>& lhs, const Deque<T>& rhs){
+    template <typename T, typename Alloc, std::size_t BlockBytes>
+    bool operator==(const Deque<T, Alloc, BlockBytes>& lhs, const Deque<T, Alloc, BlockBytes>& rhs){
         if (lhs.size() != rhs.size()) return false;
 
         return MyStl::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
 
-    template<class T>
-    bool operator!=(const MyStl::Deque<T>& lhs, const MyStl::Deque<T>& rhs){return !(lhs == rhs);}
+    template<class T, class Alloc, std::size_t BlockBytes>
+    bool operator!=(const MyStl::Deque<T, Alloc, BlockBytes>& lhs, const MyStl::Deque<T, Alloc, BlockBytes>& rhs){return !(lhs == rhs);}
 
-    template<class T>
-    bool operator<(const MyStl::Deque<T>& lhs, const MyStl::Deque<T>& rhs){
+    template<class T, class Alloc, std::size_t BlockBytes>
+    bool operator<(const MyStl::Deque<T, Alloc, BlockBytes>& lhs, const MyStl::Deque<T, Alloc, BlockBytes>& rhs){
         return MyStl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
     }
 
-    template<class T>
-    bool operator<=(const MyStl::Deque<T>& lhs, const MyStl::Deque<T>& rhs){return !(rhs < lhs);}
+    template<class T, class Alloc, std::size_t BlockBytes>
+    bool operator<=(const MyStl::Deque<T, Alloc, BlockBytes>& lhs, const MyStl::Deque<T, Alloc, BlockBytes>& rhs){return !(rhs < lhs);}
 
-    template<class T>
-    bool operator>(const MyStl::Deque<T>& lhs, const MyStl::Deque<T>& rhs){return rhs < lhs;}
+    template<class T, class Alloc, std::size_t BlockBytes>
+    bool operator>(const MyStl::Deque<T, Alloc, BlockBytes>& lhs, const MyStl::Deque<T, Alloc, BlockBytes>& rhs){return rhs < lhs;}
 
-    template<class T>
-    bool operator>=(const MyStl::Deque<T>& lhs, const MyStl::Deque<T>& rhs){return !(lhs < rhs);}
+    template<class T, class Alloc, std::size_t BlockBytes>
+    bool operator>=(const MyStl::Deque<T, Alloc, BlockBytes>& lhs, const MyStl::Deque<T, Alloc, BlockBytes>& rhs){return !(lhs < rhs);}
     
 } // namespace MyStl
 
@@ -0,0 +1,456 @@
+#ifndef MYSTL_INTRUSIVELIST_H
+#define MYSTL_INTRUSIVELIST_H
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#include "Iterator.h"
+#include "List.h"
+
+namespace MyStl{
+    /* maps between an object and the Node_Base member Hook embedded in it */
+    template<typename T, Node_Base<T> T::*Hook>
+    struct Intrusive_Hook_Traits{
+        using base_ptr = Node_Base<T>*;
+
+        static base_ptr to_node(const T& value){
+            offset(&value);
+            return const_cast<base_ptr>(&(value.*Hook));
+        }
+
+        static T* to_value(base_ptr node){
+            return reinterpret_cast<T*>(reinterpret_cast<char*>(node) - offset());
+        }
+
+        /* where Hook sits inside T, measured once on the first object passed to to_node, so no T has
+           to be made up for it. Every node to_value gets was linked through to_node first */
+        static std::ptrdiff_t offset(const T* value = nullptr){
+            static const std::ptrdiff_t measured = measure_offset(value);
+            return measured;
+        }
+
+        static std::ptrdiff_t measure_offset(const T* value){
+            assert(value && "a node that never went through to_node");
+            return reinterpret_cast<const char*>(&(value->*Hook)) - reinterpret_cast<const char*>(value);
+        }
+    };
+
+    template<typename T, Node_Base<T> T::*Hook, typename Reference, typename Pointer>
+    class Intrusive_List_Iterator: public MyStl::Iterator<Bidirectional_Iterator_Tag, T, std::ptrdiff_t, Pointer, Reference>{
+        template<typename U, Node_Base<U> U::*> friend class IntrusiveList;
+        template<typename U, Node_Base<U> U::*, typename, typename> friend class Intrusive_List_Iterator;
+        public:
+            using value_type = T;
+            using reference = Reference;
+            using pointer = Pointer;
+            using base_ptr = Node_Base<T>*;
+
+        private:
+            using hook_traits = Intrusive_Hook_Traits<T, Hook>;
+
+            base_ptr _node;
+
+        public:
+            Intrusive_List_Iterator() = default;
+
+            Intrusive_List_Iterator(const Intrusive_List_Iterator& other): _node(other._node){}
+
+            //iterator to const_iterator
+            template<typename R, typename P,
+                     typename std::enable_if<std::is_convertible<P, Pointer>::value, bool>::type = true>
+            Intrusive_List_Iterator(const Intrusive_List_Iterator<T, Hook, R, P>& other): _node(other._node){}
+
+            explicit Intrusive_List_Iterator(base_ptr bp): _node(bp){}
+
+            Intrusive_List_Iterator& operator=(const Intrusive_List_Iterator& other) = default;
+
+            reference operator*() const {return *hook_traits::to_value(_node);}
+
+            pointer operator->() const {return hook_traits::to_value(_node);}
+
+            Intrusive_List_Iterator& operator++(){
+                assert(_node);
+                _node = _node->_next;
+                return *this;
+            }
+
+            Intrusive_List_Iterator& operator--(){
+                assert(_node);
+                _node = _node->_previous;
+                return *this;
+            }
+
+            Intrusive_List_Iterator operator++(int){
+                assert(_node);
+                auto temp = *this;
+                _node = _node->_next;
+                return temp;
+            }
+
+            Intrusive_List_Iterator operator--(int){
+                assert(_node);
+                auto temp = *this;
+                _node = _node->_previous;
+                return temp;
+            }
+
+            bool operator==(const Intrusive_List_Iterator& rhs) const {
+                return _node == rhs._node;
+            }
+
+            bool operator != (const Intrusive_List_Iterator& rhs) const {
+                return _node != rhs._node;
+            }
+    };
+
+    /* circular doubly-linked list of objects that carry their own links in the member Hook, e.g.
+           struct Job { int id; MyStl::Node_Base<Job> hook; };
+           MyStl::IntrusiveList<Job, &Job::hook> jobs;
+       A hook is unlinked while both its pointers are null, which is how it is constructed. The list
+       never allocates, copies or destroys an object, it only links and unlinks them, so an object has
+       to stay where it is while it is in a list and can be in one list per hook at a time. Knowing
+       the object is enough to take it out in O(1) */
+    template<typename T, Node_Base<T> T::*Hook>
+    class IntrusiveList{
+        public:
+        /* type defs */
+            using value_type = T;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using reference = value_type&;
+            using const_reference = const value_type&;
+            using pointer = value_type*;
+            using const_pointer = const value_type*;
+            using iterator = Intrusive_List_Iterator<T, Hook, T&, T*>;
+            using const_iterator = Intrusive_List_Iterator<T, Hook, const T&, const T*>;
+            using reverse_iterator = Reverse_Iterator<iterator>;
+            using const_reverse_iterator = Reverse_Iterator<const_iterator>;
+
+            using base_ptr = Node_Base<T>*;
+            using base_type = Node_Base<T>;
+
+        private:
+            using hook_traits = Intrusive_Hook_Traits<T, Hook>;
+
+            base_type _end;     //the sentinel lives in the list itself, a move relinks the first and last node to it
+            size_type _size;
+
+        public:
+        /* ctor and dtor */
+        IntrusiveList() noexcept: _size(0){
+            _end.set_init_status();
+        }
+
+        //links every object in [first, last), which must stay where they are
+        template<class InputIt, typename std::enable_if<MyStl::Is_Input_Iterator<InputIt>::value, bool>::type = true>
+        IntrusiveList(InputIt first, InputIt last): IntrusiveList(){
+            for (; first != last; ++first) push_back(*first);
+        }
+
+        //an object can't be linked into two lists through the same hook
+        IntrusiveList(const IntrusiveList&) = delete;
+
+        IntrusiveList(IntrusiveList&& other) noexcept: IntrusiveList(){
+            steal(other);
+        }
+
+        //the objects themselves are left alone
+        ~IntrusiveList(){
+            clear();
+        }
+
+        IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+        IntrusiveList& operator=(IntrusiveList&& other) noexcept {
+            if (this != &other){
+                clear();
+                steal(other);
+            }
+
+            return *this;
+        }
+
+        public:
+        /* element access */
+        reference front(){
+            assert(!empty());
+            return *begin();
+        }
+
+        const_reference front() const {
+            assert(!empty());
+            return *begin();
+        }
+
+        reference back(){
+            assert(!empty());
+            return *hook_traits::to_value(_end._previous);
+        }
+
+        const_reference back() const {
+            assert(!empty());
+            return *hook_traits::to_value(_end._previous);
+        }
+
+        public:
+        /* iterators */
+        iterator begin() noexcept {return iterator(_end._next);}
+
+        const_iterator begin() const noexcept {return const_iterator(_end._next);}
+
+        const_iterator cbegin() const noexcept {return begin();}
+
+        iterator end() noexcept {return iterator(&_end);}
+
+        const_iterator end() const noexcept {return const_iterator(end_node());}
+
+        const_iterator cend() const noexcept {return end();}
+
+        reverse_iterator rbegin() noexcept {return reverse_iterator(end());}
+
+        const_reverse_iterator rbegin() const noexcept {return const_reverse_iterator(end());}
+
+        const_reverse_iterator crbegin() const noexcept {return rbegin();}
+
+        reverse_iterator rend() noexcept {return reverse_iterator(begin());}
+
+        const_reverse_iterator rend() const noexcept {return const_reverse_iterator(begin());}
+
+        const_reverse_iterator crend() const noexcept {return rend();}
+
+        //the iterator to an object that is in this list, O(1)
+        iterator iterator_to(reference value) noexcept {return iterator(hook_traits::to_node(value));}
+
+        const_iterator iterator_to(const_reference value) const noexcept {return const_iterator(hook_traits::to_node(value));}
+
+        public:
+        /* capacity */
+        bool empty() const noexcept {return _size == 0;}
+
+        size_type size() const noexcept {return _size;}
+
+        public:
+        /* modifiers */
+        //unlinks every object, O(n) to leave them unlinked rather than pointing into the list
+        void clear() noexcept {
+            for (base_ptr cur = _end._next; cur != &_end; ){
+                base_ptr next = cur->_next;
+                cur->_previous = cur->_next = nullptr;
+                cur = next;
+            }
+
+            _end.set_init_status();
+            _size = 0;
+        }
+
+        //value must not be in a list through Hook yet
+        iterator insert(const_iterator pos, reference value){
+            base_ptr node = hook_traits::to_node(value);
+            assert(!node->_previous && !node->_next);
+            list_link_nodes(node, node, pos._node);
+            ++_size;
+            return iterator(node);
+        }
+
+        template<class InputIt, typename std::enable_if<MyStl::Is_Input_Iterator<InputIt>::value, bool>::type = true>
+        iterator insert(const_iterator pos, InputIt first, InputIt last){
+            iterator ret(pos._node);
+            bool first_insert = true;
+            for (; first != last; ++first){
+                iterator it = insert(pos, *first);
+                if (first_insert) ret = it;
+                first_insert = false;
+            }
+
+            return ret;
+        }
+
+        iterator erase(const_iterator pos){
+            assert(pos != end());
+            base_ptr node = pos._node, next = node->_next;
+            list_unlink_nodes(node, node);
+            node->_previous = node->_next = nullptr;
+            --_size;
+            return iterator(next);
+        }
+
+        iterator erase(const_iterator first, const_iterator last){
+            while (first != last) first = erase(first);
+            return iterator(last._node);
+        }
+
+        //takes value out of this list, which it must be in, O(1)
+        void unlink(reference value){
+            erase(iterator_to(value));
+        }
+
+        void push_back(reference value){
+            insert(end(), value);
+        }
+
+        void push_front(reference value){
+            insert(begin(), value);
+        }
+
+        void pop_back(){
+            assert(!empty());
+            erase(const_iterator(_end._previous));
+        }
+
+        void pop_front(){
+            assert(!empty());
+            erase(begin());
+        }
+
+        void swap(IntrusiveList& other) noexcept {
+            IntrusiveList temp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(temp);
+        }
+
+        public:
+        /* operations */
+        template <class Compare>
+        void merge(IntrusiveList&& other, Compare comp){
+            if (&other != this){
+                list_merge_nodes(&_end, &other._end, node_less(comp));
+
+                _size += other._size;
+                other._size = 0;
+            }
+        }
+
+        void merge(IntrusiveList&& other){
+            merge(std::move(other), [](const T& val_1, const T& val_2) -> bool {return val_1 < val_2;});
+        }
+
+        void splice(const_iterator pos, IntrusiveList&& other){
+            if (&other != this && !other.empty()){
+                auto other_first = other._end._next, other_last = other._end._previous;
+
+                list_unlink_nodes(other_first, other_last);
+                list_link_nodes(other_first, other_last, pos._node);
+
+                _size += other._size;
+                other._size = 0;
+            }
+        }
+
+        void splice(const_iterator pos, IntrusiveList&& other, const_iterator it){
+            if (&other != this && !other.empty()){
+                auto other_node = it._node;
+
+                list_unlink_nodes(other_node, other_node);
+                list_link_nodes(other_node, other_node, pos._node);
+
+                ++_size;
+                --other._size;
+            }
+        }
+
+        void splice(const_iterator pos, IntrusiveList&& other, const_iterator first, const_iterator last){
+            if (&other != this && first != last){
+                auto other_first = first._node, other_last = last._node->_previous;
+                auto num_elem = MyStl::distance(first, last);
+
+                list_unlink_nodes(other_first, other_last);
+                list_link_nodes(other_first, other_last, pos._node);
+
+                _size += num_elem;
+                other._size -= num_elem;
+            }
+        }
+
+        void remove(const T& value){
+            remove_if([&](const T& x) -> bool{return x == value;});
+        }
+
+        template<class UnaryPredicate>
+        void remove_if(UnaryPredicate p){
+            iterator cur = begin();
+            while(cur != end()){
+                if (p(*cur))
+                    cur = erase(cur);
+                else
+                    ++cur;
+            }
+        }
+
+        template<class BinaryPredicate>
+        void unique(BinaryPredicate p){
+            if (empty()) return;
+
+            iterator next = begin(), cur = next;
+            ++next;
+            while(next != end()){
+                if (p(*cur, *next)){
+                    next = erase(next);
+                }else{
+                    ++cur;
+                    ++next;
+                }
+            }
+        }
+
+        void unique(){
+            unique([](const T& cur, const T& next) -> bool{return cur == next;});
+        }
+
+        void reverse() noexcept {
+            list_reverse_nodes(&_end);
+        }
+
+        void sort(){
+            sort([](const T& val1, const T& val2) -> bool{return val1 < val2;});
+        }
+
+        //the same bottom-up merge sort as List::sort
+        template<class Compare>
+        void sort(Compare comp){
+            list_sort_nodes(&_end, node_less(comp));
+        }
+
+        private:
+        /* helpers */
+        base_ptr end_node() const noexcept {return const_cast<base_ptr>(&_end);}
+
+        template<class Compare>
+        static auto node_less(Compare& comp){
+            return [&comp](base_ptr lhs, base_ptr rhs) -> bool{
+                return comp(*hook_traits::to_value(lhs), *hook_traits::to_value(rhs));
+            };
+        }
+
+        //other's nodes are linked to this sentinel, this must be empty
+        void steal(IntrusiveList& other) noexcept {
+            if (other.empty()) return;
+
+            _end._next = other._end._next;
+            _end._previous = other._end._previous;
+            _end._next->_previous = &_end;
+            _end._previous->_next = &_end;
+            _size = other._size;
+
+            other._end.set_init_status();
+            other._size = 0;
+        }
+    };
+
+    /* operators */
+    template <class T, Node_Base<T> T::*Hook>
+    bool operator==(const IntrusiveList<T, Hook>& lhs, const IntrusiveList<T, Hook>& rhs){
+        if (lhs.size() != rhs.size()) return false;
+        for (auto lit = lhs.begin(), rit = rhs.begin(); lit != lhs.end(); ++lit, ++rit){
+            if (*lit != *rit) return false;
+        }
+        return true;
+    }
+
+    template <class T, Node_Base<T> T::*Hook>
+    bool operator!=(const IntrusiveList<T, Hook>& lhs, const IntrusiveList<T, Hook>& rhs){
+        return !(lhs == rhs);
+    }
+}
+
+#endif
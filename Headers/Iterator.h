@@ -209,12 +209,12 @@ namespace MyStl{
 
             //pre
             Reverse_Iterator<Iter>& operator++(){
-                _current = _current - 1;
+                --_current;
                 return *this;
             }
 
             Reverse_Iterator<Iter>& operator--(){
-                _current = _current + 1;
+                ++_current;
                 return *this;
             }
 
@@ -5,16 +5,17 @@
 #include "Algorithm.h"
 #include <cassert>
 #include <memory>
+#include <initializer_list>
 
 namespace MyStl{
     template<typename T> struct Node;
-    template<typename T> class List;
+    template<typename T, typename Alloc = std::allocator<T>> class List;
     template<typename T> class List_Const_Iterator;
 
     template<typename T>
     struct Node_Base{
-        Node_Base<T>* _previous;
-        Node_Base<T>* _next;
+        Node_Base<T>* _previous = nullptr;
+        Node_Base<T>* _next = nullptr;
 
         Node_Base() = default;
 
@@ -40,9 +41,171 @@ namespace MyStl{
         value_type _val;
     };
 
+    /* operations on circular chains of Node_Base around a sentinel, they only touch the links and
+       are shared by List and IntrusiveList. less(lhs, rhs) compares the values of two nodes */
+
+    //take out [first, last] and re-link the rest
+    template<typename T>
+    void list_unlink_nodes(Node_Base<T>* first, Node_Base<T>* last){
+        first->_previous->_next = last->_next;
+        last->_next->_previous = first->_previous;
+    }
+
+    //add [first, last] at a specified position
+    template<typename T>
+    void list_link_nodes(Node_Base<T>* first, Node_Base<T>* last, Node_Base<T>* at){
+        first->_previous = at->_previous;
+        last->_next = at;
+        at->_previous->_next = first;
+        at->_previous = last;
+    }
+
+    template<typename T>
+    void list_reverse_nodes(Node_Base<T>* end) noexcept {
+        Node_Base<T>* cur = end->_next;
+        while(cur != end){
+            std::swap(cur->_previous, cur->_next);
+            cur = cur->_previous;
+        }
+
+        std::swap(end->_previous, end->_next);
+    }
+
+    //move all nodes of the sorted list around other_end into the sorted list around end, stable
+    template<typename T, typename NodeLess>
+    void list_merge_nodes(Node_Base<T>* end, Node_Base<T>* other_end, NodeLess less){
+        Node_Base<T>* cur = end->_next;
+        Node_Base<T>* other_cur = other_end->_next;
+
+        for (; cur != end && other_cur != other_end; cur = cur->_next){
+            if (less(other_cur, cur)){
+                // find the interval on other that fits less
+                Node_Base<T>* interval_end = other_cur->_next;
+                while(interval_end != other_end && less(interval_end, cur)){
+                    interval_end = interval_end->_next;
+                }
+                auto next_start = interval_end;
+                interval_end = interval_end->_previous;
+                //now interval_end points to the last node that less(interval_end, cur) == true
+                list_unlink_nodes(other_cur, interval_end);
+                list_link_nodes(other_cur, interval_end, cur);
+
+                other_cur = next_start;
+            }
+        }
+
+        if (other_cur != other_end){
+            auto other_last = other_end->_previous;
+            list_unlink_nodes(other_cur, other_last);
+            list_link_nodes(other_cur, other_last, end);
+        }
+    }
+
+    //merge the sorted null terminated chains first and second into first, on ties first's nodes go first
+    template<typename T, typename NodeLess>
+    void list_merge_chains(Node_Base<T>*& first, Node_Base<T>* second, NodeLess& less){
+        Node_Base<T> head;
+        Node_Base<T>* tail = &head;
+        Node_Base<T>* cur = first;
+        try{
+            while (cur && second){
+                if (less(second, cur)){
+                    tail->_next = second;
+                    second = second->_next;
+                }else{
+                    tail->_next = cur;
+                    cur = cur->_next;
+                }
+                tail = tail->_next;
+            }
+        }catch(...){
+            //no node may get lost
+            tail->_next = cur;
+            while (tail->_next) tail = tail->_next;
+            tail->_next = second;
+            first = head._next;
+            throw;
+        }
+
+        tail->_next = cur ? cur : second;
+        first = head._next;
+    }
+
+    //make the null terminated chain starting at first the whole list around end, _previous is set along the way
+    template<typename T>
+    void list_relink_chain(Node_Base<T>* end, Node_Base<T>* first){
+        Node_Base<T>* prev = end;
+        for (Node_Base<T>* cur = first; cur; cur = cur->_next){
+            prev->_next = cur;
+            cur->_previous = prev;
+            prev = cur;
+        }
+        prev->_next = end;
+        end->_previous = prev;
+    }
+
+    /* bottom-up merge sort of the list around end, the nodes are only relinked. If less throws,
+       every node is still in the list but in no particular order */
+    template<typename T, typename NodeLess>
+    void list_sort_nodes(Node_Base<T>* end, NodeLess less){
+        using base_ptr = Node_Base<T>*;
+        if (end->_next == end || end->_next->_next == end) return;
+
+        //bins[i] is empty or a sorted chain of 2^i nodes, higher bins hold earlier nodes
+        base_ptr bins[64] = {};
+        std::size_t bins_used = 0;
+        base_ptr rest = end->_next, carry = nullptr, result = nullptr;
+        end->_previous->_next = nullptr;      //chains end with a null _next from here on
+
+        try{
+            while (rest){
+                carry = rest;
+                rest = rest->_next;
+                carry->_next = nullptr;
+
+                std::size_t i = 0;
+                for (; bins[i]; ++i){
+                    base_ptr later = carry;
+                    carry = nullptr;
+                    list_merge_chains(bins[i], later, less);
+                    carry = bins[i];
+                    bins[i] = nullptr;
+                }
+                bins[i] = carry;
+                carry = nullptr;
+                if (i == bins_used) ++bins_used;
+            }
+
+            for (std::size_t i = 0; i < bins_used; ++i){
+                if (!bins[i]) continue;
+
+                base_ptr later = result;
+                result = nullptr;
+                list_merge_chains(bins[i], later, less);
+                result = bins[i];
+                bins[i] = nullptr;
+            }
+        }catch(...){
+            //put whatever chains there are back one after the other
+            base_ptr chains[67] = {rest, carry, result};
+            for (std::size_t i = 0; i < bins_used; ++i) chains[i + 3] = bins[i];
+
+            Node_Base<T> head;
+            base_ptr tail = &head;
+            for (base_ptr chain : chains){
+                tail->_next = chain;
+                while (tail->_next) tail = tail->_next;
+            }
+            list_relink_chain(end, head._next);
+            throw;
+        }
+
+        list_relink_chain(end, result);
+    }
+
     template<typename T>
     class List_Iterator: public MyStl::Iterator<Bidirectional_Iterator_Tag, T>{
-        friend class List<T>;
+        template<typename, typename> friend class List;
         friend class List_Const_Iterator<T>;
         public:
             using value_type = T;
@@ -104,7 +267,7 @@ namespace MyStl{
 
     template<typename T>
     class List_Const_Iterator: public MyStl::Iterator<Bidirectional_Iterator_Tag, T>{       //make iterator convertible to const_iterator
-        friend class List<T>;
+        template<typename, typename> friend class List;
         public:
             using value_type = T;
             using reference = const T&;
@@ -166,18 +329,18 @@ namespace MyStl{
     };
 
     /* circular doubly-linked list, maintains a pointer to the pass-the-end sentinel node */
-    template<typename T>
+    template<typename T, typename Alloc>
     class List{
         public:
         /* type defs */
             using value_type = T;
-            using allocator_type = std::allocator<T>;
+            using allocator_type = Alloc;
             using size_type = std::size_t;
             using difference_type = std::ptrdiff_t;
             using reference = value_type&;
             using const_reference = const value_type&;
-            using pointer = typename allocator_type::pointer;
-            using const_pointer = typename allocator_type::const_pointer;
+            using pointer = typename std::allocator_traits<Alloc>::pointer;
+            using const_pointer = typename std::allocator_traits<Alloc>::const_pointer;
             using iterator = List_Iterator<T>;
             using const_iterator = List_Const_Iterator<T>;
             using reverse_iterator = Reverse_Iterator<iterator>;
@@ -187,33 +350,33 @@ namespace MyStl{
             using node_ptr = Node<T>*;
             using node_type = Node<T>;
             using base_type = Node_Base<T>;
-            using base_allocator = std::allocator<base_type>;
-            using node_allocator = std::allocator<node_type>;
-
-            allocator_type inline _get_al() {return allocator_type();}
-            base_allocator inline _get_base_al(){return base_allocator();}
-            node_allocator inline _get_node_al() {return node_allocator();}
+            using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<node_type>;
 
         private:
+            using node_traits = std::allocator_traits<node_allocator>;
+
+            node_allocator _node_al;    //every node, including the sentinel, comes from here
             base_ptr _end;  //pass-the-end sentinel node
             size_type _size;
 
         public:
         /* ctor and dtor */
-        List(): _end(_get_node_al().allocate(1)), _size(0){
-            _end->set_init_status();
+        List(): List(Alloc()){}
+
+        explicit List(const Alloc& al): _node_al(al), _size(0){
+            init_end_node();
         }
 
-        List(size_type count, const T& value){
+        List(size_type count, const T& value, const Alloc& al = Alloc()): _node_al(al){
             fill_init_n(count, value);
         }
 
-        explicit List(size_type count){
+        explicit List(size_type count, const Alloc& al = Alloc()): _node_al(al){
             fill_init_n(count, value_type());
         }
 
         template<class InputIt,typename std::enable_if<MyStl::Is_Input_Iterator<InputIt>::value, bool>::type = true> 
-        List(InputIt first, InputIt last){
+        List(InputIt first, InputIt last, const Alloc& al = Alloc()): _node_al(al){
             _size = MyStl::distance(first, last);
 
             try{
@@ -224,30 +387,47 @@ namespace MyStl{
                 }
             }catch(...){
                 tidy();
-                _get_base_al().deallocate(_end, 1);     //node_base only has pointers as member variables, so memory can be directly released
-                _end = nullptr;
+                free_end_node();
                 throw;
             }
         }
 
-        List(const List& other): List(other.begin(), other.end()){}
+        List(const List& other)
+            : List(other.begin(), other.end(), node_traits::select_on_container_copy_construction(other._node_al)){}
 
-        List(List&& other): _size(other._size), _end(other._end){
+        List(const List& other, const Alloc& al): List(other.begin(), other.end(), al){}
+
+        List(List&& other): _node_al(std::move(other._node_al)), _end(other._end), _size(other._size){
             other._size = 0;
             other._end = nullptr;
         }
 
-        List(std::initializer_list<T> init): List(init.begin(), init.end()){}
+        List(List&& other, const Alloc& al): _node_al(al), _size(0){
+            if (_node_al == other._node_al){
+                steal(other);
+            }else{
+                // nodes of other can't be released by al, so elements have to be moved one by one
+                init_end_node();
+                for (auto i = other.begin(); i != other.end(); ++i){
+                    emplace_back(std::move(*i));
+                }
+            }
+        }
+
+        List(std::initializer_list<T> init, const Alloc& al = Alloc()): List(init.begin(), init.end(), al){}
 
         ~List(){
             tidy();
-            _get_base_al().deallocate(_end, 1);
-            _end = nullptr;
+            free_end_node();
             _size = 0;
         }
 
         List& operator=(const List& other){
             if (this != &other){
+                // the sentinel has to be given back as well before a different allocator takes over
+                MyStl::alloc_on_copy(_node_al, other._node_al, [this](){tidy(); free_end_node();});
+                if (!_end) init_end_node();
+
                 copy(other.begin(), other.end());
             }
 
@@ -255,8 +435,11 @@ namespace MyStl{
         }
 
         List& operator=(List&& other){
-            List<T> temp(std::move(other));
-            swap(temp);
+            if (this != &other){
+                move_assign(other, typename node_traits::propagate_on_container_move_assignment());
+            }
+
+            return *this;
         }
 
         List& operator=(std::initializer_list<T> init){
@@ -336,7 +519,10 @@ namespace MyStl{
             tidy();
         }
 
+        allocator_type get_allocator() const noexcept {return allocator_type(_node_al);}
+
         void swap(List& other){
+            MyStl::alloc_on_swap(_node_al, other._node_al);
             std::swap(_size, other._size);
             std::swap(_end, other._end);
         }
@@ -525,37 +711,14 @@ namespace MyStl{
 
         public:
         /* operations */
+        //merge and splice relink other's nodes into this list, so the two allocators must compare equal
         template <class Compare> 
         void merge(List&& other, Compare comp){
+            assert(_node_al == other._node_al);
             if (&other != this){
-                base_ptr cur = _end->_next, other_cur = other._end->_next;
-
-                for (; cur != _end && other_cur != other._end; cur = cur->_next){
-                    if (comp(other_cur->as_node()->_val, cur->as_node()->_val)){
-                        // find the interval on other that fits comp
-                        base_ptr interval_end = other_cur->_next;
-                        const_reference val = cur->as_node()->_val;
-
-                        while(interval_end != other._end && comp(interval_end->as_node()->_val, val)){
-                            interval_end = interval_end->_next;
-                        }
-                        auto next_start = interval_end;
-                        interval_end = interval_end->_previous;
-                        //now interval_end points to the last node that comp(interval_end->as_node()->_val, val) == true
-                        other.take_out_nodes(other_cur, interval_end);
-                        this->link_nodes_at(other_cur, interval_end, cur);
-
-                        other_cur = next_start;
-                    }else{
-                        continue;
-                    }
-                }
-                
-                if (other_cur != other._end){
-                    auto other_last = other._end->_previous;
-                    other.take_out_nodes(other_cur, other_last);
-                    this->link_nodes_at(other_cur, other_last, this->_end);
-                }
+                list_merge_nodes(_end, other._end, [&comp](base_ptr lhs, base_ptr rhs) -> bool{
+                    return comp(lhs->as_node()->_val, rhs->as_node()->_val);
+                });
 
                 this->_size += other._size;
                 other._size = 0;
@@ -567,6 +730,7 @@ namespace MyStl{
         }
 
         void splice(const_iterator pos, List&& other){
+            assert(_node_al == other._node_al);
             if (&other != this && !other.empty()){
                 auto other_first = other._end->_next, other_last = other._end->_previous;
 
@@ -579,6 +743,7 @@ namespace MyStl{
         }
 
         void splice(const_iterator pos, List&& other, const_iterator it){
+            assert(_node_al == other._node_al);
             if (&other != this && !other.empty()){
                 auto other_node = it._node;
 
@@ -591,6 +756,7 @@ namespace MyStl{
         }
 
         void splice(const_iterator pos, List&& other, const_iterator first, const_iterator last){
+            assert(_node_al == other._node_al);
             if (&other != this && !other.empty()){
                 auto other_first = first._node, other_last = last._node->_previous;
                 auto num_elem = MyStl::distance(first, last);
@@ -637,83 +803,64 @@ namespace MyStl{
         }
 
         void reverse() noexcept {
-            if(!empty() && _size != 1){
-                base_ptr cur = _end->_next;
-                while(cur != _end){
-                    std::swap(cur->_previous, cur->_next);
-                    cur = cur->_previous;
-                }
-
-                std::swap(_end->_previous, _end->_next);
-            }
+            list_reverse_nodes(_end);
         }
 
         void sort(){
-            merge_sort(begin(), end(), _size, [](const T& val1, const T& val2) -> bool{return val1 < val2;});
+            sort([](const T& val1, const T& val2) -> bool{return val1 < val2;});
         }
 
-        //recursive merge sort
+        /* bottom-up merge sort that only relinks nodes, stable, no recursion and no allocation.
+           If comp throws, every element is still in the list but in no particular order */
         template<class Compare>
         void sort(Compare comp){
-            merge_sort(begin(), end(), _size, comp);
+            if (_size < 2) return;
+
+            list_sort_nodes(_end, [&comp](base_ptr lhs, base_ptr rhs) -> bool{
+                return comp(lhs->as_node()->_val, rhs->as_node()->_val);
+            });
         }
 
         private:
         /* helpers */
-        //recursively merge sort [first, last)
-        template<typename Compare>
-        iterator merge_sort(iterator first, iterator last, size_type size, Compare comp){
-            if (size == 1) return first;
-            else if (size == 2){
-                if (comp(*(--last), *first))
-                    swap_nodes(first._node, last._node);
-                    return last;
-                return first;
-            }else{
-                auto half_size = size / 2;
-                iterator first_2 = first;
-                MyStl::advance(first_2, half_size);
-                first = merge_sort(first, first_2, half_size, comp);
-                first_2 = merge_sort(first_2, last, size - half_size, comp);
-
-                iterator last_1 = first_2;
-                //the smallest node is either first or first_2
-                iterator ret = comp(*first, *first_2) ? first : first_2;
-
-                //merge
-                for (;first != last_1 && first_2 != last; ++first){
-                    if(comp(*first_2, *first)){
-                        iterator interval_end = first_2;
-                        ++interval_end;
-
-                        while(interval_end != last && comp(*interval_end, *first)){
-                            ++interval_end;
-                        }
-                        auto next_start = interval_end;
-                        --interval_end;
-
-                        take_out_nodes(first_2._node, interval_end._node);
-                        link_nodes_at(first_2._node, interval_end._node, first._node);
-
-                        first_2 = next_start;
-                    }else{
-                        continue;
-                    }
-                }
+        //the sentinel is a node whose value is never constructed
+        void init_end_node(){
+            _end = node_traits::allocate(_node_al, 1);
+            _end->set_init_status();
+        }
 
-                return ret;
+        void free_end_node(){
+            if (_end){
+                node_traits::deallocate(_node_al, _end->as_node(), 1);
+                _end = nullptr;
             }
         }
 
-        //swap two consecutive nodes by pointer manipulations, no invalidations of iterators and/or references
-        void swap_nodes(base_ptr node1, base_ptr node2){
-            take_out_nodes(node2, node2);
-            link_nodes_at(node2, node2, node1);
+        void steal(List& other) noexcept {
+            _end = other._end;
+            _size = other._size;
+            other._end = nullptr;
+            other._size = 0;
         }
 
-        void init_end_node(){
-            _end = _get_node_al().allocate(1);
-            _end->set_init_status();
+        void move_assign(List& other, std::true_type){
+            tidy();
+            free_end_node();
+            _node_al = std::move(other._node_al);
+            steal(other);
+        }
+
+        void move_assign(List& other, std::false_type){
+            if (_node_al == other._node_al){
+                tidy();
+                free_end_node();
+                steal(other);
+            }else{
+                tidy();
+                for (auto i = other.begin(); i != other.end(); ++i){
+                    emplace_back(std::move(*i));
+                }
+            }
         }
 
         void fill_init_n(size_type count, const value_type& value){
@@ -725,8 +872,7 @@ namespace MyStl{
                 }
             }catch(...){
                 tidy();
-                _get_base_al().deallocate(_end, 1);     //node_base only has pointers as member variables, so memory can be directly released
-                _end = nullptr;
+                free_end_node();
                 throw;
             }
             _size = count;
@@ -735,11 +881,11 @@ namespace MyStl{
         template <typename... Args>
         node_ptr create_node(base_ptr at, Args&&...args){
             node_ptr p_node = nullptr;
+            p_node = node_traits::allocate(_node_al, 1);
             try{
-                p_node = _get_node_al().allocate(1);
-                _get_node_al().construct(p_node, std::forward<Args>(args)...);
+                node_traits::construct(_node_al, std::addressof(p_node->_val), std::forward<Args>(args)...);
             }catch(...){
-                _get_node_al().deallocate(p_node, 1);
+                node_traits::deallocate(_node_al, p_node, 1);
                 throw;
             }
             
@@ -785,28 +931,22 @@ namespace MyStl{
         }
 
         void delete_node(node_ptr node){
-            _get_al().destroy(&(node->_val));       //has to use address of _val to call its dtor
-            _get_node_al().deallocate(node, 1);
+            node_traits::destroy(_node_al, std::addressof(node->_val));       //has to use address of _val to call its dtor
+            node_traits::deallocate(_node_al, node, 1);
         }
 
-        //take out [first, last] and re-link the rest
         void take_out_nodes(base_ptr first, base_ptr last){
-            first->_previous->_next = last->_next;
-            last->_next->_previous = first->_previous;
+            list_unlink_nodes(first, last);
         }
 
-        //add [first, last] at a specified position
         void link_nodes_at(base_ptr first, base_ptr last, base_ptr at){
-            first->_previous = at->_previous;
-            last->_next = at;
-            at->_previous->_next = first;
-            at->_previous = last;
+            list_link_nodes(first, last, at);
         }
     };
 
     /* operators */
-    template<class T>
-    bool operator==(const List<T>& lhs, const List<T>& rhs){
+    template <class T, class Alloc>
+    bool operator==(const List<T, Alloc>& lhs, const List<T, Alloc>& rhs){
         if (lhs.size() != rhs.size()) return false;
         for (auto lit = lhs.begin(), rit = rhs.begin(); 
             lit != lhs.end(); 
@@ -815,28 +955,28 @@ namespace MyStl{
         }
         return true;
     }
-    template <class T>
-    bool operator<(const List<T>& lhs, const List<T>& rhs){
+    template <class T, class Alloc>
+    bool operator<(const List<T, Alloc>& lhs, const List<T, Alloc>& rhs){
         return MyStl::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
     }
 
-    template <class T>
-    bool operator!=(const List<T>& lhs, const List<T>& rhs){
+    template <class T, class Alloc>
+    bool operator!=(const List<T, Alloc>& lhs, const List<T, Alloc>& rhs){
         return !(lhs == rhs);
     }
 
-    template <class T>
-    bool operator>(const List<T>& lhs, const List<T>& rhs){
+    template <class T, class Alloc>
+    bool operator>(const List<T, Alloc>& lhs, const List<T, Alloc>& rhs){
         return rhs < lhs;
     }
 
-    template <class T>
-    bool operator<=(const List<T>& lhs, const List<T>& rhs){
+    template <class T, class Alloc>
+    bool operator<=(const List<T, Alloc>& lhs, const List<T, Alloc>& rhs){
         return !(rhs < lhs);
     }
 
-    template <class T>
-    bool operator>=(const List<T>& lhs, const List<T>& rhs){
+    template <class T, class Alloc>
+    bool operator>=(const List<T, Alloc>& lhs, const List<T, Alloc>& rhs){
         return !(lhs < rhs);
     }
 }
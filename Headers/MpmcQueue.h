@@ -0,0 +1,295 @@
+#ifndef MYSTL_MPMCQUEUE_H
+#define MYSTL_MPMCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "Deque.h"
+#include "Vector.h"
+
+// indices written by different threads are kept this many bytes apart so they don't share a cache line
+#ifndef MYSTL_CACHE_LINE_SIZE
+#define MYSTL_CACHE_LINE_SIZE 64
+#endif
+
+namespace MyStl{
+    /* unbounded queue for any number of producer and consumer threads. Like Deque the elements live
+       in fixed blocks of about BlockBytes, but since a shared map can't be grown without a lock the
+       blocks are chained through next pointers instead. Within a block, producers and consumers
+       each take a slot with one fetch_add on the block's counters, so threads only contend on a
+       shared pointer when a block fills up or runs out.
+
+       A consumer that gets to a slot before its producer marks it dead, and the producer
+       takes another one, so neither waits for the other; a consumer only waits for a producer
+       that is in the middle of constructing the element. Used up blocks are freed through hazard
+       pointers: every thread that touches the queue gets a record of its own, kept until the queue
+       is destroyed, which holds the block it is working on and the blocks it has retired */
+    template <typename T, typename Alloc = std::allocator<T>, std::size_t BlockBytes = 4096>
+    class MpmcQueue{
+        public:
+            using value_type = T;
+            using allocator_type = Alloc;
+            using size_type = std::size_t;
+            using reference = value_type&;
+            using const_reference = const value_type&;
+
+        private:
+            enum Slot_State : unsigned char {
+                SLOT_EMPTY,         // nobody came yet
+                SLOT_WRITING,       // a producer is constructing the element
+                SLOT_READY,         // holds an element
+                SLOT_DEAD           // taken, skipped by a consumer that came first, or the constructor threw
+            };
+
+            struct Slot{
+                std::atomic<unsigned char> state{SLOT_EMPTY};
+                alignas(T) unsigned char storage[sizeof(T)];
+
+                T* value() noexcept {return reinterpret_cast<T*>(storage);}
+            };
+
+        public:
+            static constexpr size_type block_size = Deque_Block_Size<Slot, BlockBytes>::value;
+
+        private:
+            struct Block{
+                alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<size_type> enq_index{0};
+                alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<size_type> deq_index{0};
+                alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<Block*> next{nullptr};
+                Slot slots[block_size];
+            };
+
+            struct Hazard_Record{
+                std::atomic<Block*> hazard{nullptr};         // the block this thread may be reading
+                std::atomic<std::thread::id> owner{};
+                Hazard_Record* next = nullptr;               // never changes once the record is published
+                MyStl::Vector<Block*> retired;                // only touched by the owner
+                Block* spare = nullptr;                      // a freed block kept for the next one needed
+            };
+
+            using block_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Block>;
+            using block_traits = std::allocator_traits<block_allocator>;
+
+            alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<Block*> _head{nullptr};
+            alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<Block*> _tail{nullptr};
+            alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<Hazard_Record*> _records{nullptr};
+            std::atomic<size_type> _record_count{0};
+            const std::uint64_t _serial;
+            block_allocator _alloc;
+
+        public:
+            /* ctors and dtor */
+            explicit MpmcQueue(const Alloc& alloc = Alloc()): _serial(next_serial()), _alloc(alloc){
+                Block* first = create_block();
+                _head.store(first, std::memory_order_relaxed);
+                _tail.store(first, std::memory_order_relaxed);
+            }
+
+            MpmcQueue(const MpmcQueue&) = delete;
+
+            MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+            // no other thread may use the queue any more
+            ~MpmcQueue(){
+                for (Block* block = _head.load(std::memory_order_relaxed); block; ){
+                    Block* next = block->next.load(std::memory_order_relaxed);
+                    for (Slot& slot : block->slots){
+                        if (slot.state.load(std::memory_order_relaxed) == SLOT_READY) slot.value()->~T();
+                    }
+                    destroy_block(block);
+                    block = next;
+                }
+
+                for (Hazard_Record* rec = _records.load(std::memory_order_relaxed); rec; ){
+                    Hazard_Record* next = rec->next;
+                    for (Block* block : rec->retired) destroy_block(block);
+                    if (rec->spare) destroy_block(rec->spare);
+                    delete rec;
+                    rec = next;
+                }
+            }
+
+        public:
+            /* producers, never fail short of running out of memory */
+            void push(const value_type& value){emplace(value);}
+
+            void push(value_type&& value){emplace(std::move(value));}
+
+            template <typename... Args>
+            void emplace(Args&&... args){
+                Hazard_Record* rec = record();
+                while (true){
+                    Block* tail = protect(rec, _tail);
+                    size_type index = tail->enq_index.fetch_add(1);
+                    if (index < block_size){
+                        Slot& slot = tail->slots[index];
+                        unsigned char expected = SLOT_EMPTY;
+                        if (!slot.state.compare_exchange_strong(expected, SLOT_WRITING, std::memory_order_acquire)) continue;
+
+                        try {
+                            ::new (static_cast<void*>(slot.value())) T(std::forward<Args>(args)...);
+                        } catch (...) {
+                            slot.state.store(SLOT_DEAD, std::memory_order_release);
+                            rec->hazard.store(nullptr, std::memory_order_release);
+                            throw;
+                        }
+
+                        slot.state.store(SLOT_READY, std::memory_order_release);
+                        rec->hazard.store(nullptr, std::memory_order_release);
+                        return;
+                    }
+
+                    // the block is full, append one unless another producer already did
+                    Block* next = tail->next.load(std::memory_order_acquire);
+                    if (next == nullptr){
+                        Block* fresh = rec->spare ? rec->spare : create_block();
+                        rec->spare = nullptr;
+                        if (tail->next.compare_exchange_strong(next, fresh)) next = fresh;
+                        else rec->spare = fresh;
+                    }
+                    _tail.compare_exchange_strong(tail, next);
+                }
+            }
+
+        public:
+            /* consumers, returns false and leaves value alone when the queue looked empty */
+            bool try_pop(value_type& value){
+                Hazard_Record* rec = record();
+                while (true){
+                    Block* head = protect(rec, _head);
+                    if (head->deq_index.load() >= head->enq_index.load()
+                        && head->next.load(std::memory_order_acquire) == nullptr) break;
+
+                    size_type index = head->deq_index.fetch_add(1);
+                    if (index < block_size){
+                        Slot& slot = head->slots[index];
+                        unsigned char state = SLOT_EMPTY;
+                        // the producer of this slot hasn't arrived yet, it will take another one
+                        if (slot.state.compare_exchange_strong(state, SLOT_DEAD, std::memory_order_acquire)) continue;
+
+                        while (state == SLOT_WRITING){
+                            std::this_thread::yield();
+                            state = slot.state.load(std::memory_order_acquire);
+                        }
+                        if (state != SLOT_READY) continue;
+
+                        value = std::move(*slot.value());
+                        slot.value()->~T();
+                        slot.state.store(SLOT_DEAD, std::memory_order_relaxed);
+                        rec->hazard.store(nullptr, std::memory_order_release);
+                        return true;
+                    }
+
+                    // the block is used up, move on if there is a next one
+                    Block* next = head->next.load(std::memory_order_acquire);
+                    if (next == nullptr) break;
+
+                    // the tail must never point to a retired block
+                    Block* tail = head;
+                    _tail.compare_exchange_strong(tail, next);
+                    if (_head.compare_exchange_strong(head, next)){
+                        rec->hazard.store(nullptr, std::memory_order_release);
+                        retire(rec, head);
+                    }
+                }
+
+                rec->hazard.store(nullptr, std::memory_order_release);
+                return false;
+            }
+
+        private:
+            static std::uint64_t next_serial(){
+                static std::atomic<std::uint64_t> counter{0};
+                return ++counter;
+            }
+
+            Block* create_block(){
+                Block* block = block_traits::allocate(_alloc, 1);
+                ::new (static_cast<void*>(block)) Block();
+                return block;
+            }
+
+            // the elements must be gone already
+            void destroy_block(Block* block){
+                block->~Block();
+                block_traits::deallocate(_alloc, block, 1);
+            }
+
+            /* the calling thread's record, looked up once per thread and queue. A thread id can be
+               reused after its thread ended, the new thread then simply takes over the old record */
+            Hazard_Record* record(){
+                thread_local std::uint64_t cached_serial = 0;
+                thread_local Hazard_Record* cached_record = nullptr;
+                if (cached_serial == _serial) return cached_record;
+
+                std::thread::id self = std::this_thread::get_id();
+                Hazard_Record* rec = _records.load(std::memory_order_acquire);
+                for (; rec; rec = rec->next){
+                    if (rec->owner.load(std::memory_order_relaxed) == self) break;
+                }
+
+                if (!rec){
+                    rec = new Hazard_Record();
+                    rec->owner.store(self, std::memory_order_relaxed);
+                    rec->next = _records.load(std::memory_order_relaxed);
+                    while (!_records.compare_exchange_weak(rec->next, rec, std::memory_order_release,
+                                                           std::memory_order_relaxed)) {}
+                    _record_count.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                cached_serial = _serial;
+                cached_record = rec;
+                return rec;
+            }
+
+            // publishes the block src points to as in use, and makes sure it was still there afterwards
+            static Block* protect(Hazard_Record* rec, const std::atomic<Block*>& src){
+                Block* block = src.load();
+                while (true){
+                    rec->hazard.store(block);
+                    Block* again = src.load();
+                    if (again == block) return block;
+                    block = again;
+                }
+            }
+
+            /* block is no longer reachable from _head or _tail, it's freed once no record points to
+               it. The scan is only done every few blocks, how many grows with the number of threads */
+            void retire(Hazard_Record* rec, Block* block){
+                rec->retired.push_back(block);
+                if (rec->retired.size() < 2 * _record_count.load(std::memory_order_relaxed) + 4) return;
+
+                MyStl::Vector<Block*> in_use;
+                for (Hazard_Record* other = _records.load(std::memory_order_acquire); other; other = other->next){
+                    Block* hazard = other->hazard.load();
+                    if (hazard) in_use.push_back(hazard);
+                }
+
+                size_type kept = 0;
+                for (size_type i = 0; i < rec->retired.size(); ++i){
+                    Block* old = rec->retired[i];
+                    bool used = false;
+                    for (Block* hazard : in_use) used = used || hazard == old;
+
+                    if (used) rec->retired[kept++] = old;
+                    else if (!rec->spare) rec->spare = reset_block(old);
+                    else destroy_block(old);
+                }
+                rec->retired.erase(rec->retired.begin() + kept, rec->retired.end());
+            }
+
+            Block* reset_block(Block* block){
+                block->~Block();
+                ::new (static_cast<void*>(block)) Block();
+                return block;
+            }
+    };
+}
+
+#endif
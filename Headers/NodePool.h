@@ -0,0 +1,213 @@
+#ifndef MYSTL_NODEPOOL_H
+#define MYSTL_NODEPOOL_H
+
+#include <assert.h>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace MyStl{
+    /* hands out fixed-size blocks carved from slabs of NodesPerSlab blocks,
+       freed blocks are kept in an intrusive free list and reused before a new slab is requested,
+       slabs are only given back to the system when the pool is destroyed */
+    class Slab_Pool{
+        private:
+            struct Free_Block{
+                Free_Block* _next;
+            };
+
+            struct Slab_Header{
+                Slab_Header* _next;
+            };
+
+            static constexpr std::size_t header_size =
+                (sizeof(Slab_Header) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+            std::size_t _block_size;
+            std::size_t _blocks_per_slab;
+            Free_Block* _free_list;
+            Slab_Header* _slabs;
+            char* _bump;        //next never used block in the newest slab
+            char* _bump_end;
+
+        public:
+            Slab_Pool(std::size_t block_size, std::size_t blocks_per_slab)
+                : _block_size(round_up(block_size < sizeof(Free_Block) ? sizeof(Free_Block) : block_size)),
+                  _blocks_per_slab(blocks_per_slab), _free_list(nullptr), _slabs(nullptr),
+                  _bump(nullptr), _bump_end(nullptr){}
+
+            Slab_Pool(const Slab_Pool&) = delete;
+
+            Slab_Pool& operator=(const Slab_Pool&) = delete;
+
+            ~Slab_Pool(){
+                while (_slabs){
+                    Slab_Header* next = _slabs->_next;
+                    ::operator delete(static_cast<void*>(_slabs));
+                    _slabs = next;
+                }
+            }
+
+            void* allocate(){
+                if (_free_list){
+                    Free_Block* block = _free_list;
+                    _free_list = block->_next;
+                    return block;
+                }
+
+                if (_bump == _bump_end) add_slab();
+
+                void* block = _bump;
+                _bump += _block_size;
+                return block;
+            }
+
+            void deallocate(void* p) noexcept {
+                Free_Block* block = static_cast<Free_Block*>(p);
+                block->_next = _free_list;
+                _free_list = block;
+            }
+
+            std::size_t block_size() const noexcept {return _block_size;}
+
+        private:
+            static std::size_t round_up(std::size_t n){
+                return (n + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+            }
+
+            void add_slab(){
+                char* raw = static_cast<char*>(::operator new(header_size + _block_size * _blocks_per_slab));
+                Slab_Header* slab = reinterpret_cast<Slab_Header*>(raw);
+                slab->_next = _slabs;
+                _slabs = slab;
+
+                _bump = raw + header_size;
+                _bump_end = _bump + _block_size * _blocks_per_slab;
+            }
+    };
+
+    /* the Slab_Pools of an allocator and all its rebound copies, one for each node size asked for */
+    class Slab_Pool_Set{
+        private:
+            struct Entry{
+                Slab_Pool _pool;
+                std::size_t _size;
+                Entry* _next;
+
+                Entry(std::size_t size, std::size_t blocks_per_slab, Entry* next)
+                    : _pool(size, blocks_per_slab), _size(size), _next(next){}
+            };
+
+            std::size_t _blocks_per_slab;
+            Entry* _entries;
+
+        public:
+            explicit Slab_Pool_Set(std::size_t blocks_per_slab) noexcept
+                : _blocks_per_slab(blocks_per_slab), _entries(nullptr){}
+
+            Slab_Pool_Set(const Slab_Pool_Set&) = delete;
+
+            Slab_Pool_Set& operator=(const Slab_Pool_Set&) = delete;
+
+            ~Slab_Pool_Set(){
+                while (_entries){
+                    Entry* next = _entries->_next;
+                    delete _entries;
+                    _entries = next;
+                }
+            }
+
+            // the pool for blocks of size bytes, nullptr if there is none yet
+            Slab_Pool* find(std::size_t size) const noexcept {
+                for (Entry* entry = _entries; entry; entry = entry->_next){
+                    if (entry->_size == size) return &entry->_pool;
+                }
+                return nullptr;
+            }
+
+            Slab_Pool& get(std::size_t size){
+                if (Slab_Pool* pool = find(size)) return *pool;
+
+                _entries = new Entry(size, _blocks_per_slab, _entries);
+                return _entries->_pool;
+            }
+    };
+
+    /* allocator for node based containers (List, _RB_tree and set), single node requests
+       are served by a Slab_Pool, anything else goes to ::operator new.
+       A default constructed allocator owns a new Slab_Pool_Set, which its copies and rebound
+       copies share, so every container ends up with its own pools that live as long as the
+       container does, and two allocators compare equal exactly when one can free the other's nodes.
+       Separately constructed pools can't exchange nodes, so lists that splice or merge into each
+       other have to be built on one allocator, e.g. List<T, NodePool<T>> l_2(l_1.get_allocator()).
+       Like the containers, a pool must not be used from several threads at once. */
+    template <typename T, std::size_t N = 64>
+    class NodePool{
+        template <typename, std::size_t> friend class NodePool;
+
+        static_assert(N > 0, "a slab must hold at least one node");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+
+        public:
+            using value_type = T;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+
+            // nodes stay with the pool that created them, so the pool travels along on move and swap
+            using propagate_on_container_copy_assignment = std::false_type;
+            using propagate_on_container_move_assignment = std::true_type;
+            using propagate_on_container_swap = std::true_type;
+
+            template <typename U>
+            struct rebind{
+                using other = NodePool<U, N>;
+            };
+
+            static constexpr std::size_t nodes_per_slab = N;
+
+        private:
+            std::shared_ptr<Slab_Pool_Set> _pools;
+            Slab_Pool* _pool;   //the one for sizeof(T) out of _pools, looked up on first use
+
+        public:
+            NodePool() : _pools(std::make_shared<Slab_Pool_Set>(N)), _pool(nullptr){}
+
+            NodePool(const NodePool& other) noexcept = default;
+
+            template <typename U>
+            NodePool(const NodePool<U, N>& other) noexcept : _pools(other._pools), _pool(nullptr){}
+
+            NodePool& operator=(const NodePool& other) noexcept = default;
+
+            T* allocate(size_type n){
+                if (n != 1) return static_cast<T*>(::operator new(n * sizeof(T)));
+
+                if (!_pool) _pool = &_pools->get(sizeof(T));
+                return static_cast<T*>(_pool->allocate());
+            }
+
+            void deallocate(T* p, size_type n) noexcept {
+                if (n != 1){
+                    ::operator delete(static_cast<void*>(p));
+                    return;
+                }
+
+                // p came from an equal allocator, which made the pool already
+                if (!_pool) _pool = _pools->find(sizeof(T));
+                assert(_pool && "deallocating a node that no equal NodePool allocated");
+                _pool->deallocate(p);
+            }
+
+            // a copied container gets a fresh pool rather than sharing the source's one
+            NodePool select_on_container_copy_construction() const {return NodePool();}
+
+            template <typename U>
+            bool operator==(const NodePool<U, N>& other) const noexcept {return _pools == other._pools;}
+
+            template <typename U>
+            bool operator!=(const NodePool<U, N>& other) const noexcept {return !(*this == other);}
+    };
+}
+
+#endif
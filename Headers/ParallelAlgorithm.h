@@ -0,0 +1,200 @@
+#ifndef MYSTL_PARALLELALGORITHM_H
+#define MYSTL_PARALLELALGORITHM_H
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "Algorithm.h"
+#include "Iterator.h"
+#include "ThreadPool.h"
+#include "Vector.h"
+
+// below this many elements per task, handing the task to another thread costs more than it saves
+#ifndef MYSTL_PARALLEL_MIN_CHUNK
+#define MYSTL_PARALLEL_MIN_CHUNK (1 << 14)
+#endif
+
+namespace MyStl{
+    /* overloads of for_each, fill, copy, equal and copy_if taking an execution policy first. With par or
+       par_unseq and random access iterators, e.g. those of Vector, Array and Deque, the range is cut into
+       a few pieces per thread of Thread_Pool::default_pool() and each piece goes through the sequential
+       algorithm, so a Deque is still walked per block. Anything else, and ranges too short to be worth
+       it, run sequentially on the calling thread. Unlike std the element functions may throw, the
+       first exception is passed on to the caller once all pieces have stopped */
+    namespace execution{
+        struct sequenced_policy {};
+        struct parallel_policy {};
+        struct parallel_unsequenced_policy {};
+
+        constexpr sequenced_policy seq{};
+        constexpr parallel_policy par{};
+        constexpr parallel_unsequenced_policy par_unseq{};
+    }
+
+    template <typename T>
+    struct Is_Execution_Policy : std::false_type {};
+
+    template <>
+    struct Is_Execution_Policy<execution::sequenced_policy> : std::true_type {};
+
+    template <>
+    struct Is_Execution_Policy<execution::parallel_policy> : std::true_type {};
+
+    template <>
+    struct Is_Execution_Policy<execution::parallel_unsequenced_policy> : std::true_type {};
+
+    // whether a call with this policy and these iterators can be split up
+    template <typename Policy, typename... Iters>
+    struct Is_Parallel_Call : std::integral_constant<bool,
+        !std::is_same<typename std::decay<Policy>::type, execution::sequenced_policy>::value> {};
+
+    template <typename Policy, typename Iter, typename... Iters>
+    struct Is_Parallel_Call<Policy, Iter, Iters...> : std::integral_constant<bool,
+        Is_Random_Access_Iterator<Iter>::value && Is_Parallel_Call<Policy, Iters...>::value> {};
+
+    // a few tasks per thread so the others can make up for one that runs slow, 0 or 1 means not worth it
+    inline std::size_t parallel_task_count(std::size_t n){
+        std::size_t most = Thread_Pool::default_pool().concurrency() * 4;
+        std::size_t tasks = n / MYSTL_PARALLEL_MIN_CHUNK;
+        return tasks < most ? tasks : most;
+    }
+
+    // calls func(begin, end, task) for each of tasks about equal pieces [begin, end) of [0, n)
+    template <typename F>
+    void parallel_pieces(std::size_t n, std::size_t tasks, F func){
+        auto task = [n, tasks, &func](std::size_t i){func(n * i / tasks, n * (i + 1) / tasks, i);};
+        Thread_Pool::default_pool().run(tasks, task);
+    }
+
+    template <typename InputIt, typename F>
+    void for_each_parallel(InputIt first, InputIt last, F& func, std::false_type){
+        MyStl::for_each(first, last, func);
+    }
+
+    template <typename RandomIt, typename F>
+    void for_each_parallel(RandomIt first, RandomIt last, F& func, std::true_type){
+        std::size_t n = last - first, tasks = parallel_task_count(n);
+        if (tasks < 2) return for_each_parallel(first, last, func, std::false_type());
+
+        parallel_pieces(n, tasks, [first, &func](std::size_t begin, std::size_t end, std::size_t){
+            MyStl::for_each(first + begin, first + end, func);
+        });
+    }
+
+    // each piece calls its own copy of func
+    template <typename Policy, typename InputIt, typename F,
+              typename std::enable_if<Is_Execution_Policy<typename std::decay<Policy>::type>::value, bool>::type = true>
+    void for_each(Policy&&, InputIt first, InputIt last, F func){
+        for_each_parallel(first, last, func, Is_Parallel_Call<Policy, InputIt>());
+    }
+
+    template <typename ForwardIt, typename T>
+    void fill_parallel(ForwardIt first, ForwardIt last, const T& value, std::false_type){
+        MyStl::fill(first, last, value);
+    }
+
+    template <typename RandomIt, typename T>
+    void fill_parallel(RandomIt first, RandomIt last, const T& value, std::true_type){
+        std::size_t n = last - first, tasks = parallel_task_count(n);
+        if (tasks < 2) return fill_parallel(first, last, value, std::false_type());
+
+        parallel_pieces(n, tasks, [first, &value](std::size_t begin, std::size_t end, std::size_t){
+            MyStl::fill(first + begin, first + end, value);
+        });
+    }
+
+    template <typename Policy, typename ForwardIt, typename T,
+              typename std::enable_if<Is_Execution_Policy<typename std::decay<Policy>::type>::value, bool>::type = true>
+    void fill(Policy&&, ForwardIt first, ForwardIt last, const T& value){
+        fill_parallel(first, last, value, Is_Parallel_Call<Policy, ForwardIt>());
+    }
+
+    template <typename InputIt, typename OutputIt>
+    OutputIt copy_parallel(InputIt first, InputIt last, OutputIt d_first, std::false_type){
+        return MyStl::copy(first, last, d_first);
+    }
+
+    template <typename RandomIt1, typename RandomIt2>
+    RandomIt2 copy_parallel(RandomIt1 first, RandomIt1 last, RandomIt2 d_first, std::true_type){
+        std::size_t n = last - first, tasks = parallel_task_count(n);
+        if (tasks < 2) return copy_parallel(first, last, d_first, std::false_type());
+
+        parallel_pieces(n, tasks, [first, d_first](std::size_t begin, std::size_t end, std::size_t){
+            MyStl::copy(first + begin, first + end, d_first + begin);
+        });
+        return d_first + n;
+    }
+
+    // the ranges may not overlap
+    template <typename Policy, typename InputIt, typename OutputIt,
+              typename std::enable_if<Is_Execution_Policy<typename std::decay<Policy>::type>::value, bool>::type = true>
+    OutputIt copy(Policy&&, InputIt first, InputIt last, OutputIt d_first){
+        return copy_parallel(first, last, d_first, Is_Parallel_Call<Policy, InputIt, OutputIt>());
+    }
+
+    template <typename InputIt1, typename InputIt2>
+    bool equal_parallel(InputIt1 first1, InputIt1 last1, InputIt2 first2, std::false_type){
+        return MyStl::equal(first1, last1, first2);
+    }
+
+    // pieces that start after a difference was found elsewhere don't bother looking
+    template <typename RandomIt1, typename RandomIt2>
+    bool equal_parallel(RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, std::true_type){
+        std::size_t n = last1 - first1, tasks = parallel_task_count(n);
+        if (tasks < 2) return equal_parallel(first1, last1, first2, std::false_type());
+
+        std::atomic<bool> differ{false};
+        parallel_pieces(n, tasks, [first1, first2, &differ](std::size_t begin, std::size_t end, std::size_t){
+            if (differ.load(std::memory_order_relaxed)) return;
+            if (!MyStl::equal(first1 + begin, first1 + end, first2 + begin)) differ.store(true, std::memory_order_relaxed);
+        });
+        return !differ.load(std::memory_order_relaxed);
+    }
+
+    template <typename Policy, typename InputIt1, typename InputIt2,
+              typename std::enable_if<Is_Execution_Policy<typename std::decay<Policy>::type>::value, bool>::type = true>
+    bool equal(Policy&&, InputIt1 first1, InputIt1 last1, InputIt2 first2){
+        return equal_parallel(first1, last1, first2, Is_Parallel_Call<Policy, InputIt1, InputIt2>());
+    }
+
+    template <typename InputIt, typename OutputIt, typename F>
+    OutputIt copy_if_parallel(InputIt first, InputIt last, OutputIt d_first, F& pred, std::false_type){
+        return MyStl::copy_if(first, last, d_first, pred);
+    }
+
+    /* a prefix sum over the pieces: the first pass counts the matches of each piece, their running
+       total is where each piece's output starts, and the second pass copies every piece there. The
+       total only has a few entries per thread so it is summed on the calling thread. pred is called
+       twice on every element and must give the same answer both times */
+    template <typename RandomIt1, typename RandomIt2, typename F>
+    RandomIt2 copy_if_parallel(RandomIt1 first, RandomIt1 last, RandomIt2 d_first, F& pred, std::true_type){
+        std::size_t n = last - first, tasks = parallel_task_count(n);
+        if (tasks < 2) return copy_if_parallel(first, last, d_first, pred, std::false_type());
+
+        MyStl::Vector<std::size_t> offsets(tasks + 1, 0);
+        parallel_pieces(n, tasks, [first, &pred, &offsets](std::size_t begin, std::size_t end, std::size_t task){
+            std::size_t count = 0;
+            for (RandomIt1 it = first + begin, stop = first + end; it != stop; ++it){
+                if (pred(*it)) ++count;
+            }
+            offsets[task + 1] = count;
+        });
+
+        for (std::size_t i = 1; i <= tasks; ++i) offsets[i] += offsets[i - 1];
+
+        parallel_pieces(n, tasks, [first, d_first, &pred, &offsets](std::size_t begin, std::size_t end, std::size_t task){
+            MyStl::copy_if(first + begin, first + end, d_first + offsets[task], pred);
+        });
+        return d_first + offsets[tasks];
+    }
+
+    template <typename Policy, typename InputIt, typename OutputIt, typename F,
+              typename std::enable_if<Is_Execution_Policy<typename std::decay<Policy>::type>::value, bool>::type = true>
+    OutputIt copy_if(Policy&&, InputIt first, InputIt last, OutputIt d_first, F pred){
+        return copy_if_parallel(first, last, d_first, pred, Is_Parallel_Call<Policy, InputIt, OutputIt>());
+    }
+}
+
+#endif
@@ -0,0 +1,159 @@
+#ifndef MYSTL_PRIORITYQUEUE_H
+#define MYSTL_PRIORITYQUEUE_H
+
+#include <assert.h>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+#include "Iterator.h"
+#include "Algorithm.h"
+#include "Vector.h"
+
+namespace MyStl{
+    /* the greatest element by Compare on top, kept as a heap over Container with Arity children per
+       node. A 4-ary heap does about half the cache misses of a binary one on a pop once it no longer fits
+       in the cache, for slightly more comparisons, which makes it the better pick for large queues of
+       cheap elements such as timers. Container needs random access iterators, front, push_back,
+       emplace_back and pop_back */
+    template <typename T, typename Container = MyStl::Vector<T>,
+              typename Compare = std::less<typename Container::value_type>, std::size_t Arity = 2>
+    class priority_queue{
+        static_assert(Arity >= 2, "a heap needs at least 2 children per node");
+        static_assert(std::is_same<T, typename Container::value_type>::value, "the container must hold T");
+
+        public:
+            using container_type = Container;
+            using value_compare = Compare;
+            using value_type = typename Container::value_type;
+            using size_type = typename Container::size_type;
+            using reference = typename Container::reference;
+            using const_reference = typename Container::const_reference;
+
+            static constexpr std::size_t arity = Arity;
+
+        private:
+            /* member fields */
+            Container _container;
+
+            Compare _comp;
+
+        public:
+            /* ctors */
+            priority_queue() : priority_queue(Compare()) {}
+
+            explicit priority_queue(const Compare& comp) : _container(), _comp(comp) {}
+
+            priority_queue(const Compare& comp, const Container& container) : _container(container), _comp(comp) {
+                make_heap();
+            }
+
+            priority_queue(const Compare& comp, Container&& container) : _container(std::move(container)), _comp(comp) {
+                make_heap();
+            }
+
+            template <typename InputIt,
+                      typename std::enable_if<MyStl::Is_Input_Iterator<InputIt>::value, bool>::type = true>
+            priority_queue(InputIt first, InputIt last, const Compare& comp = Compare()) : _container(), _comp(comp) {
+                for (; first != last; ++first) _container.push_back(*first);
+                make_heap();
+            }
+
+            priority_queue(std::initializer_list<value_type> ilist, const Compare& comp = Compare())
+                : priority_queue(ilist.begin(), ilist.end(), comp) {}
+
+        public:
+            /* element access */
+            const_reference top() const {
+                assert(!empty());
+                return _container.front();
+            }
+
+        public:
+            /* capacity */
+            bool empty() const {return _container.empty();}
+
+            size_type size() const {return _container.size();}
+
+            void reserve(size_type new_cap){_container.reserve(new_cap);}
+
+        public:
+            /* modifiers */
+            void push(const value_type& value){
+                _container.push_back(value);
+                heap_push<Arity>(_container.begin(), size(), _comp);
+            }
+
+            void push(value_type&& value){
+                _container.push_back(std::move(value));
+                heap_push<Arity>(_container.begin(), size(), _comp);
+            }
+
+            template <typename... Args>
+            void emplace(Args&&... args){
+                _container.emplace_back(std::forward<Args>(args)...);
+                heap_push<Arity>(_container.begin(), size(), _comp);
+            }
+
+            /* pushes every element of [first, last). Many at once are appended and the whole heap is
+               rebuilt in O(size), few are sifted up one by one in O(log size) each, whichever is less */
+            template <typename InputIt,
+                      typename std::enable_if<MyStl::Is_Input_Iterator<InputIt>::value, bool>::type = true>
+            void push_range(InputIt first, InputIt last){
+                std::ptrdiff_t old_size = size();
+                for (; first != last; ++first) _container.push_back(*first);
+
+                std::ptrdiff_t new_size = size(), depth = 1;
+                for (std::ptrdiff_t n = new_size; n > 1; n /= static_cast<std::ptrdiff_t>(Arity)) ++depth;
+
+                if ((new_size - old_size) * depth >= new_size){
+                    make_heap();
+                    return;
+                }
+                for (std::ptrdiff_t len = old_size + 1; len <= new_size; ++len) heap_push<Arity>(_container.begin(), len, _comp);
+            }
+
+            void pop(){
+                assert(!empty());
+                heap_pop<Arity>(_container.begin(), size(), _comp);
+                _container.pop_back();
+            }
+
+            /* pop followed by push, in a single sift down from the top. What a scheduler does when the
+               task it just ran goes back in the queue */
+            void replace_top(const value_type& value){
+                assert(!empty());
+                heap_sift_down<Arity>(_container.begin(), 0, size(), value_type(value), _comp);
+            }
+
+            void replace_top(value_type&& value){
+                assert(!empty());
+                heap_sift_down<Arity>(_container.begin(), 0, size(), std::move(value), _comp);
+            }
+
+            void swap(priority_queue& other) noexcept(noexcept(std::declval<Container&>().swap(std::declval<Container&>()))){
+                using std::swap;
+                _container.swap(other._container);
+                swap(_comp, other._comp);
+            }
+
+        private:
+            /* helpers */
+            void make_heap(){
+                heap_make<Arity>(_container.begin(), size(), _comp);
+            }
+    };
+
+    // a 4-ary priority_queue, for queues too large for the cache
+    template <typename T, typename Container = MyStl::Vector<T>, typename Compare = std::less<typename Container::value_type>>
+    using quaternary_priority_queue = priority_queue<T, Container, Compare, 4>;
+
+    template <typename T, typename Container, typename Compare, std::size_t Arity>
+    void swap(priority_queue<T, Container, Compare, Arity>& lhs, priority_queue<T, Container, Compare, Arity>& rhs) noexcept(noexcept(lhs.swap(rhs))){
+        lhs.swap(rhs);
+    }
+}
+
+#endif
@@ -0,0 +1,541 @@
+#ifndef MYSTL_SMALLVECTOR_H
+#define MYSTL_SMALLVECTOR_H
+
+#include <memory>
+#include <assert.h>
+#include <stdexcept>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <initializer_list>
+
+#include "Iterator.h"
+#include "Algorithm.h"
+#include "Vector.h"
+
+namespace MyStl{
+    /* Vector with room for N elements inside the object itself,
+       the heap is only used once the elements don't fit anymore */
+    template <typename T, std::size_t N, typename Alloc = std::allocator<T>, typename Growth = Double_Growth>
+    class SmallVector{
+        static_assert(N > 0, "use Vector if no inline storage is needed");
+
+        public:
+            using value_type = T;
+            using allocator_type = Alloc;
+            using growth_policy = Growth;
+            using size_type = typename std::allocator_traits<Alloc>::size_type;
+            using difference_type = typename std::allocator_traits<Alloc>::difference_type;
+            using pointer = typename std::allocator_traits<Alloc>::pointer;
+            using const_pointer = typename std::allocator_traits<Alloc>::const_pointer;
+            using reference = T&;
+            using const_reference = const T&;
+            using iterator = T*;
+            using const_iterator = const T*;
+            using reverse_iterator = Reverse_Iterator<iterator>;
+            using const_reverse_iterator = Reverse_Iterator<const_iterator>;
+
+            static_assert(std::is_same<pointer, T*>::value, "SmallVector only supports allocators with raw pointers");
+
+            static constexpr size_type inline_capacity = N;
+
+        private:
+            using alloc_traits = std::allocator_traits<Alloc>;
+
+            /* member fields */
+            allocator_type alloc;
+
+            iterator _begin;
+
+            iterator _end;
+
+            iterator cap;
+
+            alignas(T) unsigned char _buffer[N * sizeof(T)];
+
+        public:
+            /* ctors and dtors */
+            SmallVector() noexcept : SmallVector(Alloc()) {}
+
+            explicit SmallVector(const Alloc& al) noexcept : alloc(al) {
+                reset_to_inline();
+            }
+
+            SmallVector(size_type count, const T& value, const Alloc& al = Alloc()) : SmallVector(al) {
+                insert(_end, count, value);
+            }
+
+            explicit SmallVector(size_type count, const Alloc& al = Alloc()) : SmallVector(al) {
+                resize(count);
+            }
+
+            template<class InputIt, typename std::enable_if<MyStl::Is_Input_Iterator<InputIt>::value, bool>::type = true>
+            SmallVector(InputIt first, InputIt last, const Alloc& al = Alloc()) : SmallVector(al) {
+                try{
+                    insert(_end, first, last);
+                }catch(...){
+                    free();
+                    throw;
+                }
+            }
+
+            SmallVector(const SmallVector& other)
+                : SmallVector(other._begin, other._end, alloc_traits::select_on_container_copy_construction(other.alloc)){}
+
+            SmallVector(const SmallVector& other, const Alloc& al) : SmallVector(other._begin, other._end, al){}
+
+            // inline elements are moved one by one, a heap buffer is taken over
+            SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+                : SmallVector(std::move(other.alloc)) {
+                take_from(other);
+            }
+
+            SmallVector(SmallVector&& other, const Alloc& al) : SmallVector(al) {
+                take_from(other);
+            }
+
+            SmallVector(std::initializer_list<T> init, const Alloc& al = Alloc()) : SmallVector(init.begin(), init.end(), al){}
+
+            ~SmallVector(){free();}
+
+            SmallVector& operator=(const SmallVector& other){
+                if (&other != this){
+                    MyStl::alloc_on_copy(alloc, other.alloc, [this](){free();});
+                    assign(other._begin, other._end);
+                }
+
+                return *this;
+            }
+
+            // only an allocator that stays behind and compares unequal needs a new buffer, which may throw
+            SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value
+                && (alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)){
+                if (&other != this){
+                    free();
+                    move_assign_alloc(other, typename alloc_traits::propagate_on_container_move_assignment());
+                    take_from(other);
+                }
+
+                return *this;
+            }
+
+            SmallVector& operator=(std::initializer_list<T> ilist){
+                assign(ilist.begin(), ilist.end());
+                return *this;
+            }
+
+            void assign(size_type count, const T& value){
+                T value_backup(value);
+                clear();
+                insert(_end, count, value_backup);
+            }
+
+            template<class InputIt, typename std::enable_if<MyStl::Is_Input_Iterator<InputIt>::value, bool>::type = true>
+            void assign(InputIt first, InputIt last){
+                clear();
+                insert(_end, first, last);
+            }
+
+            void assign(std::initializer_list<T> ilist){
+                assign(ilist.begin(), ilist.end());
+            }
+
+            allocator_type get_allocator() const noexcept {return alloc;}
+
+        public:
+            /* member access */
+            reference front(){
+                assert(!empty());
+                return *_begin;
+            }
+
+            const_reference front() const {
+                assert(!empty());
+                return *_begin;
+            }
+
+            reference back(){
+                assert(!empty());
+                return *(_end - 1);
+            }
+
+            const_reference back() const {
+                assert(!empty());
+                return *(_end - 1);
+            }
+
+            reference operator[](size_type pos){
+                assert(pos < size());
+                return *(_begin + pos);
+            }
+
+            const_reference operator[](size_type pos) const {
+                assert(pos < size());
+                return *(_begin + pos);
+            }
+
+            reference at(size_type pos){
+                if (pos >= size()) throw std::out_of_range("element index out of range");
+
+                return this->operator[](pos);
+            }
+
+            const_reference at(size_type pos) const {
+                if (pos >= size()) throw std::out_of_range("element index out of range");
+
+                return this->operator[](pos);
+            }
+
+            T* data() noexcept {return _begin;}
+            const T* data() const noexcept {return _begin;}
+
+        public:
+            /* iterators */
+            iterator begin() noexcept {return _begin;}
+
+            const_iterator begin() const noexcept {return _begin;}
+
+            const_iterator cbegin() const noexcept {return _begin;}
+
+            iterator end() noexcept {return _end;}
+
+            const_iterator end() const noexcept {return _end;}
+
+            const_iterator cend() const noexcept {return _end;}
+
+            reverse_iterator rbegin() noexcept {return reverse_iterator(_end);}
+
+            const_reverse_iterator rbegin() const noexcept {return const_reverse_iterator(_end);}
+
+            const_reverse_iterator crbegin() const noexcept {return const_reverse_iterator(_end);}
+
+            reverse_iterator rend() noexcept {return reverse_iterator(_begin);}
+
+            const_reverse_iterator rend() const noexcept {return const_reverse_iterator(_begin);}
+
+            const_reverse_iterator crend() const noexcept {return const_reverse_iterator(_begin);}
+
+        public:
+            /* capacity */
+            size_type capacity() const noexcept {return cap - _begin;}
+
+            size_type size() const noexcept {return _end - _begin;}
+
+            bool empty() const noexcept {return _begin == _end;}
+
+            size_type max_size() const noexcept {return static_cast<size_type>(-1) / sizeof(value_type);}
+
+            // whether the elements live in the inline buffer
+            bool is_inline() const noexcept {return _begin == inline_begin();}
+
+            void reserve(size_type new_cap){
+                if (new_cap <= capacity()) return;
+
+                if (new_cap > max_size()){
+                    throw std::length_error("cannot reserve capacity bigger than max_size");
+                }
+
+                reallocate_exactly(new_cap);
+            }
+
+            // moves the elements back inline if they fit
+            void shrink_to_fit(){
+                if (!is_inline() && size() != capacity()){
+                    reallocate_exactly(size());
+                }
+            }
+
+        public:
+            /* modifiers */
+            void clear() noexcept {
+                destroy_range(_begin, _end);
+                _end = _begin;
+            }
+
+            iterator erase(const_iterator pos){
+                assert(pos >= _begin && pos < _end);
+                return erase(pos, pos + 1);
+            }
+
+            iterator erase(const_iterator first, const_iterator last){
+                assert(first >= _begin && first <= last && last <= _end);
+
+                iterator erase_first = const_cast<iterator>(first);
+                iterator new_end = std::move(const_cast<iterator>(last), _end, erase_first);
+                destroy_range(new_end, _end);
+                _end = new_end;
+
+                return erase_first;
+            }
+
+            iterator insert(const_iterator pos, const T& value){
+                return emplace(pos, value);
+            }
+
+            iterator insert(const_iterator pos, T&& value){
+                return emplace(pos, std::move(value));
+            }
+
+            iterator insert(const_iterator pos, size_type count, const T& value){
+                assert(pos >= _begin && pos <= _end);
+                size_type index = pos - _begin;
+                if (count == 0) return _begin + index;
+
+                // in case value refers to an element within the container
+                T value_backup(value);
+                make_room(count);
+
+                iterator old_end = _end;
+                try{
+                    for (; count > 0; --count) emplace_back_unchecked(value_backup);
+                }catch(...){
+                    destroy_range(old_end, _end);
+                    _end = old_end;
+                    throw;
+                }
+
+                MyStl::rotate(_begin + index, old_end, _end);
+                return _begin + index;
+            }
+
+            template<class InputIt, typename std::enable_if<MyStl::Is_Input_Iterator<InputIt>::value, bool>::type = true>
+            iterator insert(const_iterator pos, InputIt first, InputIt last){
+                assert(pos >= _begin && pos <= _end);
+                size_type index = pos - _begin;
+                if (first == last) return _begin + index;
+
+                make_room(MyStl::distance(first, last));
+
+                iterator old_end = _end;
+                try{
+                    for (; first != last; ++first) emplace_back_unchecked(*first);
+                }catch(...){
+                    destroy_range(old_end, _end);
+                    _end = old_end;
+                    throw;
+                }
+
+                MyStl::rotate(_begin + index, old_end, _end);
+                return _begin + index;
+            }
+
+            iterator insert(const_iterator pos, std::initializer_list<T> ilist){
+                return insert(pos, ilist.begin(), ilist.end());
+            }
+
+            template<class... Args> iterator emplace(const_iterator pos, Args&&... args){
+                assert(pos >= _begin && pos <= _end);
+                size_type index = pos - _begin;
+
+                // constructed first since args may refer to an element within the container
+                value_type value(std::forward<Args>(args)...);
+                make_room(1);
+
+                iterator insert_pos = _begin + index;
+                if (insert_pos == _end){
+                    emplace_back_unchecked(std::move(value));
+                }else{
+                    emplace_back_unchecked(std::move(*(_end - 1)));
+                    std::move_backward(insert_pos, _end - 2, _end - 1);
+                    *insert_pos = std::move(value);
+                }
+
+                return insert_pos;
+            }
+
+            template<class... Args> reference emplace_back(Args&&... args){
+                if (_end == cap){
+                    value_type value(std::forward<Args>(args)...);
+                    make_room(1);
+                    emplace_back_unchecked(std::move(value));
+                }else{
+                    emplace_back_unchecked(std::forward<Args>(args)...);
+                }
+
+                return *(_end - 1);
+            }
+
+            void push_back(const T& value){
+                emplace_back(value);
+            }
+
+            void push_back(T&& value){
+                emplace_back(std::move(value));
+            }
+
+            void pop_back(){
+                assert(!empty());
+                alloc_traits::destroy(alloc, --_end);
+            }
+
+            void resize(size_type count){
+                if (count < size()){
+                    erase(_begin + count, _end);
+                }else{
+                    reserve(count);
+                    while (size() < count) emplace_back_unchecked();
+                }
+            }
+
+            void resize(size_type count, const value_type& value){
+                if (count < size()){
+                    erase(_begin + count, _end);
+                }else{
+                    insert(_end, count - size(), value);
+                }
+            }
+
+            void swap(SmallVector& other){
+                if (&other == this) return;
+
+                MyStl::alloc_on_swap(alloc, other.alloc);
+                if (!is_inline() && !other.is_inline()){
+                    std::swap(_begin, other._begin);
+                    std::swap(_end, other._end);
+                    std::swap(cap, other.cap);
+                }else{
+                    SmallVector temp(std::move(other));
+                    other.take_from(*this);
+                    take_from(temp);
+                }
+            }
+
+        private:
+            /* helpers */
+            iterator inline_begin() noexcept {return reinterpret_cast<iterator>(_buffer);}
+
+            const_iterator inline_begin() const noexcept {return reinterpret_cast<const_iterator>(_buffer);}
+
+            void reset_to_inline() noexcept {
+                _begin = _end = inline_begin();
+                cap = _begin + N;
+            }
+
+            template<class... Args> void emplace_back_unchecked(Args&&... args){
+                assert(_end != cap);
+                alloc_traits::construct(alloc, _end, std::forward<Args>(args)...);
+                ++_end;
+            }
+
+            void destroy_range(iterator first, iterator last) noexcept {
+                for (; first != last; ++first){
+                    alloc_traits::destroy(alloc, first);
+                }
+            }
+
+            void free() noexcept {
+                destroy_range(_begin, _end);
+                if (!is_inline()) alloc_traits::deallocate(alloc, _begin, capacity());
+
+                reset_to_inline();
+            }
+
+            // ensures room for count more elements
+            void make_room(size_type count){
+                if (static_cast<size_type>(cap - _end) >= count) return;
+
+                size_type new_cap = Growth::next_capacity(capacity(), size() + count, sizeof(T));
+                if (new_cap > max_size()){
+                    throw std::length_error("small vector cannot grow beyond max_size");
+                }
+                reallocate_exactly(new_cap);
+            }
+
+            /* moves every element into a buffer of new_cap elements, the inline one if they fit */
+            void reallocate_exactly(size_type new_cap){
+                bool to_inline = new_cap <= N;
+                iterator new_begin = to_inline ? inline_begin() : alloc_traits::allocate(alloc, new_cap);
+                iterator new_end;
+                try{
+                    new_end = relocate(_begin, _end, new_begin, can_relocate());
+                }catch(...){
+                    if (!to_inline) alloc_traits::deallocate(alloc, new_begin, new_cap);
+                    throw;
+                }
+
+                if (!is_inline()) alloc_traits::deallocate(alloc, _begin, capacity());
+                _begin = new_begin;
+                _end = new_end;
+                cap = new_begin + (to_inline ? N : new_cap);
+            }
+
+            // steals the heap buffer of other, or moves its inline elements over,
+            // must be called on an empty inline container, other is left empty and inline
+            void take_from(SmallVector& other){
+                assert(empty() && is_inline());
+
+                if (!other.is_inline() && alloc == other.alloc){
+                    _begin = other._begin;
+                    _end = other._end;
+                    cap = other.cap;
+                    other.reset_to_inline();
+                    return;
+                }
+
+                reserve(other.size());
+                _end = relocate(other._begin, other._end, _begin, can_relocate());
+                if (!other.is_inline()) alloc_traits::deallocate(other.alloc, other._begin, other.capacity());
+                other.reset_to_inline();
+            }
+
+            void move_assign_alloc(SmallVector& other, std::true_type){
+                alloc = std::move(other.alloc);
+            }
+
+            void move_assign_alloc(SmallVector&, std::false_type){}
+
+            using can_relocate = MyStl::Is_Bitwise_Relocatable<Alloc, T>;
+
+            /* relocate [first, last) to uninitialized memory at result,
+               the source is left as raw memory, returns the iterator after the last relocated element */
+            iterator relocate(iterator first, iterator last, iterator result, std::true_type) noexcept {
+                if (first != last){
+                    std::memcpy(static_cast<void*>(result), static_cast<const void*>(first), (last - first) * sizeof(T));
+                }
+
+                return result + (last - first);
+            }
+
+            iterator relocate(iterator first, iterator last, iterator result, std::false_type){
+                iterator out = result;
+                try{
+                    for (iterator i = first; i != last; ++i, ++out){
+                        alloc_traits::construct(alloc, out, std::move(*i));
+                    }
+                }catch(...){
+                    destroy_range(result, out);
+                    throw;
+                }
+                destroy_range(first, last);
+
+                return out;
+            }
+    };
+
+    /* operators */
+    template<class T, std::size_t N, class Alloc, class Growth>
+    bool operator==(const SmallVector<T, N, Alloc, Growth>& lhs, const SmallVector<T, N, Alloc, Growth>& rhs){
+        if (lhs.size() != rhs.size()) return false;
+
+        return MyStl::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template<class T, std::size_t N, class Alloc, class Growth>
+    bool operator!=(const SmallVector<T, N, Alloc, Growth>& lhs, const SmallVector<T, N, Alloc, Growth>& rhs){return !(lhs == rhs);}
+
+    template<class T, std::size_t N, class Alloc, class Growth>
+    bool operator<(const SmallVector<T, N, Alloc, Growth>& lhs, const SmallVector<T, N, Alloc, Growth>& rhs){
+        return MyStl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template<class T, std::size_t N, class Alloc, class Growth>
+    bool operator<=(const SmallVector<T, N, Alloc, Growth>& lhs, const SmallVector<T, N, Alloc, Growth>& rhs){return !(rhs < lhs);}
+
+    template<class T, std::size_t N, class Alloc, class Growth>
+    bool operator>(const SmallVector<T, N, Alloc, Growth>& lhs, const SmallVector<T, N, Alloc, Growth>& rhs){return rhs < lhs;}
+
+    template<class T, std::size_t N, class Alloc, class Growth>
+    bool operator>=(const SmallVector<T, N, Alloc, Growth>& lhs, const SmallVector<T, N, Alloc, Growth>& rhs){return !(lhs < rhs);}
+}
+
+#endif
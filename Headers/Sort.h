@@ -0,0 +1,1238 @@
+#ifndef MYSTL_SORT_H
+#define MYSTL_SORT_H
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Algorithm.h"
+#include "Iterator.h"
+#include "Vector.h"
+
+// ranges shorter than this are left to insertion sort
+#ifndef MYSTL_INSERTION_SORT_THRESHOLD
+#define MYSTL_INSERTION_SORT_THRESHOLD 24
+#endif
+
+// radix_sort leaves ranges shorter than this to insertion sort, clearing the counts would cost more
+#ifndef MYSTL_RADIX_SORT_THRESHOLD
+#define MYSTL_RADIX_SORT_THRESHOLD 64
+#endif
+
+// stable_sort sorts runs shorter than this by insertion, longer ones are built from natural or insertion sorted runs
+#ifndef MYSTL_STABLE_SORT_MIN_MERGE
+#define MYSTL_STABLE_SORT_MIN_MERGE 64
+#endif
+
+// radix_sort splits ranges larger than this by their highest bits until the pieces fit in cache
+#ifndef MYSTL_RADIX_MSD_BYTES
+#define MYSTL_RADIX_MSD_BYTES (1 << 18)
+#endif
+
+namespace MyStl{
+    /* pattern-defeating quicksort: a quicksort that takes the median of 3, or of 3 medians of 3 on long
+       ranges, as the pivot and notices the inputs plain quicksort is bad at. A partition that needed no
+       swaps hints at sorted input and gets a bounded insertion sort that stops after a few moves, a pivot
+       equal to the one before puts all its equals on the left in one go so many duplicates are linear,
+       and partitions that come out lopsided shuffle a few elements around and, after log n of them,
+       make the rest a heap sort so the worst case stays n log n. For arithmetic types with the default
+       comparisons the partition collects the positions of misplaced elements in small blocks without
+       branching on the comparisons, which the CPU would mispredict half the time on random input */
+    template <typename T, typename Compare>
+    struct Is_Branchless_Sortable : std::integral_constant<bool, std::is_arithmetic<T>::value
+        && (std::is_same<Compare, std::less<T>>::value || std::is_same<Compare, std::greater<T>>::value
+            || std::is_same<Compare, std::less<>>::value || std::is_same<Compare, std::greater<>>::value)> {};
+
+    template <typename RandomIt, typename Compare>
+    void insertion_sort(RandomIt first, RandomIt last, Compare& comp){
+        using T = typename Iterator_Traits<RandomIt>::value_type;
+        if (first == last) return;
+
+        for (RandomIt cur = first + 1; cur != last; ++cur){
+            RandomIt sift = cur, sift_1 = cur - 1;
+            if (!comp(*sift, *sift_1)) continue;
+
+            T tmp = std::move(*sift);
+            do {
+                *sift = std::move(*sift_1);
+                --sift;
+            } while (sift != first && comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+    }
+
+    // there must be an element before first that is not greater than any in [first, last)
+    template <typename RandomIt, typename Compare>
+    void unguarded_insertion_sort(RandomIt first, RandomIt last, Compare& comp){
+        using T = typename Iterator_Traits<RandomIt>::value_type;
+        if (first == last) return;
+
+        for (RandomIt cur = first + 1; cur != last; ++cur){
+            RandomIt sift = cur, sift_1 = cur - 1;
+            if (!comp(*sift, *sift_1)) continue;
+
+            T tmp = std::move(*sift);
+            do {
+                *sift = std::move(*sift_1);
+                --sift;
+            } while (comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+    }
+
+    // gives up and returns false once more than a few elements had to be moved, the range is then only partly sorted
+    template <typename RandomIt, typename Compare>
+    bool partial_insertion_sort(RandomIt first, RandomIt last, Compare& comp){
+        using T = typename Iterator_Traits<RandomIt>::value_type;
+        constexpr std::ptrdiff_t move_limit = 8;
+        if (first == last) return true;
+
+        std::ptrdiff_t moved = 0;
+        for (RandomIt cur = first + 1; cur != last; ++cur){
+            RandomIt sift = cur, sift_1 = cur - 1;
+            if (!comp(*sift, *sift_1)) continue;
+
+            T tmp = std::move(*sift);
+            do {
+                *sift = std::move(*sift_1);
+                --sift;
+            } while (sift != first && comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+
+            moved += cur - sift;
+            if (moved > move_limit) return false;
+        }
+
+        return true;
+    }
+
+    template <typename RandomIt, typename Compare>
+    void sort2(RandomIt a, RandomIt b, Compare& comp){
+        if (comp(*b, *a)) MyStl::iter_swap(a, b);
+    }
+
+    // leaves the median of the three in b
+    template <typename RandomIt, typename Compare>
+    void sort3(RandomIt a, RandomIt b, RandomIt c, Compare& comp){
+        sort2(a, b, comp);
+        sort2(b, c, comp);
+        sort2(a, b, comp);
+    }
+
+    /* the pivot is *first, returns where it ended up with everything smaller to its left and the rest
+       to its right, and whether nothing had to be swapped for that. *first must not be greater than
+       the last element, and there must be one before first not greater than it unless it's the first
+       of the whole range, otherwise the scans below would run off the range */
+    template <typename RandomIt, typename Compare>
+    std::pair<RandomIt, bool> partition_right(RandomIt begin, RandomIt end, Compare& comp){
+        using T = typename Iterator_Traits<RandomIt>::value_type;
+        T pivot = std::move(*begin);
+        RandomIt first = begin, last = end;
+
+        while (comp(*++first, pivot)) {}
+        if (first - 1 == begin){
+            while (first < last && !comp(*--last, pivot)) {}
+        }else{
+            while (!comp(*--last, pivot)) {}
+        }
+
+        bool already_partitioned = first >= last;
+        while (first < last){
+            MyStl::iter_swap(first, last);
+            while (comp(*++first, pivot)) {}
+            while (!comp(*--last, pivot)) {}
+        }
+
+        RandomIt pivot_pos = first - 1;
+        *begin = std::move(*pivot_pos);
+        *pivot_pos = std::move(pivot);
+        return std::make_pair(pivot_pos, already_partitioned);
+    }
+
+    /* swaps the misplaced elements found by partition_right_branchless in pairs. When both blocks
+       are the same size plain swaps are needed to keep reversed input linear, otherwise the elements
+       are rotated through one temporary, which moves each element once instead of three times */
+    template <typename RandomIt>
+    void swap_offsets(RandomIt left_base, RandomIt right_base, const unsigned char* offsets_l,
+                      const unsigned char* offsets_r, std::size_t count, bool use_swaps){
+        using T = typename Iterator_Traits<RandomIt>::value_type;
+        if (use_swaps){
+            for (std::size_t i = 0; i < count; ++i) MyStl::iter_swap(left_base + offsets_l[i], right_base - offsets_r[i]);
+        }else if (count > 0){
+            RandomIt l = left_base + offsets_l[0], r = right_base - offsets_r[0];
+            T tmp = std::move(*l);
+            *l = std::move(*r);
+            for (std::size_t i = 1; i < count; ++i){
+                l = left_base + offsets_l[i];
+                *r = std::move(*l);
+                r = right_base - offsets_r[i];
+                *l = std::move(*r);
+            }
+            *r = std::move(tmp);
+        }
+    }
+
+    /* same result as partition_right. Each round looks at up to a block of elements from both ends
+       and writes down the offsets of those on the wrong side by always storing the offset and only
+       advancing the count by the result of the comparison, then swaps as many pairs as both blocks have */
+    template <typename RandomIt, typename Compare>
+    std::pair<RandomIt, bool> partition_right_branchless(RandomIt begin, RandomIt end, Compare& comp){
+        using T = typename Iterator_Traits<RandomIt>::value_type;
+        constexpr std::size_t block_size = 64;
+        T pivot = std::move(*begin);
+        RandomIt first = begin, last = end;
+
+        while (comp(*++first, pivot)) {}
+        if (first - 1 == begin){
+            while (first < last && !comp(*--last, pivot)) {}
+        }else{
+            while (!comp(*--last, pivot)) {}
+        }
+
+        bool already_partitioned = first >= last;
+        if (!already_partitioned){
+            MyStl::iter_swap(first, last);
+            ++first;
+
+            alignas(64) unsigned char offsets_l[block_size];
+            alignas(64) unsigned char offsets_r[block_size];
+            RandomIt left_base = first, right_base = last;
+            std::size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+            while (first < last){
+                // a side whose block still has offsets left over from the last round doesn't scan any further
+                std::size_t unknown = last - first;
+                std::size_t left_split = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+                std::size_t right_split = num_r == 0 ? unknown - left_split : 0;
+
+                std::size_t scan_l = left_split < block_size ? left_split : block_size;
+                for (std::size_t i = 0; i < scan_l; ++i){
+                    offsets_l[num_l] = static_cast<unsigned char>(i);
+                    num_l += !comp(*first, pivot);
+                    ++first;
+                }
+
+                std::size_t scan_r = right_split < block_size ? right_split : block_size;
+                for (std::size_t i = 0; i < scan_r; ){
+                    offsets_r[num_r] = static_cast<unsigned char>(++i);
+                    num_r += comp(*--last, pivot);
+                }
+
+                std::size_t count = num_l < num_r ? num_l : num_r;
+                swap_offsets(left_base, right_base, offsets_l + start_l, offsets_r + start_r, count, num_l == num_r);
+                num_l -= count;
+                num_r -= count;
+                start_l += count;
+                start_r += count;
+
+                if (num_l == 0){
+                    start_l = 0;
+                    left_base = first;
+                }
+                if (num_r == 0){
+                    start_r = 0;
+                    right_base = last;
+                }
+            }
+
+            // whatever one side has left over goes to the far end of the other
+            if (num_l){
+                while (num_l--) MyStl::iter_swap(left_base + offsets_l[start_l + num_l], --last);
+                first = last;
+            }
+            if (num_r){
+                while (num_r--){
+                    MyStl::iter_swap(right_base - offsets_r[start_r + num_r], first);
+                    ++first;
+                }
+                last = first;
+            }
+        }
+
+        RandomIt pivot_pos = first - 1;
+        *begin = std::move(*pivot_pos);
+        *pivot_pos = std::move(pivot);
+        return std::make_pair(pivot_pos, already_partitioned);
+    }
+
+    /* the pivot *first is known to equal the element before first, so nothing in the range is smaller.
+       Puts everything equal to it on its left and returns its position, those are then done */
+    template <typename RandomIt, typename Compare>
+    RandomIt partition_left(RandomIt begin, RandomIt end, Compare& comp){
+        using T = typename Iterator_Traits<RandomIt>::value_type;
+        T pivot = std::move(*begin);
+        RandomIt first = begin, last = end;
+
+        while (comp(pivot, *--last)) {}
+        if (last + 1 == end){
+            while (first < last && !comp(pivot, *++first)) {}
+        }else{
+            while (!comp(pivot, *++first)) {}
+        }
+
+        while (first < last){
+            MyStl::iter_swap(first, last);
+            while (comp(pivot, *--last)) {}
+            while (!comp(pivot, *++first)) {}
+        }
+
+        RandomIt pivot_pos = last;
+        *begin = std::move(*pivot_pos);
+        *pivot_pos = std::move(pivot);
+        return pivot_pos;
+    }
+
+    /* sorts [begin, end), recursing into the left part and looping on the right one. bad_allowed
+       is how many more lopsided partitions are tolerated before giving up on quicksort. leftmost
+       is false when there is an element before begin not greater than any in the range */
+    template <typename RandomIt, typename Compare, bool Branchless>
+    void pdq_sort_loop(RandomIt begin, RandomIt end, Compare& comp, int bad_allowed, bool leftmost){
+        constexpr std::ptrdiff_t ninther_threshold = 128;
+
+        while (true){
+            std::ptrdiff_t size = end - begin;
+            if (size < MYSTL_INSERTION_SORT_THRESHOLD){
+                if (leftmost) insertion_sort(begin, end, comp);
+                else unguarded_insertion_sort(begin, end, comp);
+                return;
+            }
+
+            // the pivot ends up in *begin, with a smaller or equal element after it and a greater or equal one at the end
+            std::ptrdiff_t half = size / 2;
+            if (size > ninther_threshold){
+                sort3(begin, begin + half, end - 1, comp);
+                sort3(begin + 1, begin + (half - 1), end - 2, comp);
+                sort3(begin + 2, begin + (half + 1), end - 3, comp);
+                sort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+                MyStl::iter_swap(begin, begin + half);
+            }else{
+                sort3(begin + half, begin, end - 1, comp);
+            }
+
+            // a pivot equal to the one of the parent partition has lots of equals, set them all aside
+            if (!leftmost && !comp(*(begin - 1), *begin)){
+                begin = partition_left(begin, end, comp) + 1;
+                continue;
+            }
+
+            std::pair<RandomIt, bool> part = Branchless ? partition_right_branchless(begin, end, comp)
+                                                        : partition_right(begin, end, comp);
+            RandomIt pivot_pos = part.first;
+            std::ptrdiff_t l_size = pivot_pos - begin, r_size = end - (pivot_pos + 1);
+
+            if (l_size < size / 8 || r_size < size / 8){
+                if (--bad_allowed == 0){
+                    heap_make<2>(begin, end - begin, comp);
+                    heap_sort<2>(begin, end - begin, comp);
+                    return;
+                }
+
+                // swap a few elements into new places to break up whatever pattern caused this
+                if (l_size >= MYSTL_INSERTION_SORT_THRESHOLD){
+                    MyStl::iter_swap(begin, begin + l_size / 4);
+                    MyStl::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                    if (l_size > ninther_threshold){
+                        MyStl::iter_swap(begin + 1, begin + (l_size / 4 + 1));
+                        MyStl::iter_swap(begin + 2, begin + (l_size / 4 + 2));
+                        MyStl::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                        MyStl::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                    }
+                }
+                if (r_size >= MYSTL_INSERTION_SORT_THRESHOLD){
+                    MyStl::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                    MyStl::iter_swap(end - 1, end - r_size / 4);
+                    if (r_size > ninther_threshold){
+                        MyStl::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                        MyStl::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                        MyStl::iter_swap(end - 2, end - (1 + r_size / 4));
+                        MyStl::iter_swap(end - 3, end - (2 + r_size / 4));
+                    }
+                }
+            }else if (part.second && partial_insertion_sort(begin, pivot_pos, comp)
+                                  && partial_insertion_sort(pivot_pos + 1, end, comp)){
+                // nothing was swapped and both sides were nearly sorted already
+                return;
+            }
+
+            pdq_sort_loop<RandomIt, Compare, Branchless>(begin, pivot_pos, comp, bad_allowed, leftmost);
+            begin = pivot_pos + 1;
+            leftmost = false;
+        }
+    }
+
+    template <typename RandomIt, typename Compare>
+    void sort_unchecked(RandomIt first, RandomIt last, Compare& comp, Random_Access_Iterator_Tag){
+        if (last - first < 2) return;
+
+        int bad_allowed = 0;
+        for (std::ptrdiff_t n = last - first; n > 1; n >>= 1) ++bad_allowed;
+
+        using T = typename Iterator_Traits<RandomIt>::value_type;
+        pdq_sort_loop<RandomIt, Compare, Is_Branchless_Sortable<T, Compare>::value>(first, last, comp, bad_allowed, true);
+    }
+
+    /* not stable, O(n log n) comparisons at worst and O(n) on sorted, reversed or constant input.
+       Only for random access iterators, List has a sort of its own */
+    template <typename RandomIt, typename Compare>
+    void sort(RandomIt first, RandomIt last, Compare comp){
+        static_assert(Is_Random_Access_Iterator<RandomIt>::value, "MyStl::sort needs random access iterators");
+        sort_unchecked(first, last, comp, typename Iterator_Traits<RandomIt>::iterator_category());
+    }
+
+    template <typename RandomIt>
+    void sort(RandomIt first, RandomIt last){
+        MyStl::sort(first, last, std::less<typename Iterator_Traits<RandomIt>::value_type>());
+    }
+
+    /* radix_sort keys. encode maps a key to an unsigned integer of the same width whose order as an
+       unsigned number is the key's order: signed integers get their sign bit flipped, floating point
+       numbers get the sign bit set if positive and all bits flipped if negative. So -0.0 comes right
+       before 0.0, and NaNs end up past the infinities on the side of their sign bit */
+    template <typename Key, bool = std::is_floating_point<Key>::value>
+    struct Radix_Key{
+        static_assert(std::is_integral<Key>::value && !std::is_same<Key, bool>::value,
+                      "radix_sort keys must be integers or floating point numbers");
+
+        using type = typename std::make_unsigned<Key>::type;
+
+        static type encode(Key key) noexcept {
+            type bits = static_cast<type>(key);
+            return std::is_signed<Key>::value ? static_cast<type>(bits ^ (type(1) << (sizeof(type) * CHAR_BIT - 1))) : bits;
+        }
+    };
+
+    template <typename Key>
+    struct Radix_Key<Key, true>{
+        static_assert(sizeof(Key) == 4 || sizeof(Key) == 8, "radix_sort only takes float and double keys");
+
+        using type = typename std::conditional<sizeof(Key) == 4, std::uint32_t, std::uint64_t>::type;
+
+        static type encode(Key key) noexcept {
+            type bits;
+            std::memcpy(&bits, &key, sizeof(bits));
+            const type sign = type(1) << (sizeof(type) * CHAR_BIT - 1);
+            return (bits & sign) ? static_cast<type>(~bits) : static_cast<type>(bits | sign);
+        }
+    };
+
+    struct Radix_Identity{
+        template <typename T>
+        const T& operator()(const T& value) const noexcept {return value;}
+    };
+
+    /* the elements are sorted by the highest bits first into buckets about MYSTL_RADIX_MSD_BYTES
+       large, as few bits as it takes, so that each bucket then fits in cache for the least significant
+       digit first passes over the remaining bits. Those count the digits of all their passes in one
+       go, and a pass whose digit is the same for every key, e.g. the high bytes of small numbers,
+       is skipped without touching the elements. Every pass moves all elements from one buffer to
+       the other, from_scratch says which one a bucket starts out in, it always ends up in data */
+    template <std::size_t DigitBits, typename T, typename KeyFn>
+    struct Radix_Sorter{
+        using Key = Radix_Key<typename std::decay<decltype(std::declval<KeyFn&>()(std::declval<const T&>()))>::type>;
+        using U = typename Key::type;
+
+        static constexpr std::size_t key_bits = sizeof(U) * CHAR_BIT;
+        static constexpr std::size_t bits = DigitBits != 0 ? DigitBits : (key_bits <= 16 ? 8 : 11);
+        static constexpr std::size_t buckets = std::size_t(1) << bits;
+        static_assert(bits <= 16, "radix_sort digits may have at most 16 bits");
+
+        KeyFn& key;
+        MyStl::Vector<std::size_t> counts;      // reused by every bucket's least significant digit passes
+
+        explicit Radix_Sorter(KeyFn& key_fn): key(key_fn), counts(((key_bits + bits - 1) / bits) * buckets) {}
+
+        void sort(T* data, T* scratch, std::size_t n){msd(data, scratch, n, key_bits, false);}
+
+        void small(T* data, T* scratch, std::size_t n, bool from_scratch){
+            if (from_scratch){
+                for (std::size_t i = 0; i < n; ++i) data[i] = std::move(scratch[i]);
+            }
+
+            auto less = [this](const T& lhs, const T& rhs){return Key::encode(key(lhs)) < Key::encode(key(rhs));};
+            insertion_sort(data, data + n, less);
+        }
+
+        // the bits from low_bits up are the same for all keys in the bucket
+        void msd(T* data, T* scratch, std::size_t n, std::size_t low_bits, bool from_scratch){
+            if (n < MYSTL_RADIX_SORT_THRESHOLD) return small(data, scratch, n, from_scratch);
+            if (low_bits <= bits || n * sizeof(T) <= MYSTL_RADIX_MSD_BYTES) return lsd(data, scratch, n, low_bits, from_scratch);
+
+            std::size_t top_bits = 1;
+            while (top_bits < bits && (n * sizeof(T) >> top_bits) > MYSTL_RADIX_MSD_BYTES / 2) ++top_bits;
+            std::size_t shift = low_bits - top_bits;
+            U mask = static_cast<U>((U(1) << top_bits) - 1);
+
+            T* src = from_scratch ? scratch : data;
+            T* dst = from_scratch ? data : scratch;
+            MyStl::Vector<std::size_t> start((std::size_t(1) << top_bits) + 1, 0);
+            for (std::size_t i = 0; i < n; ++i) ++start[((Key::encode(key(src[i])) >> shift) & mask) + 1];
+            if (start[((Key::encode(key(src[0])) >> shift) & mask) + 1] == n) return msd(data, scratch, n, shift, from_scratch);
+
+            for (std::size_t b = 1; b < start.size(); ++b) start[b] += start[b - 1];
+            MyStl::Vector<std::size_t> next(start);
+            for (std::size_t i = 0; i < n; ++i) dst[next[(Key::encode(key(src[i])) >> shift) & mask]++] = std::move(src[i]);
+
+            for (std::size_t b = 0; b + 1 < start.size(); ++b){
+                std::size_t count = start[b + 1] - start[b];
+                if (count > 0) msd(data + start[b], scratch + start[b], count, shift, dst == scratch);
+            }
+        }
+
+        // sorts by the lowest low_bits bits
+        void lsd(T* data, T* scratch, std::size_t n, std::size_t low_bits, bool from_scratch){
+            std::size_t passes = (low_bits + bits - 1) / bits;
+            std::size_t* count = counts.data();
+            for (std::size_t i = 0; i < passes * buckets; ++i) count[i] = 0;
+
+            T* src = from_scratch ? scratch : data;
+            T* dst = from_scratch ? data : scratch;
+            for (std::size_t i = 0; i < n; ++i){
+                U k = Key::encode(key(src[i]));
+                for (std::size_t p = 0; p < passes; ++p) ++count[p * buckets + ((k >> (p * bits)) & (buckets - 1))];
+            }
+
+            U first_key = Key::encode(key(src[0]));
+            for (std::size_t p = 0; p < passes; ++p, count += buckets){
+                std::size_t shift = p * bits;
+                if (count[(first_key >> shift) & (buckets - 1)] == n) continue;
+
+                for (std::size_t b = 0, sum = 0; b < buckets; ++b){
+                    std::size_t c = count[b];
+                    count[b] = sum;
+                    sum += c;
+                }
+
+                for (std::size_t i = 0; i < n; ++i){
+                    dst[count[(Key::encode(key(src[i])) >> shift) & (buckets - 1)]++] = std::move(src[i]);
+                }
+                std::swap(src, dst);
+            }
+
+            if (src != data){
+                for (std::size_t i = 0; i < n; ++i) data[i] = std::move(src[i]);
+            }
+        }
+    };
+
+    template <std::size_t DigitBits, typename T, typename KeyFn>
+    void radix_sort_pointers(T* first, T* last, KeyFn& key){
+        Radix_Sorter<DigitBits, T, KeyFn> sorter(key);
+        std::size_t n = last - first;
+        if (n < MYSTL_RADIX_SORT_THRESHOLD) return sorter.small(first, nullptr, n, false);
+
+        MyStl::Vector<T> buffer(n);
+        sorter.sort(first, buffer.data(), n);
+    }
+
+    template <std::size_t DigitBits, typename RandomIt, typename KeyFn>
+    void radix_sort_unchecked(RandomIt first, RandomIt last, KeyFn& key, std::true_type){
+        radix_sort_pointers<DigitBits>(first, last, key);
+    }
+
+    // other iterators, e.g. a Deque's, have their elements moved into a Vector and back
+    template <std::size_t DigitBits, typename RandomIt, typename KeyFn>
+    void radix_sort_unchecked(RandomIt first, RandomIt last, KeyFn& key, std::false_type){
+        MyStl::Vector<typename Iterator_Traits<RandomIt>::value_type> values;
+        values.reserve(last - first);
+        for (RandomIt it = first; it != last; ++it) values.push_back(std::move(*it));
+
+        radix_sort_pointers<DigitBits>(values.data(), values.data() + values.size(), key);
+        for (auto& value : values){
+            *first = std::move(value);
+            ++first;
+        }
+    }
+
+    /* stable radix sort by key(element), which must return an integer, float or double. Moves every
+       element about once per DigitBits bits of the key, fewer where a digit never changes, and takes a
+       Vector as large as the range, so the elements must be default constructible and move assignable.
+       DigitBits can be anything up to 16, by default 8 for keys of up to 16 bits and 11 for wider ones,
+       where 3 passes cover 32 bits. Wider digits mean fewer passes but more counters to clear and a
+       wider scatter, 16 only pays off for buckets of many megabytes */
+    template <std::size_t DigitBits = 0, typename RandomIt, typename KeyFn>
+    void radix_sort(RandomIt first, RandomIt last, KeyFn key){
+        static_assert(Is_Random_Access_Iterator<RandomIt>::value, "MyStl::radix_sort needs random access iterators");
+        radix_sort_unchecked<DigitBits>(first, last, key, std::is_pointer<RandomIt>());
+    }
+
+    template <std::size_t DigitBits = 0, typename RandomIt>
+    void radix_sort(RandomIt first, RandomIt last){
+        MyStl::radix_sort<DigitBits>(first, last, Radix_Identity());
+    }
+
+    // [first, sorted_end) is sorted already, each further element goes after its equals
+    template <typename RandomIt, typename Compare>
+    void binary_insertion_sort(RandomIt first, RandomIt sorted_end, RandomIt last, Compare& comp){
+        using T = typename Iterator_Traits<RandomIt>::value_type;
+
+        for (; sorted_end != last; ++sorted_end){
+            RandomIt pos = MyStl::upper_bound(first, sorted_end, *sorted_end, comp);
+            if (pos == sorted_end) continue;
+
+            T tmp = std::move(*sorted_end);
+            for (RandomIt it = sorted_end; it != pos; --it) *it = std::move(*(it - 1));
+            *pos = std::move(tmp);
+        }
+    }
+
+    /* merges the sorted [first, middle) and [middle, last) with rotations instead of a buffer, for when
+       there is no memory for one: O(n log n) moves instead of O(n) */
+    template <typename RandomIt, typename Compare>
+    void merge_without_buffer(RandomIt first, RandomIt middle, RandomIt last, std::ptrdiff_t len1, std::ptrdiff_t len2,
+                              Compare& comp){
+        while (len1 != 0 && len2 != 0){
+            if (len1 + len2 == 2){
+                if (comp(*middle, *first)) MyStl::iter_swap(first, middle);
+                return;
+            }
+
+            RandomIt first_cut = first, second_cut = middle;
+            std::ptrdiff_t len11 = 0, len22 = 0;
+            if (len1 > len2){
+                len11 = len1 / 2;
+                first_cut = first + len11;
+                second_cut = MyStl::lower_bound(middle, last, *first_cut, comp);
+                len22 = second_cut - middle;
+            }else{
+                len22 = len2 / 2;
+                second_cut = middle + len22;
+                first_cut = MyStl::upper_bound(first, middle, *second_cut, comp);
+                len11 = first_cut - first;
+            }
+
+            RandomIt new_middle = MyStl::rotate(first_cut, middle, second_cut);
+            merge_without_buffer(first, first_cut, new_middle, len11, len22, comp);
+
+            first = new_middle;
+            middle = second_cut;
+            len1 -= len11;
+            len2 -= len22;
+        }
+    }
+
+    /* TimSort: the range is cut into natural runs, ascending or strictly descending and then reversed,
+       short ones extended to a minimum length by binary insertion sort. The runs are kept on a stack
+       whose lengths grow at least like the Fibonacci numbers from top to bottom, merging the top ones
+       whenever that breaks, so merges stay balanced. A merge first skips the part of each run that is
+       already in place, then moves the shorter run into a buffer and merges back from the matching
+       end. When one run keeps winning it switches to galloping, searching for how far it wins with
+       exponential then binary search, and moves that whole stretch at once. Positions are kept as
+       offsets from first so that no iterator ever points outside the range */
+    template <typename RandomIt, typename Compare>
+    class Tim_Sorter{
+        private:
+            using T = typename Iterator_Traits<RandomIt>::value_type;
+
+            static constexpr std::ptrdiff_t min_gallop_start = 7;
+
+            struct Run{
+                std::ptrdiff_t base, len;
+            };
+
+            RandomIt _first;
+            Compare& _comp;
+            std::ptrdiff_t _min_gallop = min_gallop_start;
+            MyStl::Vector<T> _buffer;
+            MyStl::Vector<Run> _runs;
+
+        public:
+            Tim_Sorter(RandomIt first, Compare& comp): _first(first), _comp(comp) {}
+
+            void sort(std::ptrdiff_t n){
+                std::ptrdiff_t min_run = min_run_length(n), lo = 0;
+                while (lo < n){
+                    std::ptrdiff_t run = count_run(lo, n);
+                    if (run < min_run){
+                        std::ptrdiff_t forced = n - lo < min_run ? n - lo : min_run;
+                        binary_insertion_sort(at(lo), at(lo + run), at(lo + forced), _comp);
+                        run = forced;
+                    }
+
+                    _runs.push_back(Run{lo, run});
+                    merge_collapse();
+                    lo += run;
+                }
+
+                while (_runs.size() > 1){
+                    std::size_t i = _runs.size() - 2;
+                    if (i > 0 && _runs[i - 1].len < _runs[i + 1].len) --i;
+                    merge_at(i);
+                }
+            }
+
+            // the length of the run at the start of [lo, n), a descending one is reversed first
+            std::ptrdiff_t count_run(std::ptrdiff_t lo, std::ptrdiff_t n){
+                std::ptrdiff_t hi = lo + 1;
+                if (hi == n) return 1;
+
+                if (_comp(*at(hi), *at(lo))){
+                    for (++hi; hi < n && _comp(*at(hi), *at(hi - 1)); ++hi) {}
+                    MyStl::reverse(at(lo), at(hi));
+                }else{
+                    for (++hi; hi < n && !_comp(*at(hi), *at(hi - 1)); ++hi) {}
+                }
+
+                return hi - lo;
+            }
+
+        private:
+            RandomIt at(std::ptrdiff_t i) const {return _first + i;}
+
+            // between 32 and 64, such that n / min_run is a power of two or just below one
+            static std::ptrdiff_t min_run_length(std::ptrdiff_t n){
+                std::ptrdiff_t odd = 0;
+                while (n >= MYSTL_STABLE_SORT_MIN_MERGE){
+                    odd |= n & 1;
+                    n >>= 1;
+                }
+
+                return n + odd;
+            }
+
+            /* with runs A, B, C from the top of the stack down, keeps len(C) > len(B) + len(A) and
+               len(B) > len(A), also for the runs below C which the original TimSort overlooked */
+            void merge_collapse(){
+                while (_runs.size() > 1){
+                    std::size_t i = _runs.size() - 2;
+                    if ((i > 0 && _runs[i - 1].len <= _runs[i].len + _runs[i + 1].len)
+                        || (i > 1 && _runs[i - 2].len <= _runs[i - 1].len + _runs[i].len)){
+                        if (_runs[i - 1].len < _runs[i + 1].len) --i;
+                    }else if (_runs[i].len > _runs[i + 1].len){
+                        break;
+                    }
+                    merge_at(i);
+                }
+            }
+
+            void merge_at(std::size_t i){
+                std::ptrdiff_t base1 = _runs[i].base, len1 = _runs[i].len;
+                std::ptrdiff_t base2 = _runs[i + 1].base, len2 = _runs[i + 1].len;
+                _runs[i].len = len1 + len2;
+                if (i + 3 == _runs.size()) _runs[i + 1] = _runs[i + 2];
+                _runs.pop_back();
+
+                // what of the first run is smaller than the second's first element is in place already
+                std::ptrdiff_t k = gallop_right(*at(base2), at(base1), len1, 0);
+                base1 += k;
+                len1 -= k;
+                if (len1 == 0) return;
+
+                // as is what of the second run is larger than the first's last element
+                len2 = gallop_left(*at(base1 + len1 - 1), at(base2), len2, len2 - 1);
+                if (len2 == 0) return;
+
+                if (!reserve_buffer(len1 < len2 ? len1 : len2)){
+                    merge_without_buffer(at(base1), at(base2), at(base2 + len2), len1, len2, _comp);
+                }else if (len1 <= len2){
+                    merge_lo(base1, len1, base2, len2);
+                }else{
+                    merge_hi(base1, len1, base2, len2);
+                }
+            }
+
+            bool reserve_buffer(std::ptrdiff_t len){
+                _buffer.clear();
+                try {
+                    _buffer.reserve(len);
+                } catch (const std::bad_alloc&) {
+                    return false;
+                }
+
+                return true;
+            }
+
+            /* the leftmost position in the sorted [base, base + len) that key could be inserted at, the
+               search starts at hint and gallops out from there */
+            template <typename Iter>
+            std::ptrdiff_t gallop_left(const T& key, Iter base, std::ptrdiff_t len, std::ptrdiff_t hint){
+                std::ptrdiff_t last_ofs = 0, ofs = 1;
+                if (_comp(*(base + hint), key)){
+                    // base[hint + last_ofs] < key <= base[hint + ofs]
+                    std::ptrdiff_t max_ofs = len - hint;
+                    while (ofs < max_ofs && _comp(*(base + (hint + ofs)), key)){
+                        last_ofs = ofs;
+                        ofs = 2 * ofs + 1;
+                    }
+                    if (ofs > max_ofs) ofs = max_ofs;
+                    last_ofs += hint;
+                    ofs += hint;
+                }else{
+                    // base[hint - ofs] < key <= base[hint - last_ofs]
+                    std::ptrdiff_t max_ofs = hint + 1;
+                    while (ofs < max_ofs && !_comp(*(base + (hint - ofs)), key)){
+                        last_ofs = ofs;
+                        ofs = 2 * ofs + 1;
+                    }
+                    if (ofs > max_ofs) ofs = max_ofs;
+                    std::ptrdiff_t tmp = last_ofs;
+                    last_ofs = hint - ofs;
+                    ofs = hint - tmp;
+                }
+
+                for (++last_ofs; last_ofs < ofs; ){
+                    std::ptrdiff_t mid = last_ofs + (ofs - last_ofs) / 2;
+                    if (_comp(*(base + mid), key)) last_ofs = mid + 1;
+                    else ofs = mid;
+                }
+                return ofs;
+            }
+
+            // the rightmost position key could be inserted at
+            template <typename Iter>
+            std::ptrdiff_t gallop_right(const T& key, Iter base, std::ptrdiff_t len, std::ptrdiff_t hint){
+                std::ptrdiff_t last_ofs = 0, ofs = 1;
+                if (_comp(key, *(base + hint))){
+                    // base[hint - ofs] <= key < base[hint - last_ofs]
+                    std::ptrdiff_t max_ofs = hint + 1;
+                    while (ofs < max_ofs && _comp(key, *(base + (hint - ofs)))){
+                        last_ofs = ofs;
+                        ofs = 2 * ofs + 1;
+                    }
+                    if (ofs > max_ofs) ofs = max_ofs;
+                    std::ptrdiff_t tmp = last_ofs;
+                    last_ofs = hint - ofs;
+                    ofs = hint - tmp;
+                }else{
+                    // base[hint + last_ofs] <= key < base[hint + ofs]
+                    std::ptrdiff_t max_ofs = len - hint;
+                    while (ofs < max_ofs && !_comp(key, *(base + (hint + ofs)))){
+                        last_ofs = ofs;
+                        ofs = 2 * ofs + 1;
+                    }
+                    if (ofs > max_ofs) ofs = max_ofs;
+                    last_ofs += hint;
+                    ofs += hint;
+                }
+
+                for (++last_ofs; last_ofs < ofs; ){
+                    std::ptrdiff_t mid = last_ofs + (ofs - last_ofs) / 2;
+                    if (_comp(key, *(base + mid))) ofs = mid;
+                    else last_ofs = mid + 1;
+                }
+                return ofs;
+            }
+
+            void move_forward(std::ptrdiff_t from, std::ptrdiff_t count, std::ptrdiff_t to){
+                for (std::ptrdiff_t i = 0; i < count; ++i) *at(to + i) = std::move(*at(from + i));
+            }
+
+            void move_backward(std::ptrdiff_t from, std::ptrdiff_t count, std::ptrdiff_t to){
+                for (std::ptrdiff_t i = count; i > 0; --i) *at(to + i - 1) = std::move(*at(from + i - 1));
+            }
+
+            void move_from_buffer(std::ptrdiff_t from, std::ptrdiff_t count, std::ptrdiff_t to){
+                for (std::ptrdiff_t i = 0; i < count; ++i) *at(to + i) = std::move(_buffer[from + i]);
+            }
+
+            /* the first run is the shorter one and goes into the buffer, the merge fills the range from
+               the left. Its first element is known to come from the second run and its last from the first */
+            void merge_lo(std::ptrdiff_t base1, std::ptrdiff_t len1, std::ptrdiff_t base2, std::ptrdiff_t len2){
+                for (std::ptrdiff_t i = 0; i < len1; ++i) _buffer.push_back(std::move(*at(base1 + i)));
+                T* tmp = _buffer.data();
+                std::ptrdiff_t cursor1 = 0, cursor2 = base2, dest = base1;
+
+                *at(dest++) = std::move(*at(cursor2++));
+                if (--len2 == 0) return move_from_buffer(cursor1, len1, dest);
+                if (len1 == 1){
+                    move_forward(cursor2, len2, dest);
+                    *at(dest + len2) = std::move(tmp[cursor1]);
+                    return;
+                }
+
+                std::ptrdiff_t min_gallop = _min_gallop;
+                while (true){
+                    std::ptrdiff_t count1 = 0, count2 = 0;
+                    bool done = false;
+
+                    // one element at a time until one side wins min_gallop times in a row
+                    do {
+                        if (_comp(*at(cursor2), tmp[cursor1])){
+                            *at(dest++) = std::move(*at(cursor2++));
+                            ++count2;
+                            count1 = 0;
+                            if (--len2 == 0){done = true; break;}
+                        }else{
+                            *at(dest++) = std::move(tmp[cursor1++]);
+                            ++count1;
+                            count2 = 0;
+                            if (--len1 == 1){done = true; break;}
+                        }
+                    } while ((count1 | count2) < min_gallop);
+                    if (done) break;
+
+                    // galloping, for as long as it finds stretches worth it
+                    do {
+                        count1 = gallop_right(*at(cursor2), tmp + cursor1, len1, 0);
+                        if (count1 != 0){
+                            move_from_buffer(cursor1, count1, dest);
+                            dest += count1;
+                            cursor1 += count1;
+                            len1 -= count1;
+                            if (len1 <= 1){done = true; break;}
+                        }
+                        *at(dest++) = std::move(*at(cursor2++));
+                        if (--len2 == 0){done = true; break;}
+
+                        count2 = gallop_left(tmp[cursor1], at(cursor2), len2, 0);
+                        if (count2 != 0){
+                            move_forward(cursor2, count2, dest);
+                            dest += count2;
+                            cursor2 += count2;
+                            len2 -= count2;
+                            if (len2 == 0){done = true; break;}
+                        }
+                        *at(dest++) = std::move(tmp[cursor1++]);
+                        if (--len1 == 1){done = true; break;}
+
+                        --min_gallop;
+                    } while (count1 >= min_gallop_start || count2 >= min_gallop_start);
+                    if (done) break;
+
+                    // leaving gallop mode costs a little more the next time round
+                    if (min_gallop < 0) min_gallop = 0;
+                    min_gallop += 2;
+                }
+                _min_gallop = min_gallop < 1 ? 1 : min_gallop;
+
+                if (len1 == 1){
+                    move_forward(cursor2, len2, dest);
+                    *at(dest + len2) = std::move(tmp[cursor1]);
+                }else{
+                    // len1 is only 0 here if comp is not a strict weak order
+                    move_from_buffer(cursor1, len1, dest);
+                }
+            }
+
+            /* the mirror image: the second run is the shorter one and goes into the buffer, the merge
+               fills the range from the right. Its last element is known to come from the first run */
+            void merge_hi(std::ptrdiff_t base1, std::ptrdiff_t len1, std::ptrdiff_t base2, std::ptrdiff_t len2){
+                for (std::ptrdiff_t i = 0; i < len2; ++i) _buffer.push_back(std::move(*at(base2 + i)));
+                T* tmp = _buffer.data();
+                std::ptrdiff_t cursor1 = base1 + len1 - 1, cursor2 = len2 - 1, dest = base2 + len2 - 1;
+
+                *at(dest--) = std::move(*at(cursor1--));
+                if (--len1 == 0) return move_from_buffer(0, len2, dest - (len2 - 1));
+                if (len2 == 1){
+                    dest -= len1;
+                    cursor1 -= len1;
+                    move_backward(cursor1 + 1, len1, dest + 1);
+                    *at(dest) = std::move(tmp[cursor2]);
+                    return;
+                }
+
+                std::ptrdiff_t min_gallop = _min_gallop;
+                while (true){
+                    std::ptrdiff_t count1 = 0, count2 = 0;
+                    bool done = false;
+
+                    do {
+                        if (_comp(tmp[cursor2], *at(cursor1))){
+                            *at(dest--) = std::move(*at(cursor1--));
+                            ++count1;
+                            count2 = 0;
+                            if (--len1 == 0){done = true; break;}
+                        }else{
+                            *at(dest--) = std::move(tmp[cursor2--]);
+                            ++count2;
+                            count1 = 0;
+                            if (--len2 == 1){done = true; break;}
+                        }
+                    } while ((count1 | count2) < min_gallop);
+                    if (done) break;
+
+                    do {
+                        count1 = len1 - gallop_right(tmp[cursor2], at(base1), len1, len1 - 1);
+                        if (count1 != 0){
+                            dest -= count1;
+                            cursor1 -= count1;
+                            len1 -= count1;
+                            move_backward(cursor1 + 1, count1, dest + 1);
+                            if (len1 == 0){done = true; break;}
+                        }
+                        *at(dest--) = std::move(tmp[cursor2--]);
+                        if (--len2 == 1){done = true; break;}
+
+                        count2 = len2 - gallop_left(*at(cursor1), tmp, len2, len2 - 1);
+                        if (count2 != 0){
+                            dest -= count2;
+                            cursor2 -= count2;
+                            len2 -= count2;
+                            move_from_buffer(cursor2 + 1, count2, dest + 1);
+                            if (len2 <= 1){done = true; break;}
+                        }
+                        *at(dest--) = std::move(*at(cursor1--));
+                        if (--len1 == 0){done = true; break;}
+
+                        --min_gallop;
+                    } while (count1 >= min_gallop_start || count2 >= min_gallop_start);
+                    if (done) break;
+
+                    if (min_gallop < 0) min_gallop = 0;
+                    min_gallop += 2;
+                }
+                _min_gallop = min_gallop < 1 ? 1 : min_gallop;
+
+                if (len2 == 1){
+                    dest -= len1;
+                    cursor1 -= len1;
+                    move_backward(cursor1 + 1, len1, dest + 1);
+                    *at(dest) = std::move(tmp[cursor2]);
+                }else{
+                    move_from_buffer(0, len2, dest - (len2 - 1));
+                }
+            }
+    };
+
+    template <typename RandomIt, typename Compare>
+    void stable_sort_unchecked(RandomIt first, RandomIt last, Compare& comp, Random_Access_Iterator_Tag){
+        std::ptrdiff_t n = last - first;
+        if (n < 2) return;
+
+        Tim_Sorter<RandomIt, Compare> sorter(first, comp);
+        if (n < MYSTL_STABLE_SORT_MIN_MERGE){
+            binary_insertion_sort(first, first + sorter.count_run(0, n), last, comp);
+            return;
+        }
+        sorter.sort(n);
+    }
+
+    /* stable, O(n log n) comparisons at worst and O(n) when the range is made of a few sorted or
+       reversed stretches, e.g. a sorted range with new elements appended. Takes a buffer of up to
+       half the range, if that can't be had a merge falls back to rotating the elements in place */
+    template <typename RandomIt, typename Compare>
+    void stable_sort(RandomIt first, RandomIt last, Compare comp){
+        static_assert(Is_Random_Access_Iterator<RandomIt>::value, "MyStl::stable_sort needs random access iterators");
+        stable_sort_unchecked(first, last, comp, typename Iterator_Traits<RandomIt>::iterator_category());
+    }
+
+    template <typename RandomIt>
+    void stable_sort(RandomIt first, RandomIt last){
+        MyStl::stable_sort(first, last, std::less<typename Iterator_Traits<RandomIt>::value_type>());
+    }
+
+    /* leaves the smallest middle - first elements of the range in [first, middle) as a max heap, by
+       keeping a heap of the smallest seen so far and replacing its top by anything smaller */
+    template <typename RandomIt, typename Compare>
+    void heap_select(RandomIt first, RandomIt middle, RandomIt last, Compare& comp){
+        using T = typename Iterator_Traits<RandomIt>::value_type;
+        std::ptrdiff_t len = middle - first;
+        heap_make<2>(first, len, comp);
+
+        for (RandomIt it = middle; it != last; ++it){
+            if (!comp(*it, *first)) continue;
+
+            T value = std::move(*it);
+            *it = std::move(*first);
+            heap_sift_down<2>(first, 0, len, std::move(value), comp);
+        }
+    }
+
+    /* introselect: quickselect with the pivots and partitions of sort, narrowing down on the side
+       nth is in. After 2 log n partitions it finishes with heap_select, which bounds the worst case
+       by n log n. leftmost is false when there is an element before begin not greater than any in
+       the range, then a pivot equal to it sets all its equals aside in one go as in sort */
+    template <typename RandomIt, typename Compare>
+    void nth_element_unchecked(RandomIt begin, RandomIt nth, RandomIt end, Compare& comp, Random_Access_Iterator_Tag){
+        if (end - begin < 2 || nth == end) return;
+
+        int depth = 0;
+        for (std::ptrdiff_t n = end - begin; n > 1; n >>= 1) depth += 2;
+
+        constexpr std::ptrdiff_t ninther_threshold = 128;
+        bool leftmost = true;
+        while (end - begin >= MYSTL_INSERTION_SORT_THRESHOLD){
+            if (depth-- == 0){
+                heap_select(begin, nth + 1, end, comp);
+                MyStl::iter_swap(begin, nth);
+                return;
+            }
+
+            std::ptrdiff_t half = (end - begin) / 2;
+            if (end - begin > ninther_threshold){
+                sort3(begin, begin + half, end - 1, comp);
+                sort3(begin + 1, begin + (half - 1), end - 2, comp);
+                sort3(begin + 2, begin + (half + 1), end - 3, comp);
+                sort3(begin + (half - 1), begin + half, begin + (half + 1), comp);
+                MyStl::iter_swap(begin, begin + half);
+            }else{
+                sort3(begin + half, begin, end - 1, comp);
+            }
+
+            if (!leftmost && !comp(*(begin - 1), *begin)){
+                RandomIt pivot_pos = partition_left(begin, end, comp);
+                if (nth <= pivot_pos) return;
+                begin = pivot_pos + 1;
+                continue;
+            }
+
+            RandomIt pivot_pos = partition_right(begin, end, comp).first;
+            if (nth == pivot_pos) return;
+            if (nth < pivot_pos){
+                end = pivot_pos;
+            }else{
+                begin = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+
+        if (leftmost) insertion_sort(begin, end, comp);
+        else unguarded_insertion_sort(begin, end, comp);
+    }
+
+    /* puts the element that belongs at nth in sorted order there, with none greater before it and
+       none smaller after it. O(n) on average, O(n log n) at worst */
+    template <typename RandomIt, typename Compare>
+    void nth_element(RandomIt first, RandomIt nth, RandomIt last, Compare comp){
+        static_assert(Is_Random_Access_Iterator<RandomIt>::value, "MyStl::nth_element needs random access iterators");
+        nth_element_unchecked(first, nth, last, comp, typename Iterator_Traits<RandomIt>::iterator_category());
+    }
+
+    template <typename RandomIt>
+    void nth_element(RandomIt first, RandomIt nth, RandomIt last){
+        MyStl::nth_element(first, nth, last, std::less<typename Iterator_Traits<RandomIt>::value_type>());
+    }
+
+    // the smallest middle - first elements of the range sorted in [first, middle), the rest in no particular order after
+    template <typename RandomIt, typename Compare>
+    void partial_sort(RandomIt first, RandomIt middle, RandomIt last, Compare comp){
+        static_assert(Is_Random_Access_Iterator<RandomIt>::value, "MyStl::partial_sort needs random access iterators");
+        if (first == middle) return;
+
+        heap_select(first, middle, last, comp);
+        heap_sort<2>(first, middle - first, comp);
+    }
+
+    template <typename RandomIt>
+    void partial_sort(RandomIt first, RandomIt middle, RandomIt last){
+        MyStl::partial_sort(first, middle, last, std::less<typename Iterator_Traits<RandomIt>::value_type>());
+    }
+
+    /* copies the smallest min(last - first, d_last - d_first) elements of [first, last) sorted to
+       d_first and returns the end of what was written. The input is read once, front to back */
+    template <typename InputIt, typename RandomIt, typename Compare>
+    RandomIt partial_sort_copy(InputIt first, InputIt last, RandomIt d_first, RandomIt d_last, Compare comp){
+        static_assert(Is_Random_Access_Iterator<RandomIt>::value, "MyStl::partial_sort_copy needs a random access output");
+        using T = typename Iterator_Traits<RandomIt>::value_type;
+
+        RandomIt d_end = d_first;
+        for (; first != last && d_end != d_last; ++first, ++d_end) *d_end = *first;
+        std::ptrdiff_t len = d_end - d_first;
+        if (len == 0) return d_end;
+
+        heap_make<2>(d_first, len, comp);
+        for (; first != last; ++first){
+            if (comp(*first, *d_first)) heap_sift_down<2>(d_first, 0, len, T(*first), comp);
+        }
+        heap_sort<2>(d_first, len, comp);
+        return d_end;
+    }
+
+    template <typename InputIt, typename RandomIt>
+    RandomIt partial_sort_copy(InputIt first, InputIt last, RandomIt d_first, RandomIt d_last){
+        return MyStl::partial_sort_copy(first, last, d_first, d_last, std::less<typename Iterator_Traits<RandomIt>::value_type>());
+    }
+
+    /* keeps the k greatest values pushed into it, or the k smallest with std::greater, in O(log k)
+       per push and O(k) memory however many values go by. They are held in a heap with the least of
+       them on top, so a new value only has to beat that one to get in */
+    template <typename T, typename Compare = std::less<T>>
+    class Top_K{
+        public:
+            using value_type = T;
+            using size_type = std::size_t;
+            using const_reference = const value_type&;
+
+        private:
+            // orders the heap so that its top is the least by Compare
+            struct Reversed{
+                Compare comp;
+
+                bool operator()(const T& lhs, const T& rhs) {return comp(rhs, lhs);}
+            };
+
+            MyStl::Vector<T> _heap;
+            size_type _k;
+            Reversed _reversed;
+
+        public:
+            /* ctors */
+            explicit Top_K(size_type k, const Compare& comp = Compare()): _k(k), _reversed{comp} {
+                _heap.reserve(k);
+            }
+
+        public:
+            /* capacity */
+            size_type k() const noexcept {return _k;}
+
+            size_type size() const noexcept {return _heap.size();}
+
+            bool empty() const noexcept {return _heap.empty();}
+
+        public:
+            /* element access */
+            // the least of the values kept, a new one has to be greater to get in once there are k
+            const_reference threshold() const {return _heap.front();}
+
+            // the values kept, in no particular order
+            const MyStl::Vector<T>& values() const noexcept {return _heap;}
+
+            // the values kept from the greatest down
+            MyStl::Vector<T> sorted() const {
+                MyStl::Vector<T> result(_heap);
+                Reversed reversed = _reversed;
+                heap_sort<2>(result.begin(), static_cast<std::ptrdiff_t>(result.size()), reversed);
+                return result;
+            }
+
+        public:
+            /* modifiers */
+            void push(const value_type& value){emplace(value);}
+
+            void push(value_type&& value){emplace(std::move(value));}
+
+            template <typename InputIt,
+                      typename std::enable_if<MyStl::Is_Input_Iterator<InputIt>::value, bool>::type = true>
+            void push(InputIt first, InputIt last){
+                for (; first != last; ++first) emplace(*first);
+            }
+
+            // a value that doesn't make it is not kept, whether it's constructed at all depends on the comparison
+            template <typename... Args>
+            void emplace(Args&&... args){
+                if (_k == 0) return;
+
+                if (_heap.size() < _k){
+                    _heap.emplace_back(std::forward<Args>(args)...);
+                    heap_push<2>(_heap.begin(), static_cast<std::ptrdiff_t>(_heap.size()), _reversed);
+                    return;
+                }
+
+                T value(std::forward<Args>(args)...);
+                if (_reversed.comp(_heap.front(), value)){
+                    heap_sift_down<2>(_heap.begin(), 0, static_cast<std::ptrdiff_t>(_heap.size()), std::move(value), _reversed);
+                }
+            }
+
+            void clear() noexcept {_heap.clear();}
+    };
+
+    // the k greatest elements of [first, last) by comp, from the greatest down, reading the range once
+    template <typename InputIt, typename Compare>
+    MyStl::Vector<typename Iterator_Traits<InputIt>::value_type> top_k(InputIt first, InputIt last, std::size_t k, Compare comp){
+        Top_K<typename Iterator_Traits<InputIt>::value_type, Compare> top(k, comp);
+        top.push(first, last);
+        return top.sorted();
+    }
+
+    template <typename InputIt>
+    MyStl::Vector<typename Iterator_Traits<InputIt>::value_type> top_k(InputIt first, InputIt last, std::size_t k){
+        return MyStl::top_k(first, last, k, std::less<typename Iterator_Traits<InputIt>::value_type>());
+    }
+}
+
+#endif
@@ -0,0 +1,192 @@
+#ifndef MYSTL_SPSCRING_H
+#define MYSTL_SPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Iterator.h"
+
+// indices written by different threads are kept this many bytes apart so they don't share a cache line
+#ifndef MYSTL_CACHE_LINE_SIZE
+#define MYSTL_CACHE_LINE_SIZE 64
+#endif
+
+namespace MyStl{
+    /* bounded queue between exactly one producer thread and one consumer thread, without locks.
+       The capacity is rounded up to a power of two and fixed at construction. push and emplace may
+       only be called from the producer, pop from the consumer; size and empty are only a snapshot
+       when the other thread is running. The batch versions publish all their elements with a single
+       atomic store, which is where most of the throughput over single pushes comes from */
+    template <typename T, typename Alloc = std::allocator<T>>
+    class SpscRing{
+        public:
+            using value_type = T;
+            using allocator_type = Alloc;
+            using size_type = std::size_t;
+            using reference = value_type&;
+            using const_reference = const value_type&;
+            using pointer = typename std::allocator_traits<Alloc>::pointer;
+
+            static_assert(std::is_same<pointer, T*>::value, "SpscRing only supports allocators with raw pointers");
+
+        private:
+            using alloc_traits = std::allocator_traits<Alloc>;
+
+            /* head and tail only ever grow, slot i lives at _slots[i & _mask]. Each side keeps the
+               other side's index as last seen and only reloads it when that looks full or empty */
+            alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<size_type> _head{0};    // next slot to pop, written by the consumer
+            size_type _cached_tail = 0;
+            alignas(MYSTL_CACHE_LINE_SIZE) std::atomic<size_type> _tail{0};    // next slot to push, written by the producer
+            size_type _cached_head = 0;
+            alignas(MYSTL_CACHE_LINE_SIZE) pointer _slots = nullptr;
+            size_type _mask = 0;
+            Alloc _alloc;
+
+        public:
+            /* ctors and dtor */
+            explicit SpscRing(size_type capacity, const Alloc& alloc = Alloc()): _alloc(alloc){
+                if (capacity == 0) throw std::invalid_argument("SpscRing capacity must be positive");
+                if (capacity > max_size()) throw std::length_error("SpscRing capacity exceeds max_size()");
+
+                size_type rounded = 1;
+                while (rounded < capacity) rounded <<= 1;
+                _slots = alloc_traits::allocate(_alloc, rounded);
+                _mask = rounded - 1;
+            }
+
+            // threads still holding a reference could not be told that the ring has moved
+            SpscRing(const SpscRing&) = delete;
+
+            SpscRing& operator=(const SpscRing&) = delete;
+
+            // no other thread may use the ring any more
+            ~SpscRing(){
+                for (size_type i = _head.load(std::memory_order_relaxed), last = _tail.load(std::memory_order_relaxed);
+                     i != last; ++i){
+                    alloc_traits::destroy(_alloc, _slots + (i & _mask));
+                }
+                alloc_traits::deallocate(_alloc, _slots, _mask + 1);
+            }
+
+        public:
+            /* capacity */
+            size_type capacity() const noexcept {return _mask + 1;}
+
+            size_type max_size() const noexcept {
+                size_type alloc_max = alloc_traits::max_size(_alloc);
+                size_type pow2_max = ~(~size_type(0) >> 1);
+                return alloc_max < pow2_max ? alloc_max : pow2_max;
+            }
+
+            size_type size() const noexcept {
+                size_type head = _head.load(std::memory_order_acquire);
+                return _tail.load(std::memory_order_acquire) - head;
+            }
+
+            bool empty() const noexcept {return size() == 0;}
+
+        public:
+            /* producer, returns false and leaves the value alone when the ring is full */
+            bool try_push(const value_type& value){return try_emplace(value);}
+
+            bool try_push(value_type&& value){return try_emplace(std::move(value));}
+
+            template <typename... Args>
+            bool try_emplace(Args&&... args){
+                size_type tail = _tail.load(std::memory_order_relaxed);
+                if (free_slots(tail) == 0) return false;
+
+                alloc_traits::construct(_alloc, _slots + (tail & _mask), std::forward<Args>(args)...);
+                _tail.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            /* moves elements of [first, last) in until the ring is full, returns the first one left
+               behind, e.g. try_push(v.begin(), v.end()) followed by an erase of the moved prefix */
+            template <typename InputIt,
+                      typename std::enable_if<MyStl::Is_Input_Iterator<InputIt>::value, bool>::type = true>
+            InputIt try_push(InputIt first, InputIt last){
+                // a batch is worth a fresh look at the consumer's progress
+                size_type tail = _tail.load(std::memory_order_relaxed);
+                _cached_head = _head.load(std::memory_order_acquire);
+                size_type room = free_slots(tail), pushed = 0;
+
+                try {
+                    for (; pushed < room && first != last; ++pushed, ++first){
+                        alloc_traits::construct(_alloc, _slots + ((tail + pushed) & _mask), std::move(*first));
+                    }
+                } catch (...) {
+                    // what was constructed so far is kept, the consumer may already be waiting for it
+                    _tail.store(tail + pushed, std::memory_order_release);
+                    throw;
+                }
+
+                _tail.store(tail + pushed, std::memory_order_release);
+                return first;
+            }
+
+        public:
+            /* consumer, returns false and leaves value alone when the ring is empty */
+            bool try_pop(value_type& value){
+                size_type head = _head.load(std::memory_order_relaxed);
+                if (used_slots(head) == 0) return false;
+
+                pointer slot = _slots + (head & _mask);
+                value = std::move(*slot);
+                alloc_traits::destroy(_alloc, slot);
+                _head.store(head + 1, std::memory_order_release);
+                return true;
+            }
+
+            /* moves up to max_count elements to the back of out, which may be a Vector, Deque or anything
+               else with push_back, returns how many were moved */
+            template <typename Container>
+            size_type try_pop(Container& out, size_type max_count = size_type(-1)){
+                size_type head = _head.load(std::memory_order_relaxed);
+                _cached_tail = _tail.load(std::memory_order_acquire);
+                size_type count = used_slots(head);
+                if (count > max_count) count = max_count;
+
+                size_type popped = 0;
+                try {
+                    for (; popped < count; ++popped){
+                        pointer slot = _slots + ((head + popped) & _mask);
+                        out.push_back(std::move(*slot));
+                        alloc_traits::destroy(_alloc, slot);
+                    }
+                } catch (...) {
+                    // the element that failed to go in is still in the ring, as are the ones after it
+                    _head.store(head + popped, std::memory_order_release);
+                    throw;
+                }
+
+                _head.store(head + popped, std::memory_order_release);
+                return popped;
+            }
+
+        private:
+            // the producer's view, the real number may only be larger
+            size_type free_slots(size_type tail){
+                if (tail - _cached_head > _mask){
+                    _cached_head = _head.load(std::memory_order_acquire);
+                }
+
+                return _mask + 1 - (tail - _cached_head);
+            }
+
+            // the consumer's view, the real number may only be larger
+            size_type used_slots(size_type head){
+                if (_cached_tail == head){
+                    _cached_tail = _tail.load(std::memory_order_acquire);
+                }
+
+                return _cached_tail - head;
+            }
+    };
+}
+
+#endif
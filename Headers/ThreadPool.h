@@ -0,0 +1,166 @@
+#ifndef MYSTL_THREADPOOL_H
+#define MYSTL_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "Vector.h"
+
+// threads default_pool() spreads work over including the caller, 0 for as many as the hardware has
+#ifndef MYSTL_DEFAULT_POOL_THREADS
+#define MYSTL_DEFAULT_POOL_THREADS 0
+#endif
+
+namespace MyStl{
+    /* a fixed set of worker threads that run one batch of tasks at a time, the tasks being the indices
+       0 to count - 1 of a single function. The thread calling run takes tasks as well and only returns
+       once all of them are done. A run while the pool is busy with another caller's batch, or from
+       inside a task, doesn't wait for the workers but runs its tasks itself, so nesting can't deadlock */
+    class Thread_Pool{
+        public:
+            using size_type = std::size_t;
+
+        private:
+            struct Batch{
+                void (*call)(void*, size_type);
+                void* func;
+                size_type count;
+                std::atomic<size_type> next{0};
+                std::atomic<bool> failed{false};
+                std::exception_ptr error;            // written by whoever set failed first
+                size_type busy = 0;                  // workers inside the batch, guarded by _mutex
+            };
+
+            MyStl::Vector<std::thread> _workers;
+            std::mutex _mutex;
+            std::condition_variable _wake;           // workers wait here for a batch
+            std::condition_variable _idle;           // the caller waits here for the workers to leave
+            Batch* _batch = nullptr;
+            std::size_t _generation = 0;
+            bool _stop = false;
+            std::mutex _submit;                      // held by the caller whose batch is running
+
+        public:
+            /* ctors and dtor */
+            explicit Thread_Pool(size_type workers){
+                _workers.reserve(workers);
+                try {
+                    for (size_type i = 0; i < workers; ++i) _workers.emplace_back([this](){work();});
+                } catch (...) {
+                    shut_down();
+                    throw;
+                }
+            }
+
+            Thread_Pool(const Thread_Pool&) = delete;
+
+            Thread_Pool& operator=(const Thread_Pool&) = delete;
+
+            // no run may be in progress
+            ~Thread_Pool(){shut_down();}
+
+            // shared by the parallel algorithms, with one worker less than the threads wanted since the caller works too
+            static Thread_Pool& default_pool(){
+                static Thread_Pool pool(default_workers());
+                return pool;
+            }
+
+        public:
+            /* capacity, how many threads a batch may be spread over including the caller */
+            size_type concurrency() const noexcept {return _workers.size() + 1;}
+
+        public:
+            /* calls func(i) for every i in [0, count) and returns when all calls have returned. If any
+               call throws, tasks not started yet are skipped and the first exception is rethrown here */
+            template <typename F>
+            void run(size_type count, F& func){
+                Batch batch;
+                batch.call = [](void* f, size_type i){(*static_cast<F*>(f))(i);};
+                batch.func = static_cast<void*>(&func);
+                batch.count = count;
+
+                bool shared = count > 1 && !_workers.empty() && !inside_task() && _submit.try_lock();
+                if (shared){
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _batch = &batch;
+                        ++_generation;
+                    }
+                    _wake.notify_all();
+                }
+
+                bool was_inside = inside_task();
+                inside_task() = true;
+                take_tasks(batch);
+                inside_task() = was_inside;
+
+                if (shared){
+                    {
+                        // the batch lives on this stack frame, no worker may still be looking at it
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        _batch = nullptr;
+                        _idle.wait(lock, [&batch](){return batch.busy == 0;});
+                    }
+                    _submit.unlock();
+                }
+
+                if (batch.error) std::rethrow_exception(batch.error);
+            }
+
+        private:
+            static size_type default_workers(){
+                size_type threads = MYSTL_DEFAULT_POOL_THREADS > 0 ? MYSTL_DEFAULT_POOL_THREADS : std::thread::hardware_concurrency();
+                return threads > 1 ? threads - 1 : 0;
+            }
+
+            static bool& inside_task(){
+                thread_local bool inside = false;
+                return inside;
+            }
+
+            static void take_tasks(Batch& batch){
+                for (size_type i; (i = batch.next.fetch_add(1, std::memory_order_relaxed)) < batch.count; ){
+                    if (batch.failed.load(std::memory_order_relaxed)) continue;
+
+                    try {
+                        batch.call(batch.func, i);
+                    } catch (...) {
+                        if (!batch.failed.exchange(true)) batch.error = std::current_exception();
+                    }
+                }
+            }
+
+            void work(){
+                inside_task() = true;
+                std::size_t seen = 0;
+                std::unique_lock<std::mutex> lock(_mutex);
+                while (true){
+                    _wake.wait(lock, [this, &seen](){return _stop || (_batch && _generation != seen);});
+                    if (_stop) return;
+
+                    seen = _generation;
+                    Batch* batch = _batch;
+                    ++batch->busy;
+                    lock.unlock();
+                    take_tasks(*batch);
+                    lock.lock();
+                    if (--batch->busy == 0) _idle.notify_all();
+                }
+            }
+
+            void shut_down(){
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _stop = true;
+                }
+                _wake.notify_all();
+                for (std::thread& worker : _workers) worker.join();
+            }
+    };
+}
+
+#endif
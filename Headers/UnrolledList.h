@@ -0,0 +1,694 @@
+#ifndef MYSTL_UNROLLEDLIST_H
+#define MYSTL_UNROLLEDLIST_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "Iterator.h"
+#include "Algorithm.h"
+
+namespace MyStl{
+    // elements per chunk when a chunk holds about 512 bytes of them, kept between 16 and 64
+    template <typename T>
+    struct Unrolled_Chunk_Size : std::integral_constant<std::size_t,
+        512 / sizeof(T) < 16 ? 16 : (512 / sizeof(T) > 64 ? 64 : 512 / sizeof(T))> {};
+
+    template<typename T, typename Alloc = std::allocator<T>, std::size_t ChunkSize = Unrolled_Chunk_Size<T>::value>
+    class UnrolledList;
+
+    // the links, the list's sentinel is a bare Chunk_Base with no elements
+    struct Chunk_Base{
+        Chunk_Base* _previous;
+        Chunk_Base* _next;
+        std::size_t _count;     //elements in use, always at the front of the chunk
+
+        void set_init_status(){
+            _previous = _next = this;
+            _count = 0;
+        }
+    };
+
+    template<typename T, std::size_t ChunkSize>
+    struct Chunk: public Chunk_Base{
+        alignas(T) unsigned char _storage[sizeof(T) * ChunkSize];
+
+        T* data() noexcept {return reinterpret_cast<T*>(_storage);}
+    };
+
+    template<typename T, typename Reference, typename Pointer, std::size_t ChunkSize>
+    class Unrolled_List_Iterator: public MyStl::Iterator<Bidirectional_Iterator_Tag, T, std::ptrdiff_t, Pointer, Reference>{
+        template<typename, typename, std::size_t> friend class UnrolledList;
+        template<typename, typename, typename, std::size_t> friend class Unrolled_List_Iterator;
+        template<typename> friend struct Segmented_Iterator_Traits;
+        public:
+            using value_type = T;
+            using reference = Reference;
+            using pointer = Pointer;
+            using base_ptr = Chunk_Base*;
+            using chunk_ptr = Chunk<T, ChunkSize>*;
+
+        private:
+            base_ptr _chunk;
+            std::size_t _index;     //0 in the end iterator, whose _chunk is the sentinel
+
+        public:
+            Unrolled_List_Iterator() = default;
+
+            Unrolled_List_Iterator(base_ptr chunk, std::size_t index): _chunk(chunk), _index(index){}
+
+            //iterator to const_iterator
+            template<typename R, typename P,
+                     typename std::enable_if<std::is_convertible<P, Pointer>::value, bool>::type = true>
+            Unrolled_List_Iterator(const Unrolled_List_Iterator<T, R, P, ChunkSize>& other)
+                : _chunk(other._chunk), _index(other._index){}
+
+            reference operator*() const {return static_cast<chunk_ptr>(_chunk)->data()[_index];}
+
+            pointer operator->() const {return &(operator*());}
+
+            Unrolled_List_Iterator& operator++(){
+                assert(_chunk);
+                if (++_index == _chunk->_count){
+                    _chunk = _chunk->_next;
+                    _index = 0;
+                }
+                return *this;
+            }
+
+            Unrolled_List_Iterator& operator--(){
+                assert(_chunk);
+                if (_index == 0){
+                    _chunk = _chunk->_previous;
+                    _index = _chunk->_count;
+                }
+                --_index;
+                return *this;
+            }
+
+            Unrolled_List_Iterator operator++(int){
+                auto temp = *this;
+                ++(*this);
+                return temp;
+            }
+
+            Unrolled_List_Iterator operator--(int){
+                auto temp = *this;
+                --(*this);
+                return temp;
+            }
+
+            bool operator==(const Unrolled_List_Iterator& rhs) const {
+                return _chunk == rhs._chunk && _index == rhs._index;
+            }
+
+            bool operator != (const Unrolled_List_Iterator& rhs) const {
+                return !(*this == rhs);
+            }
+    };
+
+    // walks the chunks of an UnrolledList, the segments of its iterators
+    struct Unrolled_Chunk_Walker{
+        Chunk_Base* _chunk;
+
+        Unrolled_Chunk_Walker& operator++(){
+            _chunk = _chunk->_next;
+            return *this;
+        }
+
+        bool operator==(const Unrolled_Chunk_Walker& rhs) const {return _chunk == rhs._chunk;}
+
+        bool operator!=(const Unrolled_Chunk_Walker& rhs) const {return _chunk != rhs._chunk;}
+    };
+
+    // every chunk is a segment, so copy, fill, equal and for_each run over raw pointer ranges
+    template<typename T, typename Reference, typename Pointer, std::size_t ChunkSize>
+    struct Segmented_Iterator_Traits<Unrolled_List_Iterator<T, Reference, Pointer, ChunkSize>> : std::true_type {
+        using iterator = Unrolled_List_Iterator<T, Reference, Pointer, ChunkSize>;
+        using segment_iterator = Unrolled_Chunk_Walker;
+        using local_iterator = Pointer;
+
+        static segment_iterator segment(const iterator& it) {return {it._chunk};}
+
+        static local_iterator local(const iterator& it) {return begin(segment(it)) + it._index;}
+
+        static local_iterator begin(segment_iterator seg) {return static_cast<Chunk<T, ChunkSize>*>(seg._chunk)->data();}
+
+        static local_iterator end(segment_iterator seg) {return begin(seg) + seg._chunk->_count;}
+
+        static iterator compose(segment_iterator seg, local_iterator local) {
+            if (local == end(seg)) return iterator(seg._chunk->_next, 0);
+            return iterator(seg._chunk, local - begin(seg));
+        }
+    };
+
+    /* doubly-linked list of chunks that each hold up to ChunkSize elements next to each other, so
+       iterating touches one cache line after another like a Vector and only jumps at the end of a
+       chunk. Inserting or erasing shifts at most the elements of one chunk, a full chunk is split
+       in two and a chunk that gets nearly empty takes over the next one if they fit.
+       Inserting or erasing invalidates iterators into the chunks involved and after them within
+       those chunks, iterators into other chunks stay valid, also across a splice. The sentinel
+       lives in the list itself, so end() is invalidated by a move or swap */
+    template<typename T, typename Alloc, std::size_t ChunkSize>
+    class UnrolledList{
+        public:
+        /* type defs */
+            using value_type = T;
+            using allocator_type = Alloc;
+            using size_type = std::size_t;
+            using difference_type = std::ptrdiff_t;
+            using reference = value_type&;
+            using const_reference = const value_type&;
+            using pointer = typename std::allocator_traits<Alloc>::pointer;
+            using const_pointer = typename std::allocator_traits<Alloc>::const_pointer;
+            using iterator = Unrolled_List_Iterator<T, T&, T*, ChunkSize>;
+            using const_iterator = Unrolled_List_Iterator<T, const T&, const T*, ChunkSize>;
+            using reverse_iterator = Reverse_Iterator<iterator>;
+            using const_reverse_iterator = Reverse_Iterator<const_iterator>;
+
+            using base_ptr = Chunk_Base*;
+            using chunk_type = Chunk<T, ChunkSize>;
+            using chunk_ptr = chunk_type*;
+            using chunk_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<chunk_type>;
+
+            static constexpr size_type chunk_size = ChunkSize;
+
+            static_assert(ChunkSize >= 2, "UnrolledList needs room for at least two elements per chunk");
+
+        private:
+            using chunk_traits = std::allocator_traits<chunk_allocator>;
+            using alloc_traits = std::allocator_traits<Alloc>;
+
+            Alloc _al;                  //constructs and destroys the elements
+            chunk_allocator _chunk_al;  //allocates the chunks
+            Chunk_Base _end;
+            size_type _size;
+
+        public:
+        /* ctor and dtor */
+        UnrolledList(): UnrolledList(Alloc()){}
+
+        explicit UnrolledList(const Alloc& al): _al(al), _chunk_al(al), _size(0){
+            _end.set_init_status();
+        }
+
+        UnrolledList(size_type count, const T& value, const Alloc& al = Alloc()): UnrolledList(al){
+            try{
+                for (size_type i = 0; i < count; ++i) push_back(value);
+            }catch(...){
+                tidy();
+                throw;
+            }
+        }
+
+        template<class InputIt, typename std::enable_if<MyStl::Is_Input_Iterator<InputIt>::value, bool>::type = true>
+        UnrolledList(InputIt first, InputIt last, const Alloc& al = Alloc()): UnrolledList(al){
+            try{
+                for (; first != last; ++first) push_back(*first);
+            }catch(...){
+                tidy();
+                throw;
+            }
+        }
+
+        UnrolledList(std::initializer_list<T> ilist, const Alloc& al = Alloc()): UnrolledList(ilist.begin(), ilist.end(), al){}
+
+        UnrolledList(const UnrolledList& other)
+            : UnrolledList(other.begin(), other.end(), alloc_traits::select_on_container_copy_construction(other._al)){}
+
+        UnrolledList(UnrolledList&& other) noexcept: _al(std::move(other._al)), _chunk_al(std::move(other._chunk_al)), _size(0){
+            _end.set_init_status();
+            steal(other);
+        }
+
+        ~UnrolledList(){
+            tidy();
+        }
+
+        UnrolledList& operator=(const UnrolledList& other){
+            if (this != &other){
+                MyStl::alloc_on_copy(_al, other._al, [this](){tidy();});
+                _chunk_al = chunk_allocator(_al);
+
+                tidy();
+                for (const auto& x : other) push_back(x);
+            }
+
+            return *this;
+        }
+
+        //the chunks are only taken over when the allocator comes along or compares equal
+        UnrolledList& operator=(UnrolledList&& other)
+            noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value){
+            if (this != &other){
+                move_assign(other, typename alloc_traits::propagate_on_container_move_assignment());
+            }
+
+            return *this;
+        }
+
+        UnrolledList& operator=(std::initializer_list<T> ilist){
+            tidy();
+            for (const auto& x : ilist) push_back(x);
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept {return _al;}
+
+        public:
+        /* element access */
+        reference front(){
+            assert(!empty());
+            return *begin();
+        }
+
+        const_reference front() const {
+            assert(!empty());
+            return *begin();
+        }
+
+        reference back(){
+            assert(!empty());
+            return *(--end());
+        }
+
+        const_reference back() const {
+            assert(!empty());
+            return *(--end());
+        }
+
+        public:
+        /* iterators */
+        iterator begin() noexcept {return iterator(_end._next, 0);}
+
+        const_iterator begin() const noexcept {return const_iterator(_end._next, 0);}
+
+        const_iterator cbegin() const noexcept {return begin();}
+
+        iterator end() noexcept {return iterator(&_end, 0);}
+
+        const_iterator end() const noexcept {return const_iterator(const_cast<base_ptr>(&_end), 0);}
+
+        const_iterator cend() const noexcept {return end();}
+
+        reverse_iterator rbegin() noexcept {return reverse_iterator(end());}
+
+        const_reverse_iterator rbegin() const noexcept {return const_reverse_iterator(end());}
+
+        const_reverse_iterator crbegin() const noexcept {return rbegin();}
+
+        reverse_iterator rend() noexcept {return reverse_iterator(begin());}
+
+        const_reverse_iterator rend() const noexcept {return const_reverse_iterator(begin());}
+
+        const_reverse_iterator crend() const noexcept {return rend();}
+
+        public:
+        /* capacity */
+        bool empty() const noexcept {return _size == 0;}
+
+        size_type size() const noexcept {return _size;}
+
+        size_type max_size() const noexcept {return chunk_traits::max_size(_chunk_al) * ChunkSize;}
+
+        public:
+        /* modifiers */
+        void clear() noexcept {
+            tidy();
+        }
+
+        iterator insert(const_iterator pos, const T& value){
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T&& value){
+            return emplace(pos, std::move(value));
+        }
+
+        iterator insert(const_iterator pos, size_type count, const T& value){
+            if (count == 0) return iterator(pos._chunk, pos._index);
+
+            // constructed first since value may refer to an element that gets moved
+            value_type copy(value);
+            iterator first = emplace(pos, copy), cur = first;
+            for (size_type i = 1; i < count; ++i) cur = emplace(++cur, copy);
+
+            // the inserts after the first one may have moved it to a split off chunk
+            return locate(cur, count - 1);
+        }
+
+        template<class InputIt, typename std::enable_if<MyStl::Is_Input_Iterator<InputIt>::value, bool>::type = true>
+        iterator insert(const_iterator pos, InputIt first, InputIt last){
+            if (first == last) return iterator(pos._chunk, pos._index);
+
+            iterator cur = emplace(pos, *first);
+            size_type count = 1;
+            for (++first; first != last; ++first, ++count) cur = emplace(++cur, *first);
+
+            return locate(cur, count - 1);
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<T> ilist){
+            return insert(pos, ilist.begin(), ilist.end());
+        }
+
+        /* shifts the rest of pos's chunk by one, or splits the chunk first if it is full */
+        template<class... Args>
+        iterator emplace(const_iterator pos, Args&&... args){
+            // constructed first since args may refer to an element within the list
+            value_type value(std::forward<Args>(args)...);
+
+            base_ptr chunk = pos._chunk;
+            size_type index = pos._index;
+            bool fresh = false;
+            if (chunk == &_end){
+                // at the end, into the last chunk if it has room
+                chunk = _end._previous;
+                index = chunk->_count;
+                if (chunk == &_end || index == ChunkSize){
+                    chunk = create_chunk(&_end);
+                    index = 0;
+                    fresh = true;
+                }
+            }else if (chunk->_count == ChunkSize){
+                // right at the start of a chunk the previous one may still have room
+                if (index == 0 && chunk->_previous != &_end && chunk->_previous->_count < ChunkSize){
+                    chunk = chunk->_previous;
+                    index = chunk->_count;
+                }else{
+                    base_ptr upper = split_chunk(chunk, ChunkSize / 2);
+                    if (index >= ChunkSize / 2){
+                        chunk = upper;
+                        index -= ChunkSize / 2;
+                    }
+                }
+            }
+
+            try{
+                insert_in_chunk(chunk, index, std::move(value));
+            }catch(...){
+                // an empty chunk left in the list would break iteration
+                if (fresh) delete_chunk(chunk);
+                throw;
+            }
+            ++_size;
+            return iterator(chunk, index);
+        }
+
+        template<class... Args>
+        reference emplace_back(Args&&... args){
+            base_ptr last = _end._previous;
+            bool fresh = last == &_end || last->_count == ChunkSize;
+            if (fresh) last = create_chunk(&_end);
+
+            try{
+                alloc_traits::construct(_al, data_of(last) + last->_count, std::forward<Args>(args)...);
+            }catch(...){
+                if (fresh) delete_chunk(last);
+                throw;
+            }
+            ++last->_count;
+            ++_size;
+            return data_of(last)[last->_count - 1];
+        }
+
+        template<class... Args>
+        reference emplace_front(Args&&... args){
+            return *emplace(begin(), std::forward<Args>(args)...);
+        }
+
+        void push_back(const T& value){
+            emplace_back(value);
+        }
+
+        void push_back(T&& value){
+            emplace_back(std::move(value));
+        }
+
+        void push_front(const T& value){
+            emplace_front(value);
+        }
+
+        void push_front(T&& value){
+            emplace_front(std::move(value));
+        }
+
+        /* a chunk left with under a quarter of its elements takes over the next one if both fit */
+        iterator erase(const_iterator pos){
+            assert(pos != end());
+            base_ptr chunk = pos._chunk;
+            size_type index = pos._index;
+
+            T* data = data_of(chunk);
+            std::move(data + index + 1, data + chunk->_count, data + index);
+            alloc_traits::destroy(_al, data + chunk->_count - 1);
+            --chunk->_count;
+            --_size;
+
+            if (chunk->_count == 0){
+                base_ptr next = chunk->_next;
+                delete_chunk(chunk);
+                return iterator(next, 0);
+            }
+
+            base_ptr next = chunk->_next;
+            if (chunk->_count < ChunkSize / 4 && next != &_end && chunk->_count + next->_count <= ChunkSize){
+                absorb_next(chunk);
+            }
+
+            return index < chunk->_count ? iterator(chunk, index) : iterator(chunk->_next, 0);
+        }
+
+        iterator erase(const_iterator first, const_iterator last){
+            // count first, erasing may move what last refers to
+            size_type count = MyStl::distance(first, last);
+            iterator cur(first._chunk, first._index);
+            for (; count > 0; --count) cur = erase(cur);
+
+            return cur;
+        }
+
+        void pop_back(){
+            assert(!empty());
+            erase(--end());
+        }
+
+        void pop_front(){
+            assert(!empty());
+            erase(begin());
+        }
+
+        void resize(size_type count){
+            while (_size > count) pop_back();
+            while (_size < count) emplace_back();
+        }
+
+        void resize(size_type count, const value_type& value){
+            while (_size > count) pop_back();
+            while (_size < count) push_back(value);
+        }
+
+        void swap(UnrolledList& other) noexcept {
+            if (&other != this){
+                MyStl::alloc_on_swap(_al, other._al);
+                MyStl::alloc_on_swap(_chunk_al, other._chunk_al);
+
+                std::swap(_end, other._end);
+                std::swap(_size, other._size);
+                relink_end();
+                other.relink_end();
+            }
+        }
+
+        public:
+        /* operations */
+        /* all of other's chunks are linked in before pos, whose chunk is split if pos is in the middle
+           of it. No element is moved but the ones after pos in its chunk, iterators into other stay
+           valid and now point into this list. The allocators must compare equal */
+        void splice(const_iterator pos, UnrolledList&& other){
+            if (&other == this || other.empty()) return;
+
+            base_ptr at = pos._chunk;
+            if (at != &_end && pos._index != 0) at = split_chunk(at, pos._index);
+
+            base_ptr first = other._end._next, last = other._end._previous;
+            first->_previous = at->_previous;
+            last->_next = at;
+            at->_previous->_next = first;
+            at->_previous = last;
+
+            _size += other._size;
+            other._end.set_init_status();
+            other._size = 0;
+        }
+
+        void remove(const T& value){
+            remove_if([&](const T& x) -> bool{return x == value;});
+        }
+
+        template<class UnaryPredicate>
+        void remove_if(UnaryPredicate p){
+            iterator cur = begin();
+            while(cur != end()){
+                if (p(*cur))
+                    cur = erase(cur);
+                else
+                    ++cur;
+            }
+        }
+
+        private:
+        /* helpers */
+        static T* data_of(base_ptr chunk) noexcept {return static_cast<chunk_ptr>(chunk)->data();}
+
+        //an empty chunk linked in before at
+        base_ptr create_chunk(base_ptr at){
+            chunk_ptr chunk = chunk_traits::allocate(_chunk_al, 1);
+            chunk->_count = 0;
+            chunk->_previous = at->_previous;
+            chunk->_next = at;
+            at->_previous->_next = chunk;
+            at->_previous = chunk;
+            return chunk;
+        }
+
+        //the elements must be gone already
+        void delete_chunk(base_ptr chunk){
+            chunk->_previous->_next = chunk->_next;
+            chunk->_next->_previous = chunk->_previous;
+            chunk_traits::deallocate(_chunk_al, static_cast<chunk_ptr>(chunk), 1);
+        }
+
+        //the elements from index on move to a new chunk right after chunk, which is returned
+        base_ptr split_chunk(base_ptr chunk, size_type index){
+            base_ptr upper = create_chunk(chunk->_next);
+            T* from = data_of(chunk);
+            T* to = data_of(upper);
+            for (size_type i = index; i < chunk->_count; ++i){
+                try{
+                    alloc_traits::construct(_al, to + (i - index), std::move_if_noexcept(from[i]));
+                }catch(...){
+                    for (size_type j = index; j < i; ++j) alloc_traits::destroy(_al, to + (j - index));
+                    delete_chunk(upper);
+                    throw;
+                }
+            }
+            for (size_type i = index; i < chunk->_count; ++i) alloc_traits::destroy(_al, from + i);
+
+            upper->_count = chunk->_count - index;
+            chunk->_count = index;
+            return upper;
+        }
+
+        //chunk has room for one more
+        void insert_in_chunk(base_ptr chunk, size_type index, value_type&& value){
+            T* data = data_of(chunk);
+            size_type count = chunk->_count;
+            if (index == count){
+                alloc_traits::construct(_al, data + count, std::move(value));
+            }else{
+                alloc_traits::construct(_al, data + count, std::move(data[count - 1]));
+                std::move_backward(data + index, data + count - 1, data + count);
+                data[index] = std::move(value);
+            }
+            ++chunk->_count;
+        }
+
+        //moves the next chunk's elements to the end of chunk and frees it, they must fit
+        void absorb_next(base_ptr chunk){
+            base_ptr next = chunk->_next;
+            T* from = data_of(next);
+            T* to = data_of(chunk) + chunk->_count;
+            size_type moved = 0;
+            try{
+                for (; moved < next->_count; ++moved){
+                    alloc_traits::construct(_al, to + moved, std::move_if_noexcept(from[moved]));
+                }
+            }catch(...){
+                for (size_type i = 0; i < moved; ++i) alloc_traits::destroy(_al, to + i);
+                throw;
+            }
+
+            for (size_type i = 0; i < next->_count; ++i) alloc_traits::destroy(_al, from + i);
+            chunk->_count += next->_count;
+            delete_chunk(next);
+        }
+
+        //the element back positions before it, inserts may have moved the first of a batch to another chunk
+        static iterator locate(iterator it, size_type back){
+            for (; back > 0; --back) --it;
+            return it;
+        }
+
+        void steal(UnrolledList& other) noexcept {
+            if (other.empty()) return;
+
+            _end._next = other._end._next;
+            _end._previous = other._end._previous;
+            _end._next->_previous = &_end;
+            _end._previous->_next = &_end;
+            _size = other._size;
+
+            other._end.set_init_status();
+            other._size = 0;
+        }
+
+        //points the first and last chunk back at _end after it was copied from another list's sentinel
+        void relink_end() noexcept {
+            if (_size == 0){
+                _end.set_init_status();
+                return;
+            }
+
+            _end._next->_previous = &_end;
+            _end._previous->_next = &_end;
+        }
+
+        void move_assign(UnrolledList& other, std::true_type) noexcept {
+            tidy();
+            _al = std::move(other._al);
+            _chunk_al = std::move(other._chunk_al);
+            steal(other);
+        }
+
+        void move_assign(UnrolledList& other, std::false_type){
+            if (_al == other._al){
+                tidy();
+                steal(other);
+            }else{
+                tidy();
+                for (auto& x : other) emplace_back(std::move(x));
+            }
+        }
+
+        void tidy() noexcept {
+            for (base_ptr chunk = _end._next; chunk != &_end; ){
+                base_ptr next = chunk->_next;
+                T* data = data_of(chunk);
+                for (size_type i = 0; i < chunk->_count; ++i) alloc_traits::destroy(_al, data + i);
+                chunk_traits::deallocate(_chunk_al, static_cast<chunk_ptr>(chunk), 1);
+                chunk = next;
+            }
+
+            _end.set_init_status();
+            _size = 0;
+        }
+    };
+
+    /* operators */
+    template <class T, class Alloc, std::size_t ChunkSize>
+    bool operator==(const UnrolledList<T, Alloc, ChunkSize>& lhs, const UnrolledList<T, Alloc, ChunkSize>& rhs){
+        return lhs.size() == rhs.size() && MyStl::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <class T, class Alloc, std::size_t ChunkSize>
+    bool operator!=(const UnrolledList<T, Alloc, ChunkSize>& lhs, const UnrolledList<T, Alloc, ChunkSize>& rhs){
+        return !(lhs == rhs);
+    }
+}
+
+#endif
@@ -12,14 +12,50 @@
 #include "Algorithm.h"
 
 namespace MyStl{
-    template <typename T>
+    /* growth policies, next_capacity returns the capacity to grow to when the current
+       capacity can't hold required elements of elem_size bytes */
+
+    // geometric growth by a factor of Num / Den, never less than what is required
+    template <std::size_t Num, std::size_t Den>
+    struct Ratio_Growth{
+        static_assert(Num > Den, "growth factor must be greater than 1");
+
+        static std::size_t next_capacity(std::size_t current, std::size_t required, std::size_t elem_size){
+            std::size_t max_cap = static_cast<std::size_t>(-1) / elem_size;
+            std::size_t grown = current > max_cap / Num * Den ? max_cap : current / Den * Num + current % Den * Num / Den;
+            return grown < required ? required : grown;
+        }
+    };
+
+    using Double_Growth = Ratio_Growth<2, 1>;
+
+    // reuses freed blocks better than doubling since the sum of the previous blocks eventually fits the next one
+    using One_And_Half_Growth = Ratio_Growth<3, 2>;
+
+    using Golden_Growth = Ratio_Growth<1618, 1000>;
+
+    // grows as Base does, but buffers of at least a page are rounded up to whole pages
+    template <typename Base = Double_Growth, std::size_t PageSize = 4096>
+    struct Page_Growth{
+        static std::size_t next_capacity(std::size_t current, std::size_t required, std::size_t elem_size){
+            std::size_t cap = Base::next_capacity(current, required, elem_size);
+            std::size_t bytes = cap * elem_size;
+            if (bytes < PageSize) return cap;
+
+            return (bytes + PageSize - 1) / PageSize * PageSize / elem_size;
+        }
+    };
+
+    template <typename T, typename Alloc = std::allocator<T>, typename Growth = Double_Growth>
     class Vector{
         public:
-            using value_type = typename std::allocator<T>::value_type;
-            using size_type = typename std::allocator<T>::size_type;
-            using difference_type = typename std::allocator<T>::difference_type;
-            using pointer = typename std::allocator_traits<std::allocator<T>>::pointer;
-            using const_pointer = typename std::allocator_traits<std::allocator<T>>::const_pointer;
+            using value_type = T;
+            using allocator_type = Alloc;
+            using growth_policy = Growth;
+            using size_type = typename std::allocator_traits<Alloc>::size_type;
+            using difference_type = typename std::allocator_traits<Alloc>::difference_type;
+            using pointer = typename std::allocator_traits<Alloc>::pointer;
+            using const_pointer = typename std::allocator_traits<Alloc>::const_pointer;
             using reference = T&;
             using const_reference = const T&;
             using iterator = T*;
@@ -27,9 +63,13 @@ namespace MyStl{
             using reverse_iterator = Reverse_Iterator<iterator>;
             using const_reverse_iterator = Reverse_Iterator<const_iterator>;
 
+            static_assert(std::is_same<pointer, T*>::value, "Vector only supports allocators with raw pointers");
+
         private:
+            using alloc_traits = std::allocator_traits<Alloc>;
+
             /* member fields*/
-            std::allocator<T> alloc;
+            allocator_type alloc;
 
             iterator _begin;
 
@@ -39,20 +79,16 @@ namespace MyStl{
 
         public:
             /* ctors and dtors */
-            Vector() noexcept {
-                try{
-                    _end = _begin = alloc.allocate(8);
-                    cap = _begin + 8;
-                }catch(...){
-                    _begin = _end = cap = nullptr;
-                }
-            }
+            // nothing is allocated until the first element is inserted
+            Vector() noexcept : Vector(Alloc()) {}
 
-            Vector(size_type count, const T& value){
-                size_type capa = count < 8 ? 8 : count;
+            explicit Vector(const Alloc& al) noexcept : alloc(al), _begin(nullptr), _end(nullptr), cap(nullptr) {}
+
+            Vector(size_type count, const T& value, const Alloc& al = Alloc()) : alloc(al) {
+                size_type capa = count;
                 
                 try{
-                    _begin = alloc.allocate(capa);
+                    _begin = capa ? alloc_traits::allocate(alloc, capa) : nullptr;
                     _end = _begin + count;
                     cap = _begin + capa;
                 }catch(...){
@@ -63,36 +99,62 @@ namespace MyStl{
                 initialize_all(value);
             }
 
-            explicit Vector(size_type count): Vector(count, T()){};
+            explicit Vector(size_type count, const Alloc& al = Alloc()): Vector(count, T(), al){};
 
             template<class InputIt, typename std::enable_if<MyStl::Is_Input_Iterator<InputIt>::value, bool>::type = true> 
-            Vector(InputIt first, InputIt last){
-                assert(first < last);
+            Vector(InputIt first, InputIt last, const Alloc& al = Alloc()) : alloc(al) {
+                assert(first <= last);
                 size_type n = last - first;
 
-                size_type capa = n < 8 ? 8 : n;
+                size_type capa = n;
 
-                _begin = alloc.allocate(capa);
+                _begin = capa ? alloc_traits::allocate(alloc, capa) : nullptr;
 
-                _end = MyStl::uninitialized_copy(first, last, _begin);
+                try{
+                    _end = uninitialized_copy(first, last, _begin);
+                }catch(...){
+                    alloc_traits::deallocate(alloc, _begin, capa);
+                    throw;
+                }
 
                 cap = _begin + capa;
             }
 
-            Vector(const Vector& other): Vector(other._begin, other._end){}
+            Vector(const Vector& other)
+                : Vector(other._begin, other._end, alloc_traits::select_on_container_copy_construction(other.alloc)){}
 
-            Vector(Vector&& other): _begin(other._begin), _end(other._end), cap(other.cap){
+            Vector(const Vector& other, const Alloc& al): Vector(other._begin, other._end, al){}
+
+            Vector(Vector&& other): alloc(std::move(other.alloc)), _begin(other._begin), _end(other._end), cap(other.cap){
                 other._begin = other._end = other.cap = nullptr;
             }
 
-            Vector(std::initializer_list<T> init): Vector(init.begin(), init.end()){}
+            Vector(Vector&& other, const Alloc& al): alloc(al), _begin(nullptr), _end(nullptr), cap(nullptr){
+                if (alloc == other.alloc){
+                    swap_pointers(other);
+                }else{
+                    // memory of other can't be released by al, so elements have to be moved one by one
+                    reserve(other.size());
+                    _end = uninitialized_move(other._begin, other._end, _begin);
+                }
+            }
+
+            Vector(std::initializer_list<T> init, const Alloc& al = Alloc()): Vector(init.begin(), init.end(), al){}
 
             ~Vector(){free();}
         
             Vector& operator=(const Vector& other){
                 if (&other != this){
-                    auto new_beg = alloc.allocate(other.size());
-                    auto new_end = MyStl::uninitialized_copy(other._begin, other._end, new_beg);
+                    MyStl::alloc_on_copy(alloc, other.alloc, [this](){free();});
+
+                    auto new_beg = other.empty() ? nullptr : alloc_traits::allocate(alloc, other.size());
+                    iterator new_end;
+                    try{
+                        new_end = uninitialized_copy(other._begin, other._end, new_beg);
+                    }catch(...){
+                        if (new_beg) alloc_traits::deallocate(alloc, new_beg, other.size());
+                        throw;
+                    }
                     free();
                     _begin = new_beg;
                     _end = cap = new_end;
@@ -103,33 +165,29 @@ namespace MyStl{
 
             Vector& operator=(Vector&& other){
                 if (&other != this){
-                    free();
-                    this->_begin = other._begin;
-                    this->_end = other._end;
-                    this->cap = other.cap;
-                    other._begin = other._end = other.cap = nullptr;
+                    move_assign(other, typename alloc_traits::propagate_on_container_move_assignment());
                 }
                 
                 return *this;
             }
 
             Vector& operator=(std::initializer_list<T> ilist){
-                Vector<T> temp(ilist.begin(), ilist.end());
+                Vector temp(ilist.begin(), ilist.end(), alloc);
                 this->swap(temp);
                 return *this;
             }
 
             void assign(size_type count, const T& value){
-                Vector<T> temp(count, value);
+                Vector temp(count, value, alloc);
                 this->swap(temp);
             }
 
             template<class InputIt, typename std::enable_if<MyStl::Is_Input_Iterator<InputIt>::value, bool>::type = true> 
             void assign(InputIt first, InputIt last){
-                assert(first < last);
+                assert(first <= last);
 
                 if (capacity() < last - first || last - first < size()){
-                    Vector<T> temp(first, last);
+                    Vector temp(first, last, alloc);
                     this->swap(temp);
                 }else{
                     auto new_end = _begin;
@@ -144,6 +202,8 @@ namespace MyStl{
                 this->assign(ilist.begin(), ilist.end());
             }
 
+            allocator_type get_allocator() const noexcept {return alloc;}
+
         public:
             /* member access */
             reference front(){
@@ -258,30 +318,11 @@ namespace MyStl{
                     throw std::length_error("cannot reserve capacity bigger than max_size");
                 }
 
-                T* new_begin = alloc.allocate(new_cap);
-                T* new_end = uninitialized_move(_begin, _end, new_begin);
-
-                alloc.deallocate(_begin, capacity());
-
-                _begin = new_begin;
-                _end = cap = new_end;
+                reallocate_exactly(new_cap);
             }
 
             void shrink_to_fit(){
-                auto new_beg = alloc.allocate(size());
-                
-                T* new_end;
-                try{
-                    new_end = uninitialized_move(_begin, _end, new_beg);
-                }catch(...){
-                    alloc.deallocate(new_beg, size());
-                    throw;
-                }
-
-                alloc.deallocate(_begin, capacity());
-
-                _begin = new_beg;
-                _end = cap = new_end;
+                reallocate_exactly(size());
             }
 
         public:
@@ -294,12 +335,12 @@ namespace MyStl{
                 assert(pos >= _begin && pos < _end);
                 iterator erase_pos = const_cast<iterator>(pos);
                 std::move(erase_pos + 1, _end, erase_pos);
-                alloc.destroy(--_end);
+                alloc_traits::destroy(alloc, --_end);
                 return const_cast<iterator>(pos);
             }
 
             iterator erase(const_iterator first, const_iterator last){
-                assert((first >= _begin && first < _end) 
+                assert((first >= _begin && first <= _end) 
                       && (last >= _begin && last <= _end) 
                       && (first <= last));
 
@@ -311,10 +352,10 @@ namespace MyStl{
                 _end -= (last - first);
 
                 while(old_end != _end){
-                    alloc.destroy(--old_end);
+                    alloc_traits::destroy(alloc, --old_end);
                 }
 
-                return first_to_move;
+                return move_to;
             }
 
             // T must be copy-assignable and copy-insertable to use this overload
@@ -345,7 +386,7 @@ namespace MyStl{
 
                 size_type num_after_pos = _end - insert_pos;
                 if (num_after_pos >= count){
-                    auto new_end = MyStl::uninitialized_copy(_end - count, _end, _end);
+                    auto new_end = uninitialized_move(_end - count, _end, _end);
                     MyStl::copy_backward(insert_pos, _end - count, _end);
                     MyStl::fill(insert_pos, insert_pos + count, value_backup);
 
@@ -355,7 +396,7 @@ namespace MyStl{
                 }else{
                     auto new_end = uninitialized_move(insert_pos, _end, insert_pos + count);
                     MyStl::fill(insert_pos, _end, value_backup);
-                    MyStl::uninitialized_fill(_end, new_end, value_backup);
+                    uninitialized_fill_n(_end, new_end - _end, value_backup);
 
                     _end = new_end;
                     return insert_pos;
@@ -381,7 +422,7 @@ namespace MyStl{
                     emplace_back(*first);
                 }
 
-                std::rotate(insert_pos, old_end, _end); //TODO: define rotate in algorithm part
+                MyStl::rotate(insert_pos, old_end, _end);
 
                 return insert_pos;
             }
@@ -402,8 +443,14 @@ namespace MyStl{
                     insert_pos = _begin + insert_index;
                 }
 
-                batch_move_backward_unchecked(insert_pos, _end, _end + 1);
-                *insert_pos = value_type(std::forward<Args>(args)...);
+                if (insert_pos == _end){
+                    alloc_traits::construct(alloc, _end, std::forward<Args>(args)...);
+                }else{
+                    value_type value(std::forward<Args>(args)...);
+                    alloc_traits::construct(alloc, _end, std::move(*(_end - 1)));
+                    batch_move_backward_unchecked(insert_pos, _end - 1, _end);
+                    *insert_pos = std::move(value);
+                }
                 ++_end;
                 return insert_pos; 
             }
@@ -411,7 +458,8 @@ namespace MyStl{
             template<class... Args> void emplace_back(Args&&... args){
                 if (_end == cap) reallocate(size() + 1);
 
-                *(_end++) = value_type(std::forward<Args>(args)...);
+                alloc_traits::construct(alloc, _end, std::forward<Args>(args)...);
+                ++_end;
             }
 
             void push_back(const T& value){
@@ -424,8 +472,7 @@ namespace MyStl{
 
             void pop_back(){
                 assert(!(size() == 0));
-                alloc.destroy(_end);
-                --_end;
+                alloc_traits::destroy(alloc, --_end);
             }
 
             void resize(size_type count){
@@ -444,11 +491,10 @@ namespace MyStl{
                 //if count == size() do nothing
             }
 
-            void swap(Vector<T>& other) noexcept {
+            void swap(Vector& other) noexcept {
                 if (&other != this){
-                    std::swap(this->_begin, other._begin);
-                    std::swap(this->_end, other._end);
-                    std::swap(this->cap, other.cap);
+                    MyStl::alloc_on_swap(alloc, other.alloc);
+                    swap_pointers(other);
                 }
             }
 
@@ -458,11 +504,11 @@ namespace MyStl{
                 T* i = _begin;
                 try{
                     for (; i != _end; ++i){
-                        alloc.construct(i, val);
+                        alloc_traits::construct(alloc, i, val);
                     }
                 }catch(...){
                     for (T* temp = _begin; temp != i; ++temp){
-                        alloc.destroy(temp);
+                        alloc_traits::destroy(alloc, temp);
                     }
                 }
             }
@@ -472,28 +518,47 @@ namespace MyStl{
                 FowardIt out = result;
                 try{
                     for (; beg != end; ++beg, ++out){
-                        alloc.construct(&*out, std::move(*beg));
+                        alloc_traits::construct(alloc, &*out, std::move(*beg));
                     }
                 }catch(...){
-                    for (; out != result; --out){
-                        alloc.destroy(&*out);
+                    for (; result != out; ++result){
+                        alloc_traits::destroy(alloc, &*result);
                     }
+                    throw;
                 }
 
                 return out;     //returns the iterator after last moved element
             }
 
+            template <typename InputIt, typename FowardIt>
+            FowardIt uninitialized_copy(InputIt beg, InputIt end, FowardIt result){
+                FowardIt out = result;
+                try{
+                    for (; beg != end; ++beg, ++out){
+                        alloc_traits::construct(alloc, &*out, *beg);
+                    }
+                }catch(...){
+                    for (; result != out; ++result){
+                        alloc_traits::destroy(alloc, &*result);
+                    }
+                    throw;
+                }
+
+                return out;     //returns the iterator after last copied element
+            }
+
             template <typename FowardIter, typename Count>
             FowardIter uninitialized_fill_n(FowardIter beg, Count count, T value){
                 FowardIter out = beg;
                 try{
                     for (; count > 0; --count, ++out){
-                        alloc.construct(&*out, value);
+                        alloc_traits::construct(alloc, &*out, value);
                     }
                 }catch(...){
-                    for (; out != beg; --out){
-                        alloc.destroy(&*out);
+                    for (; beg != out; ++beg){
+                        alloc_traits::destroy(alloc, &*beg);
                     }
+                    throw;
                 }
 
                 return out;     //returns the iterator after last copied element
@@ -501,9 +566,9 @@ namespace MyStl{
 
             void free(){
                 for (value_type* i = _begin; i != _end; ++i){
-                    alloc.destroy(i);
+                    alloc_traits::destroy(alloc, i);
                 }
-                alloc.deallocate(_begin, cap - _begin);
+                if (_begin) alloc_traits::deallocate(alloc, _begin, cap - _begin);
 
                 _begin = _end = cap = nullptr;
             }
@@ -521,43 +586,100 @@ namespace MyStl{
             }
 
             void reallocate(size_type reserve_cap){
-                auto size_ = size();
-                size_type new_cap = size_ * 2 < reserve_cap ? reserve_cap : size_ * 2;
-                iterator new_begin = alloc.allocate(new_cap);
-                auto new_cap_iter = new_begin + new_cap;
-                auto new_end = uninitialized_move(_begin, _end, new_begin);
-                
-                free();
+                size_type new_cap = Growth::next_capacity(capacity(), reserve_cap, sizeof(T));
+                if (new_cap > max_size()){
+                    throw std::length_error("vector cannot grow beyond max_size");
+                }
+                reallocate_exactly(new_cap);
+            }
+
+            /* moves every element into a new buffer of new_cap elements and releases the old one */
+            void reallocate_exactly(size_type new_cap){
+                iterator new_begin = new_cap ? alloc_traits::allocate(alloc, new_cap) : nullptr;
+                iterator new_end;
+                try{
+                    new_end = relocate(_begin, _end, new_begin, can_relocate());
+                }catch(...){
+                    if (new_begin) alloc_traits::deallocate(alloc, new_begin, new_cap);
+                    throw;
+                }
+
+                if (_begin) alloc_traits::deallocate(alloc, _begin, capacity());
                 _begin = new_begin;
                 _end = new_end;
-                cap = new_cap_iter;
+                cap = new_begin + new_cap;
+            }
+
+            using can_relocate = MyStl::Is_Bitwise_Relocatable<Alloc, T>;
+
+            /* relocate [first, last) to uninitialized memory at result, 
+               the source is left as raw memory, returns the iterator after the last relocated element */
+            iterator relocate(iterator first, iterator last, iterator result, std::true_type) noexcept {
+                if (first != last){
+                    std::memcpy(static_cast<void*>(result), static_cast<const void*>(first), (last - first) * sizeof(T));
+                }
+
+                return result + (last - first);
+            }
+
+            iterator relocate(iterator first, iterator last, iterator result, std::false_type){
+                iterator new_end = uninitialized_move(first, last, result);
+                for (; first != last; ++first){
+                    alloc_traits::destroy(alloc, first);
+                }
+
+                return new_end;
+            }
+
+            void swap_pointers(Vector& other) noexcept {
+                std::swap(this->_begin, other._begin);
+                std::swap(this->_end, other._end);
+                std::swap(this->cap, other.cap);
+            }
+
+            // the allocator follows the buffer, so it can always be stolen
+            void move_assign(Vector& other, std::true_type){
+                free();
+                alloc = std::move(other.alloc);
+                swap_pointers(other);
+            }
+
+            // the allocator stays, buffer can only be stolen if it can be released by it
+            void move_assign(Vector& other, std::false_type){
+                free();
+                if (alloc == other.alloc){
+                    swap_pointers(other);
+                }else{
+                    reserve(other.size());
+                    _end = uninitialized_move(other._begin, other._end, _begin);
+                }
             }
     };
 
     /* operators */
-    template<class T>
-    bool operator==(const MyStl::Vector<T>& lhs, const MyStl::Vector<T>& rhs){
+    template<class T, class Alloc, class Growth>
+    bool operator==(const MyStl::Vector<T, Alloc, Growth>& lhs, const MyStl::Vector<T, Alloc, Growth>& rhs){
         if (lhs.size() != rhs.size()) return false;
 
         return MyStl::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
 
-    template<class T>
-    bool operator!=(const MyStl::Vector<T>& lhs, const MyStl::Vector<T>& rhs){return !(lhs == rhs);}
+    template<class T, class Alloc, class Growth>
+    bool operator!=(const MyStl::Vector<T, Alloc, Growth>& lhs, const MyStl::Vector<T, Alloc, Growth>& rhs){return !(lhs == rhs);}
 
-    template<class T>
-    bool operator<(const MyStl::Vector<T>& lhs, const MyStl::Vector<T>& rhs){
+    template<class T, class Alloc, class Growth>
+    bool operator<(const MyStl::Vector<T, Alloc, Growth>& lhs, const MyStl::Vector<T, Alloc, Growth>& rhs){
         return MyStl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
     }
 
-    template<class T>
-    bool operator<=(const MyStl::Vector<T>& lhs, const MyStl::Vector<T>& rhs){return !(rhs < lhs);}
+    template<class T, class Alloc, class Growth>
+    bool operator<=(const MyStl::Vector<T, Alloc, Growth>& lhs, const MyStl::Vector<T, Alloc, Growth>& rhs){return !(rhs < lhs);}
 
-    template<class T>
-    bool operator>(const MyStl::Vector<T>& lhs, const MyStl::Vector<T>& rhs){return rhs < lhs;}
+    template<class T, class Alloc, class Growth>
+    bool operator>(const MyStl::Vector<T, Alloc, Growth>& lhs, const MyStl::Vector<T, Alloc, Growth>& rhs){return rhs < lhs;}
 
-    template<class T>
-    bool operator>=(const MyStl::Vector<T>& lhs, const MyStl::Vector<T>& rhs){return !(lhs < rhs);}
+    template<class T, class Alloc, class Growth>
+    bool operator>=(const MyStl::Vector<T, Alloc, Growth>& lhs, const MyStl::Vector<T, Alloc, Growth>& rhs){return !(lhs < rhs);}
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,298 @@
+#ifndef MYSTL_FLAT_MAP_H
+#define MYSTL_FLAT_MAP_H
+
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include "Vector.h"
+#include "flat_tree.h"
+
+namespace MyStl {
+/* same interface as map, with the pairs kept sorted by key in one contiguous Container.
+   Since the pairs get moved around on insertion and erasure, value_type is pair<Key, T>
+   rather than pair<const Key, T>, the key must still never be modified through an iterator.
+   Any insertion or erasure invalidates all iterators */
+template <class Key, class T, class Compare = std::less<Key>,
+          class Container = MyStl::Vector<std::pair<Key, T>>>
+class flat_map {
+public:
+    typedef Key                 key_type;
+    typedef T                   mapped_type;
+    typedef std::pair<Key, T>   value_type;
+    typedef Compare             key_compare;
+    typedef Container           container_type;
+
+    // orders values by their keys
+    class value_compare {
+        friend class flat_map;
+
+        protected:
+            Compare comp;
+
+            value_compare(Compare c): comp(c) {}
+
+        public:
+            bool operator()(const value_type& lhs, const value_type& rhs) const {
+                return comp(lhs.first, rhs.first);
+            }
+    };
+
+private:
+    typedef MyStl::_Flat_tree<key_type, value_type,
+        std::_Select1st<value_type>, key_compare, container_type> _Rep_type;
+
+public:
+    typedef typename _Rep_type::size_type               size_type;
+    typedef typename _Rep_type::difference_type         difference_type;
+    typedef typename _Rep_type::reference               reference;
+    typedef typename _Rep_type::const_reference         const_reference;
+    typedef typename _Rep_type::iterator                iterator;
+    typedef typename _Rep_type::const_iterator          const_iterator;
+    typedef typename _Rep_type::reverse_iterator        reverse_iterator;
+    typedef typename _Rep_type::const_reverse_iterator  const_reverse_iterator;
+
+private:
+    _Rep_type _tree;
+
+public:
+    /* constructors and destructors */
+    flat_map() = default;
+
+    explicit flat_map(const Compare& comp): _tree(comp) {}
+
+    template <class InputIt>
+    flat_map(InputIt first, InputIt last, const Compare& comp = Compare()): _tree(comp) {
+        _tree.insert_unique(first, last);
+    }
+
+    // [first, last) must already be sorted and free of duplicate keys, the pairs are only copied
+    template <class InputIt>
+    flat_map(sorted_unique_t tag, InputIt first, InputIt last, const Compare& comp = Compare()): _tree(comp) {
+        _tree.insert_unique(tag, first, last);
+    }
+
+    flat_map(const flat_map& other): _tree(other._tree) {}
+
+    flat_map(flat_map&& other): _tree(std::move(other._tree)) {}
+
+    flat_map(std::initializer_list<value_type> ilist, const Compare& comp = Compare()): _tree(comp) {
+        _tree.insert_unique(ilist);
+    }
+
+    flat_map& operator=(const flat_map& other) = default;
+
+    flat_map& operator=(flat_map&& other) = default;
+
+    flat_map& operator=(std::initializer_list<value_type> ilist) {
+        _tree.clear();
+        _tree.insert_unique(ilist);
+        return *this;
+    }
+
+    /* element access */
+    mapped_type& at(const key_type& key) {
+        auto i = _tree.find(key);
+        if (i == _tree.end()) throw std::out_of_range("key not found in flat_map");
+
+        return i->second;
+    }
+
+    const mapped_type& at(const key_type& key) const {
+        auto i = _tree.find(key);
+        if (i == _tree.end()) throw std::out_of_range("key not found in flat_map");
+
+        return i->second;
+    }
+
+    mapped_type& operator[](const key_type& key) {return try_emplace(key).first->second;}
+
+    mapped_type& operator[](key_type&& key) {return try_emplace(std::move(key)).first->second;}
+
+    /* iterators */
+    iterator begin() noexcept {return _tree.begin();}
+
+    const_iterator begin() const noexcept {return _tree.begin();}
+
+    const_iterator cbegin() const noexcept {return _tree.cbegin();}
+
+    iterator end() noexcept {return _tree.end();}
+
+    const_iterator end() const noexcept {return _tree.end();}
+
+    const_iterator cend() const noexcept {return _tree.cend();}
+
+    reverse_iterator rbegin() noexcept {return _tree.rbegin();}
+
+    const_reverse_iterator rbegin() const noexcept {return _tree.rbegin();}
+
+    const_reverse_iterator crbegin() const noexcept {return _tree.crbegin();}
+
+    reverse_iterator rend() noexcept {return _tree.rend();}
+
+    const_reverse_iterator rend() const noexcept {return _tree.rend();}
+
+    const_reverse_iterator crend() const noexcept {return _tree.crend();}
+
+    /* capacity */
+    bool empty() const noexcept {return _tree.empty();}
+
+    size_type size() const noexcept {return _tree.size();}
+
+    size_type max_size() const noexcept {return _tree.max_size();}
+
+    size_type capacity() const noexcept {return _tree.capacity();}
+
+    void reserve(size_type new_cap) {_tree.reserve(new_cap);}
+
+    void shrink_to_fit() {_tree.shrink_to_fit();}
+
+    /* modifiers */
+    void clear() noexcept {_tree.clear();}
+
+    std::pair<iterator, bool> insert(const value_type& value) {return _tree.insert_unique(value);}
+
+    std::pair<iterator, bool> insert(value_type&& value) {return _tree.insert_unique(std::move(value));}
+
+    template <class P,
+              typename std::enable_if<std::is_constructible<value_type, P&&>::value, int>::type = 0>
+    std::pair<iterator, bool> insert(P&& value) {return _tree.insert_unique(std::forward<P>(value));}
+
+    iterator insert(const_iterator hint, const value_type& value) {return _tree.insert_unique(hint, value);}
+
+    template <class P,
+              typename std::enable_if<std::is_constructible<value_type, P&&>::value, int>::type = 0>
+    iterator insert(const_iterator hint, P&& value) {return _tree.insert_unique(hint, std::forward<P>(value));}
+
+    template <class InputIt>
+    void insert(InputIt first, InputIt last) {_tree.insert_unique(first, last);}
+
+    template <class InputIt>
+    void insert(sorted_unique_t tag, InputIt first, InputIt last) {_tree.insert_unique(tag, first, last);}
+
+    void insert(std::initializer_list<value_type> ilist) {_tree.insert_unique(ilist);}
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+        auto res = try_emplace(key, std::forward<M>(obj));
+        if (!res.second) res.first->second = std::forward<M>(obj);
+        return res;
+    }
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj) {
+        auto res = try_emplace(std::move(key), std::forward<M>(obj));
+        if (!res.second) res.first->second = std::forward<M>(obj);
+        return res;
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {return _tree.emplace_unique(std::forward<Args>(args)...);}
+
+    template <class... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        return _tree.emplace_hint_unique(hint, std::forward<Args>(args)...);
+    }
+
+    // the mapped value is only constructed if key is not present
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+        return _tree.emplace_key_unique(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                        std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        return _tree.emplace_key_unique(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                                        std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    iterator erase(const_iterator pos) {return _tree.erase(pos);}
+
+    iterator erase(iterator pos) {return _tree.erase(pos);}
+
+    iterator erase(const_iterator first, const_iterator last) {return _tree.erase(first, last);}
+
+    size_type erase(const key_type& key) {return _tree.erase_unique(key);}
+
+    void swap(flat_map& other) {_tree.swap(other._tree);}
+
+    /* lookup, the template overloads take anything a transparent Compare can compare with a key */
+    size_type count(const key_type& key) const {return _tree.count_unique(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    size_type count(const K& x) const {return _tree.count_equal(x);}
+
+    iterator find(const key_type& key) {return _tree.find(key);}
+
+    const_iterator find(const key_type& key) const {return _tree.find(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator find(const K& x) {return _tree.find(x);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator find(const K& x) const {return _tree.find(x);}
+
+    bool contains(const key_type& key) const {return find(key) != end();}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    bool contains(const K& x) const {return find(x) != end();}
+
+    std::pair<iterator, iterator> equal_range(const key_type& key) {return _tree.equal_range_unique(key);}
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return _tree.equal_range_unique(key);
+    }
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K& x) {return _tree.equal_range_equal(x);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K& x) const {return _tree.equal_range_equal(x);}
+
+    iterator lower_bound(const key_type& key) {return _tree.lower_bound(key);}
+
+    const_iterator lower_bound(const key_type& key) const {return _tree.lower_bound(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator lower_bound(const K& x) {return _tree.lower_bound(x);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator lower_bound(const K& x) const {return _tree.lower_bound(x);}
+
+    iterator upper_bound(const key_type& key) {return _tree.upper_bound(key);}
+
+    const_iterator upper_bound(const key_type& key) const {return _tree.upper_bound(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator upper_bound(const K& x) {return _tree.upper_bound(x);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator upper_bound(const K& x) const {return _tree.upper_bound(x);}
+
+    /* observers */
+    key_compare key_comp() const {return _tree.key_comp();}
+
+    value_compare value_comp() const {return value_compare(_tree.key_comp());}
+
+    // the sorted pairs themselves
+    const container_type& sequence() const noexcept {return _tree.sequence();}
+};
+
+/* operators, the pairs are compared in key order */
+template <class Key, class T, class Compare, class Container>
+bool operator==(const flat_map<Key, T, Compare, Container>& lhs, const flat_map<Key, T, Compare, Container>& rhs) {
+    return lhs.size() == rhs.size() && MyStl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class Key, class T, class Compare, class Container>
+bool operator!=(const flat_map<Key, T, Compare, Container>& lhs, const flat_map<Key, T, Compare, Container>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare, class Container>
+bool operator<(const flat_map<Key, T, Compare, Container>& lhs, const flat_map<Key, T, Compare, Container>& rhs) {
+    return MyStl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+} // namespace MyStl
+
+#endif
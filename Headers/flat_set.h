@@ -0,0 +1,196 @@
+#ifndef MYSTL_FLAT_SET_H
+#define MYSTL_FLAT_SET_H
+
+#include <functional>
+#include "Vector.h"
+#include "flat_tree.h"
+
+namespace MyStl {
+/* same interface as set, but the keys are kept sorted in one contiguous Container. Lookups
+   and iteration touch far less memory than following tree nodes, inserting or erasing a single
+   key shifts every key after it. Any insertion or erasure invalidates all iterators */
+template <class Key, class Compare = std::less<Key>, class Container = MyStl::Vector<Key>>
+class flat_set {
+public:
+    typedef Key                 key_type;
+    typedef Key                 value_type;
+    typedef Compare             key_compare;
+    typedef Compare             value_compare;
+    typedef Container           container_type;
+
+private:
+    typedef MyStl::_Flat_tree<key_type, value_type,
+        std::_Identity<value_type>, key_compare, container_type> _Rep_type;
+
+public:
+    typedef typename _Rep_type::size_type               size_type;
+    typedef typename _Rep_type::difference_type         difference_type;
+    typedef typename _Rep_type::reference               reference;
+    typedef typename _Rep_type::const_reference         const_reference;
+    // keys must not be modified in place, their position depends on them
+    typedef typename _Rep_type::const_iterator          iterator;
+    typedef typename _Rep_type::const_iterator          const_iterator;
+    typedef typename _Rep_type::const_reverse_iterator  reverse_iterator;
+    typedef typename _Rep_type::const_reverse_iterator  const_reverse_iterator;
+
+private:
+    _Rep_type _tree;
+
+public:
+    /* constructors and destructors */
+    flat_set() = default;
+
+    explicit flat_set(const Compare& comp): _tree(comp) {}
+
+    template <class InputIt>
+    flat_set(InputIt first, InputIt last, const Compare& comp = Compare()): _tree(comp) {
+        _tree.insert_unique(first, last);
+    }
+
+    // [first, last) must already be sorted and free of duplicates, the keys are only copied
+    template <class InputIt>
+    flat_set(sorted_unique_t tag, InputIt first, InputIt last, const Compare& comp = Compare()): _tree(comp) {
+        _tree.insert_unique(tag, first, last);
+    }
+
+    flat_set(const flat_set& other): _tree(other._tree) {}
+
+    flat_set(flat_set&& other): _tree(std::move(other._tree)) {}
+
+    flat_set(std::initializer_list<value_type> ilist, const Compare& comp = Compare()): _tree(comp) {
+        _tree.insert_unique(ilist);
+    }
+
+    flat_set& operator=(const flat_set& other) = default;
+
+    flat_set& operator=(flat_set&& other) = default;
+
+    flat_set& operator=(std::initializer_list<value_type> ilist) {
+        _tree.clear();
+        _tree.insert_unique(ilist);
+        return *this;
+    }
+
+    /* iterators */
+    iterator begin() const noexcept {return _tree.begin();}
+
+    const_iterator cbegin() const noexcept {return _tree.cbegin();}
+
+    iterator end() const noexcept {return _tree.end();}
+
+    const_iterator cend() const noexcept {return _tree.cend();}
+
+    reverse_iterator rbegin() const noexcept {return _tree.rbegin();}
+
+    const_reverse_iterator crbegin() const noexcept {return _tree.crbegin();}
+
+    reverse_iterator rend() const noexcept {return _tree.rend();}
+
+    const_reverse_iterator crend() const noexcept {return _tree.crend();}
+
+    /* capacity */
+    bool empty() const noexcept {return _tree.empty();}
+
+    size_type size() const noexcept {return _tree.size();}
+
+    size_type max_size() const noexcept {return _tree.max_size();}
+
+    size_type capacity() const noexcept {return _tree.capacity();}
+
+    void reserve(size_type new_cap) {_tree.reserve(new_cap);}
+
+    void shrink_to_fit() {_tree.shrink_to_fit();}
+
+    /* modifiers */
+    void clear() noexcept {_tree.clear();}
+
+    std::pair<iterator, bool> insert(const value_type& value) {return _tree.insert_unique(value);}
+
+    std::pair<iterator, bool> insert(value_type&& value) {return _tree.insert_unique(std::move(value));}
+
+    iterator insert(const_iterator hint, const value_type& value) {return _tree.insert_unique(hint, value);}
+
+    iterator insert(const_iterator hint, value_type&& value) {return _tree.insert_unique(hint, std::move(value));}
+
+    template <class InputIt>
+    void insert(InputIt first, InputIt last) {_tree.insert_unique(first, last);}
+
+    template <class InputIt>
+    void insert(sorted_unique_t tag, InputIt first, InputIt last) {_tree.insert_unique(tag, first, last);}
+
+    void insert(std::initializer_list<value_type> ilist) {_tree.insert_unique(ilist);}
+
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {return _tree.emplace_unique(std::forward<Args>(args)...);}
+
+    template <class... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        return _tree.emplace_hint_unique(hint, std::forward<Args>(args)...);
+    }
+
+    iterator erase(const_iterator pos) {return _tree.erase(pos);}
+
+    iterator erase(const_iterator first, const_iterator last) {return _tree.erase(first, last);}
+
+    size_type erase(const key_type& key) {return _tree.erase_unique(key);}
+
+    void swap(flat_set& other) {_tree.swap(other._tree);}
+
+    /* lookup, the template overloads take anything a transparent Compare can compare with a key */
+    size_type count(const key_type& key) const {return _tree.count_unique(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    size_type count(const K& x) const {return _tree.count_equal(x);}
+
+    iterator find(const key_type& key) const {return _tree.find(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator find(const K& x) const {return _tree.find(x);}
+
+    bool contains(const key_type& key) const {return find(key) != end();}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    bool contains(const K& x) const {return find(x) != end();}
+
+    std::pair<iterator, iterator> equal_range(const key_type& key) const {return _tree.equal_range_unique(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K& x) const {return _tree.equal_range_equal(x);}
+
+    iterator lower_bound(const key_type& key) const {return _tree.lower_bound(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator lower_bound(const K& x) const {return _tree.lower_bound(x);}
+
+    iterator upper_bound(const key_type& key) const {return _tree.upper_bound(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator upper_bound(const K& x) const {return _tree.upper_bound(x);}
+
+    /* observers */
+    key_compare key_comp() const {return _tree.key_comp();}
+
+    value_compare value_comp() const {return _tree.key_comp();}
+
+    // the sorted keys themselves
+    const container_type& sequence() const noexcept {return _tree.sequence();}
+};
+
+/* operators, the keys are compared in order */
+template <class Key, class Compare, class Container>
+bool operator==(const flat_set<Key, Compare, Container>& lhs, const flat_set<Key, Compare, Container>& rhs) {
+    return lhs.size() == rhs.size() && MyStl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class Key, class Compare, class Container>
+bool operator!=(const flat_set<Key, Compare, Container>& lhs, const flat_set<Key, Compare, Container>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class Compare, class Container>
+bool operator<(const flat_set<Key, Compare, Container>& lhs, const flat_set<Key, Compare, Container>& rhs) {
+    return MyStl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+} // namespace MyStl
+
+#endif
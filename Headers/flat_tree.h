@@ -0,0 +1,357 @@
+#ifndef MYSTL_FLAT_TREE_H
+#define MYSTL_FLAT_TREE_H
+
+#include "Iterator.h"
+#include "Algorithm.h"
+#include "Vector.h"
+#include "Sort.h"
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+namespace MyStl
+{
+    /* whether lookups on keys of type Key use branchless_lower_bound instead of the plain
+       binary search, specialize it for keys whose comparison is as cheap as an integer's */
+    template <class Key>
+    struct use_branchless_search
+        : std::integral_constant<bool, std::is_arithmetic<Key>::value || std::is_pointer<Key>::value> {};
+
+    /* sorted sequence of values without duplicate keys, stored contiguously in Container.
+       Container must be random access with raw pointer iterators, e.g. Vector or SmallVector.
+       Inserting and erasing shift the tail, lookups are binary searches over a flat array */
+    template <class Key, class Value, class KeyofValue, class Compare, class Container>
+    class _Flat_tree {
+        public:
+            typedef Key                                          key_type;
+            typedef Value                                        value_type;
+            typedef Compare                                      key_compare;
+            typedef Container                                    container_type;
+            typedef typename Container::size_type                size_type;
+            typedef typename Container::difference_type          difference_type;
+            typedef value_type&                                  reference;
+            typedef const value_type&                            const_reference;
+            typedef typename Container::iterator                 iterator;
+            typedef typename Container::const_iterator           const_iterator;
+            typedef MyStl::Reverse_Iterator<iterator>            reverse_iterator;
+            typedef MyStl::Reverse_Iterator<const_iterator>      const_reverse_iterator;
+
+            static_assert(std::is_pointer<iterator>::value, "_Flat_tree needs a container with raw pointer iterators");
+
+        private:
+            typedef typename use_branchless_search<key_type>::type _Branchless;
+
+            Container _seq;
+            Compare _comp;
+
+        public:
+            /* constructors and destructors */
+            _Flat_tree() = default;
+
+            explicit _Flat_tree(const Compare& comp): _seq(), _comp(comp) {}
+
+            _Flat_tree(const _Flat_tree& other) = default;
+
+            _Flat_tree(_Flat_tree&& other) = default;
+
+            _Flat_tree& operator=(const _Flat_tree& other) = default;
+
+            _Flat_tree& operator=(_Flat_tree&& other) = default;
+
+            /* iterators */
+            iterator begin() noexcept {return _seq.begin();}
+
+            const_iterator begin() const noexcept {return _seq.begin();}
+
+            const_iterator cbegin() const noexcept {return _seq.cbegin();}
+
+            iterator end() noexcept {return _seq.end();}
+
+            const_iterator end() const noexcept {return _seq.end();}
+
+            const_iterator cend() const noexcept {return _seq.cend();}
+
+            reverse_iterator rbegin() noexcept {return reverse_iterator(end());}
+
+            const_reverse_iterator rbegin() const noexcept {return const_reverse_iterator(end());}
+
+            const_reverse_iterator crbegin() const noexcept {return const_reverse_iterator(end());}
+
+            reverse_iterator rend() noexcept {return reverse_iterator(begin());}
+
+            const_reverse_iterator rend() const noexcept {return const_reverse_iterator(begin());}
+
+            const_reverse_iterator crend() const noexcept {return const_reverse_iterator(begin());}
+
+            /* capacity */
+            bool empty() const noexcept {return _seq.empty();}
+
+            size_type size() const noexcept {return _seq.size();}
+
+            size_type max_size() const noexcept {return _seq.max_size();}
+
+            size_type capacity() const noexcept {return _seq.capacity();}
+
+            void reserve(size_type new_cap) {_seq.reserve(new_cap);}
+
+            void shrink_to_fit() {_seq.shrink_to_fit();}
+
+            /* modifiers */
+            void clear() noexcept {_seq.clear();}
+
+            std::pair<iterator, bool>
+            insert_unique(const value_type& val) {
+                return emplace_key_unique(KeyofValue()(val), val);
+            }
+
+            std::pair<iterator, bool>
+            insert_unique(value_type&& val) {
+                return emplace_key_unique(KeyofValue()(val), std::move(val));
+            }
+
+            template <class P,
+                      typename std::enable_if<std::is_constructible<value_type, P&&>::value, int>::type = 0>
+            std::pair<iterator, bool>
+            insert_unique(P&& other) {
+                return emplace_unique(std::forward<P>(other));
+            }
+
+            // O(1) search if val belongs right before hint
+            iterator insert_unique(const_iterator hint, const value_type& val) {
+                return emplace_hint_unique(hint, val);
+            }
+
+            iterator insert_unique(const_iterator hint, value_type&& val) {
+                return emplace_hint_unique(hint, std::move(val));
+            }
+
+            template <class P,
+                      typename std::enable_if<std::is_constructible<value_type, P&&>::value, int>::type = 0>
+            iterator insert_unique(const_iterator hint, P&& other) {
+                return emplace_hint_unique(hint, std::forward<P>(other));
+            }
+
+            /* the new values are appended, sorted among themselves and merged with the old ones in
+               a single pass, O(m log m + n) instead of the O(m * n) of m single inserts */
+            template <class InputIt>
+            void insert_unique(InputIt first, InputIt last) {
+                iterator mid = append(first, last);
+                sort_tail(mid);
+                merge_unique(mid);
+            }
+
+            // [first, last) must already be sorted and free of duplicates, only the merge is left
+            template <class InputIt>
+            void insert_unique(sorted_unique_t, InputIt first, InputIt last) {
+                iterator mid = append(first, last);
+                assert(std::is_sorted(mid, end(), [this](const value_type& lhs, const value_type& rhs){
+                    return !_comp(KeyofValue()(rhs), KeyofValue()(lhs));
+                }) && "range passed with sorted_unique is not sorted");
+                merge_unique(mid);
+            }
+
+            void insert_unique(std::initializer_list<value_type> ilist) {
+                insert_unique(ilist.begin(), ilist.end());
+            }
+
+            // the value is built first since the key is only known afterwards
+            template <class... Args>
+            std::pair<iterator, bool>
+            emplace_unique(Args&&... args) {
+                value_type val(std::forward<Args>(args)...);
+                return emplace_key_unique(KeyofValue()(val), std::move(val));
+            }
+
+            // args are only used to construct the value if key is not present yet
+            template <class K, class... Args>
+            std::pair<iterator, bool>
+            emplace_key_unique(const K& key, Args&&... args) {
+                iterator pos = lower_bound(key);
+                if (pos != end() && !_comp(key, KeyofValue()(*pos))) return {pos, false};
+
+                return {_seq.emplace(pos, std::forward<Args>(args)...), true};
+            }
+
+            template <class... Args>
+            iterator emplace_hint_unique(const_iterator hint, Args&&... args) {
+                value_type val(std::forward<Args>(args)...);
+                const key_type& key = KeyofValue()(val);
+                if ((hint == begin() || _comp(KeyofValue()(*(hint - 1)), key))
+                    && (hint == end() || _comp(key, KeyofValue()(*hint)))) {
+                    return _seq.emplace(hint, std::move(val));
+                }
+
+                return emplace_key_unique(key, std::move(val)).first;
+            }
+
+            iterator erase(const_iterator pos) {return _seq.erase(pos);}
+
+            iterator erase(const_iterator first, const_iterator last) {return _seq.erase(first, last);}
+
+            template <class K>
+            size_type erase_unique(const K& key) {
+                iterator pos = find(key);
+                if (pos == end()) return 0;
+
+                _seq.erase(pos);
+                return 1;
+            }
+
+            void swap(_Flat_tree& other) {
+                _seq.swap(other._seq);
+                std::swap(_comp, other._comp);
+            }
+
+            /* Look up */
+            template <class K>
+            iterator lower_bound(const K& key) {
+                return search_lower(begin(), end(), key, _Branchless());
+            }
+
+            template <class K>
+            const_iterator lower_bound(const K& key) const {
+                return search_lower(begin(), end(), key, _Branchless());
+            }
+
+            template <class K>
+            iterator upper_bound(const K& key) {
+                return search_upper(begin(), end(), key, _Branchless());
+            }
+
+            template <class K>
+            const_iterator upper_bound(const K& key) const {
+                return search_upper(begin(), end(), key, _Branchless());
+            }
+
+            template <class K>
+            iterator find(const K& key) {
+                iterator pos = lower_bound(key);
+                return pos != end() && !_comp(key, KeyofValue()(*pos)) ? pos : end();
+            }
+
+            template <class K>
+            const_iterator find(const K& key) const {
+                const_iterator pos = lower_bound(key);
+                return pos != end() && !_comp(key, KeyofValue()(*pos)) ? pos : end();
+            }
+
+            template <class K>
+            size_type count_unique(const K& key) const {return find(key) != end();}
+
+            // with a transparent Compare several keys may be equivalent to key
+            template <class K>
+            size_type count_equal(const K& key) const {
+                auto range = equal_range_equal(key);
+                return range.second - range.first;
+            }
+
+            template <class K>
+            std::pair<iterator, iterator> equal_range_unique(const K& key) {
+                iterator pos = find(key);
+                return {pos, pos == end() ? pos : pos + 1};
+            }
+
+            template <class K>
+            std::pair<const_iterator, const_iterator> equal_range_unique(const K& key) const {
+                const_iterator pos = find(key);
+                return {pos, pos == end() ? pos : pos + 1};
+            }
+
+            template <class K>
+            std::pair<iterator, iterator> equal_range_equal(const K& key) {
+                iterator first = lower_bound(key);
+                return {first, search_upper(first, end(), key, _Branchless())};
+            }
+
+            template <class K>
+            std::pair<const_iterator, const_iterator> equal_range_equal(const K& key) const {
+                const_iterator first = lower_bound(key);
+                return {first, search_upper(first, end(), key, _Branchless())};
+            }
+
+            /* observers */
+            key_compare key_comp() const {return _comp;}
+
+            const container_type& sequence() const noexcept {return _seq;}
+
+        private:
+            template <class It, class K>
+            It search_lower(It first, It last, const K& key, std::true_type) const {
+                return MyStl::branchless_lower_bound(first, last, key,
+                    [this](const value_type& val, const K& k){return _comp(KeyofValue()(val), k);});
+            }
+
+            template <class It, class K>
+            It search_lower(It first, It last, const K& key, std::false_type) const {
+                return MyStl::lower_bound(first, last, key,
+                    [this](const value_type& val, const K& k){return _comp(KeyofValue()(val), k);});
+            }
+
+            template <class It, class K>
+            It search_upper(It first, It last, const K& key, std::true_type) const {
+                return MyStl::branchless_upper_bound(first, last, key,
+                    [this](const K& k, const value_type& val){return _comp(k, KeyofValue()(val));});
+            }
+
+            template <class It, class K>
+            It search_upper(It first, It last, const K& key, std::false_type) const {
+                return MyStl::upper_bound(first, last, key,
+                    [this](const K& k, const value_type& val){return _comp(k, KeyofValue()(val));});
+            }
+
+            bool less_value(const value_type& lhs, const value_type& rhs) const {
+                return _comp(KeyofValue()(lhs), KeyofValue()(rhs));
+            }
+
+            // returns where the appended values start
+            template <class InputIt>
+            iterator append(InputIt first, InputIt last) {
+                size_type old_size = size();
+                try {
+                    for (; first != last; ++first) _seq.emplace_back(*first);
+                } catch (...) {
+                    _seq.erase(begin() + old_size, end());
+                    throw;
+                }
+
+                return begin() + old_size;
+            }
+
+            // stable, of several equal new keys the first one is kept as with single inserts
+            void sort_tail(iterator mid) {
+                try {
+                    MyStl::stable_sort(mid, end(),
+                        [this](const value_type& lhs, const value_type& rhs){return less_value(lhs, rhs);});
+                } catch (...) {
+                    _seq.erase(mid, end());
+                    throw;
+                }
+            }
+
+            /* [begin, mid) and [mid, end) are both sorted. Duplicates within the tail and keys already
+               present are dropped first, so the merge itself only moves every value once. The two halves
+               are two natural runs to stable_sort, which merges them with a single galloping merge */
+            void merge_unique(iterator mid) {
+                iterator out = mid;
+                const_iterator search_from = begin();
+                for (iterator cur = mid; cur != end(); ++cur) {
+                    if (out != mid && !less_value(*(out - 1), *cur)) continue;
+
+                    // the tail is sorted so the next match can't be left of the previous one
+                    search_from = search_lower(search_from, const_iterator(mid), KeyofValue()(*cur), _Branchless());
+                    if (search_from != mid && !less_value(*cur, *search_from)) continue;
+
+                    if (out != cur) *out = std::move(*cur);
+                    ++out;
+                }
+                _seq.erase(out, end());
+
+                MyStl::stable_sort(begin(), end(),
+                    [this](const value_type& lhs, const value_type& rhs){return less_value(lhs, rhs);});
+            }
+    };
+}
+
+#endif
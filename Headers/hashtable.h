@@ -0,0 +1,907 @@
+/* This header file implements an open addressing hash table in the style of
+    Swiss tables, an internal data structure for MyStl's unordered containers */
+
+#ifndef MYSTL_HASHTABLE_H
+#define MYSTL_HASHTABLE_H
+
+#include "Iterator.h"
+#include "Algorithm.h"
+#include <assert.h>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <initializer_list>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MYSTL_HASHTABLE_SSE2 1
+#include <emmintrin.h>
+#else
+#define MYSTL_HASHTABLE_SSE2 0
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace MyStl
+{
+    /* every slot has a control byte, full slots store the low 7 bits of the hash (h2)
+       so that most mismatches are rejected without touching the slot itself.
+       The sentinel marks the end of the table for iterators. */
+    typedef signed char _Hash_ctrl_t;
+
+    enum _Hash_ctrl_state : _Hash_ctrl_t {
+        _ctrl_empty = -128,
+        _ctrl_deleted = -2,
+        _ctrl_sentinel = -1
+    };
+
+    inline bool _ctrl_is_full(_Hash_ctrl_t c) {
+        return c >= 0;
+    }
+
+    // bit scans, x must not be 0
+    inline int _hash_count_trailing(unsigned int x) {
+#if defined(__GNUC__)
+        return __builtin_ctz(x);
+#elif defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, x);
+        return static_cast<int>(index);
+#else
+        int n = 0;
+        for (; !(x & 1u); x >>= 1) ++n;
+        return n;
+#endif
+    }
+
+    inline int _hash_count_leading(unsigned int x) {
+#if defined(__GNUC__)
+        return __builtin_clz(x);
+#elif defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse(&index, x);
+        return static_cast<int>(sizeof(x) * 8 - 1 - index);
+#else
+        int n = 0;
+        for (unsigned int top = 1u << (sizeof(x) * 8 - 1); !(x & top); x <<= 1) ++n;
+        return n;
+#endif
+    }
+
+    inline int _hash_count_trailing(unsigned long long x) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, x);
+        return static_cast<int>(index);
+#else
+        unsigned int low = static_cast<unsigned int>(x);
+        return low ? _hash_count_trailing(low) : 32 + _hash_count_trailing(static_cast<unsigned int>(x >> 32));
+#endif
+    }
+
+    inline int _hash_count_leading(unsigned long long x) {
+#if defined(__GNUC__)
+        return __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanReverse64(&index, x);
+        return static_cast<int>(63 - index);
+#else
+        unsigned int high = static_cast<unsigned int>(x >> 32);
+        return high ? _hash_count_leading(high) : 32 + _hash_count_leading(static_cast<unsigned int>(x));
+#endif
+    }
+
+    // set bits of a group match, Shift converts a bit position to a byte position
+    template <class T, int Shift, int Width>
+    class _Hash_bit_mask {
+    public:
+        explicit _Hash_bit_mask(T mask) : _mask(mask) {}
+
+        explicit operator bool() const {
+            return _mask != 0;
+        }
+
+        _Hash_bit_mask& operator++() {
+            _mask &= _mask - 1;
+            return *this;
+        }
+
+        // mask must not be empty for the following
+        int lowest() const {
+            return trailing_zeros();
+        }
+
+        int trailing_zeros() const {
+            return _hash_count_trailing(_mask) >> Shift;
+        }
+
+        int leading_zeros() const {
+            constexpr int unused_bits = sizeof(T) * 8 - (Width << Shift);
+            return (_hash_count_leading(_mask) - unused_bits) >> Shift;
+        }
+
+    private:
+        T _mask;
+    };
+
+#if MYSTL_HASHTABLE_SSE2
+    // 16 control bytes compared at once
+    class _Hash_group {
+    public:
+        typedef _Hash_bit_mask<unsigned int, 0, 16> _Mask;
+
+        static constexpr std::size_t width = 16;
+
+        explicit _Hash_group(const _Hash_ctrl_t* pos) {
+            _ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        }
+
+        _Mask match(_Hash_ctrl_t h2) const {
+            return _Mask(movemask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _ctrl)));
+        }
+
+        _Mask mask_empty() const {
+            return _Mask(movemask(_mm_cmpeq_epi8(_mm_set1_epi8(_ctrl_empty), _ctrl)));
+        }
+
+        // signed compare, empty and deleted are the only states below the sentinel
+        _Mask mask_empty_or_deleted() const {
+            return _Mask(movemask(_mm_cmpgt_epi8(_mm_set1_epi8(_ctrl_sentinel), _ctrl)));
+        }
+
+        std::size_t count_leading_empty_or_deleted() const {
+            unsigned int mask = movemask(_mm_cmpgt_epi8(_mm_set1_epi8(_ctrl_sentinel), _ctrl));
+            return _hash_count_trailing(mask + 1);
+        }
+
+    private:
+        static unsigned int movemask(__m128i v) {
+            return static_cast<unsigned int>(_mm_movemask_epi8(v));
+        }
+
+        __m128i _ctrl;
+    };
+#else
+    // 8 control bytes compared at once inside a 64 bit word
+    class _Hash_group {
+    public:
+        typedef _Hash_bit_mask<unsigned long long, 3, 8> _Mask;
+
+        static constexpr std::size_t width = 8;
+
+        explicit _Hash_group(const _Hash_ctrl_t* pos) {
+            std::memcpy(&_ctrl, pos, sizeof(_ctrl));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            _ctrl = __builtin_bswap64(_ctrl);
+#endif
+        }
+
+        // may report a false positive next to a true one, callers compare keys anyway
+        _Mask match(_Hash_ctrl_t h2) const {
+            unsigned long long x = _ctrl ^ (lsbs * static_cast<unsigned char>(h2));
+            return _Mask((x - lsbs) & ~x & msbs);
+        }
+
+        _Mask mask_empty() const {
+            return _Mask(_ctrl & (~_ctrl << 6) & msbs);
+        }
+
+        _Mask mask_empty_or_deleted() const {
+            return _Mask(_ctrl & (~_ctrl << 7) & msbs);
+        }
+
+        std::size_t count_leading_empty_or_deleted() const {
+            unsigned long long not_special = ~(_ctrl & (~_ctrl << 7)) & msbs;
+            return not_special ? _hash_count_trailing(not_special) >> 3 : width;
+        }
+
+    private:
+        static constexpr unsigned long long msbs = 0x8080808080808080ULL;
+        static constexpr unsigned long long lsbs = 0x0101010101010101ULL;
+
+        unsigned long long _ctrl;
+    };
+#endif
+
+    template <class T, class pointer, class reference>
+    class _Hashtable_iterator
+        : public MyStl::Iterator<MyStl::Forward_Iterator_Tag, T, ptrdiff_t, pointer, reference> {
+    public:
+        using _Self = _Hashtable_iterator<T, pointer, reference>;
+
+        const _Hash_ctrl_t* _ctrl;
+        T* _slot;
+
+        _Hashtable_iterator() = default;
+
+        _Hashtable_iterator(const _Hash_ctrl_t* ctrl, T* slot) : _ctrl(ctrl), _slot(slot) {}
+
+        // iterator to const_iterator
+        template <class P, class R,
+                  typename std::enable_if<std::is_convertible<P, pointer>::value, int>::type = 0>
+        _Hashtable_iterator(const _Hashtable_iterator<T, P, R>& other)
+            : _ctrl(other._ctrl), _slot(other._slot) {}
+
+        _Self& operator++() {
+            ++_ctrl;
+            ++_slot;
+            skip_empty_or_deleted();
+            return *this;
+        }
+
+        _Self operator++(int) {
+            _Self tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        pointer operator->() const {
+            return _slot;
+        }
+
+        reference operator*() const {
+            return *_slot;
+        }
+
+        bool operator==(const _Self& rhs) const {
+            return _ctrl == rhs._ctrl;
+        }
+
+        bool operator!=(const _Self& rhs) const {
+            return _ctrl != rhs._ctrl;
+        }
+
+        // stops on the next full slot or on the sentinel
+        void skip_empty_or_deleted() {
+            while (*_ctrl < _ctrl_sentinel) {
+                std::size_t shift = _Hash_group(_ctrl).count_leading_empty_or_deleted();
+                _ctrl += shift;
+                _slot += shift;
+            }
+        }
+    };
+
+    /* Slots live in one array, the control bytes in another one of capacity + width bytes:
+       the slots' bytes, the sentinel, and a copy of the first width - 1 bytes so that
+       a group can be loaded at any slot without wrapping around.
+       The capacity is always 2^k - 1 and at most 7/8 of it is used, so probing
+       always runs into an empty slot eventually. */
+    template<typename TKey, typename TVal, typename KeyofValue, typename Hash, typename KeyEqual,
+             typename Alloc = std::allocator<TVal>>
+    class _Hashtable {
+    public:
+        typedef TKey                 key_type;
+        typedef TVal                 value_type;
+        typedef value_type*          pointer;
+        typedef const value_type*    const_pointer;
+        typedef value_type&          reference;
+        typedef const value_type&    const_reference;
+        typedef size_t               size_type;
+        typedef ptrdiff_t            difference_type;
+
+        typedef Hash                 hasher;
+        typedef KeyEqual             key_equal;
+        typedef Alloc                allocator_type;
+
+        typedef _Hashtable_iterator<TVal, pointer, reference> iterator;
+        typedef _Hashtable_iterator<TVal, const_pointer, const_reference> const_iterator;
+
+        static_assert(std::__is_invocable<KeyEqual, const key_type&, const key_type&>{},
+                        "KeyEqual predicate must be invocable.");
+        static_assert(std::__is_invocable<KeyofValue, const value_type&>{},
+                        "Key getter must be invocable.");
+
+    private:
+        typedef _Hashtable<TKey, TVal, KeyofValue, Hash, KeyEqual, Alloc> _Self;
+        typedef typename std::allocator_traits<Alloc>::template rebind_alloc<TVal> _Slot_allocator;
+        typedef std::allocator_traits<_Slot_allocator> _Slot_traits;
+        typedef typename std::allocator_traits<Alloc>::template rebind_alloc<_Hash_ctrl_t> _Ctrl_allocator;
+        typedef std::allocator_traits<_Ctrl_allocator> _Ctrl_traits;
+
+        static_assert(std::is_same<typename _Slot_traits::pointer, TVal*>::value,
+                        "hash tables only support allocators with raw pointers");
+
+        static constexpr size_type _group_width = _Hash_group::width;
+        static constexpr size_type _min_capacity = 15;
+
+    private:
+        _Slot_allocator _al;
+        _Ctrl_allocator _ctrl_al;
+        _Hash_ctrl_t* _ctrl;
+        pointer _slots;
+        size_type _capacity;    // 0 while nothing has been allocated
+        size_type _size;
+        size_type _growth_left; // inserts left before the table has to be rehashed
+        Hash _hash;
+        KeyEqual _equal;
+
+    public:
+        /* constructors and destructors */
+        _Hashtable() : _Hashtable(0) {}
+
+        explicit _Hashtable(size_type bucket_count, const Hash& hash = Hash(),
+                            const KeyEqual& equal = KeyEqual(), const Alloc& al = Alloc())
+            : _al(al), _ctrl_al(al), _hash(hash), _equal(equal) {
+            default_init();
+            if (bucket_count) reserve(bucket_count);
+        }
+
+        explicit _Hashtable(const Alloc& al) : _Hashtable(0, Hash(), KeyEqual(), al) {}
+
+        _Hashtable(const _Hashtable& rhs)
+            : _Hashtable(0, rhs._hash, rhs._equal, _Slot_traits::select_on_container_copy_construction(rhs._al)) {
+            copy_table(rhs);
+        }
+
+        _Hashtable(const _Hashtable& rhs, const Alloc& al) : _Hashtable(0, rhs._hash, rhs._equal, al) {
+            copy_table(rhs);
+        }
+
+        _Hashtable(_Hashtable&& rhs)
+            : _al(std::move(rhs._al)), _ctrl_al(std::move(rhs._ctrl_al)), _hash(rhs._hash), _equal(rhs._equal) {
+            default_init();
+            steal(rhs);
+        }
+
+        _Hashtable(_Hashtable&& rhs, const Alloc& al) : _Hashtable(0, rhs._hash, rhs._equal, al) {
+            if (_al == rhs._al) {
+                steal(rhs);
+            } else {
+                copy_table(rhs, std::true_type());
+            }
+        }
+
+        ~_Hashtable() {
+            destroy_table();
+        }
+
+        _Self& operator=(const _Hashtable& rhs) {
+            if (this != &rhs) {
+                MyStl::alloc_on_copy(_al, rhs._al, [this]() {destroy_table();});
+                _ctrl_al = _Ctrl_allocator(_al);
+
+                clear();
+                _hash = rhs._hash;
+                _equal = rhs._equal;
+                copy_table(rhs);
+            }
+            return *this;
+        }
+
+        _Self& operator=(_Hashtable&& rhs) {
+            if (this != &rhs) {
+                move_assign(rhs, typename _Slot_traits::propagate_on_container_move_assignment());
+            }
+
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept {
+            return allocator_type(_al);
+        }
+
+        /* capacity */
+        size_type size() const noexcept {
+            return _size;
+        }
+
+        bool empty() const noexcept {
+            return _size == 0;
+        }
+
+        size_type max_size() const noexcept {
+            return static_cast<size_type>(-1) / (sizeof(value_type) + 1) / 2;
+        }
+
+        /* iterators */
+        iterator begin() noexcept {
+            iterator i(_ctrl, _slots);
+            i.skip_empty_or_deleted();
+            return i;
+        }
+
+        const_iterator begin() const noexcept {
+            const_iterator i(_ctrl, _slots);
+            i.skip_empty_or_deleted();
+            return i;
+        }
+
+        iterator end() noexcept {
+            return iterator(_ctrl + _capacity, _slots + _capacity);
+        }
+
+        const_iterator end() const noexcept {
+            return const_iterator(_ctrl + _capacity, _slots + _capacity);
+        }
+
+        const_iterator cbegin() const noexcept {
+            return begin();
+        }
+
+        const_iterator cend() const noexcept {
+            return end();
+        }
+
+        /* modifiers */
+        void clear() noexcept {
+            if (!_capacity) return;
+
+            destroy_slots();
+            reset_ctrl();
+            _size = 0;
+            _growth_left = capacity_to_growth(_capacity);
+        }
+
+        std::pair<iterator, bool>
+        insert_unique(const_reference val) {
+            return emplace_key_unique(KeyofValue()(val), val);
+        }
+
+        std::pair<iterator, bool>
+        insert_unique(value_type&& val) {
+            return emplace_key_unique(KeyofValue()(val), std::move(val));
+        }
+
+        template <class P,
+                  typename std::enable_if<std::is_constructible<value_type, P&&>::value, int>::type = 0>
+        std::pair<iterator, bool>
+        insert_unique(P&& other) {
+            return emplace_unique(std::forward<P>(other));
+        }
+
+        template <class InputIt>
+        void insert_unique(InputIt first, InputIt last) {
+            for (; first != last; ++first) {
+                insert_unique(*first);
+            }
+        }
+
+        void insert_unique(std::initializer_list<value_type> ilist) {
+            reserve(_size + ilist.size());
+            insert_unique(ilist.begin(), ilist.end());
+        }
+
+        // the value is built first since the key is only known afterwards
+        template <class...Args>
+        std::pair<iterator, bool>
+        emplace_unique(Args&& ...args) {
+            value_type val(std::forward<Args>(args)...);
+            return emplace_key_unique(KeyofValue()(val), std::move(val));
+        }
+
+        // args are only used to construct the value if key is not present yet
+        template <class K, class...Args>
+        std::pair<iterator, bool>
+        emplace_key_unique(const K& key, Args&& ...args) {
+            size_t hash = hash_of(key);
+            size_type i = find_index(key, hash);
+            if (i != _capacity) return std::make_pair(iterator_at(i), false);
+
+            i = prepare_insert(hash);
+            _Slot_traits::construct(_al, _slots + i, std::forward<Args>(args)...);
+            commit_insert(i, hash);
+            return std::make_pair(iterator_at(i), true);
+        }
+
+        iterator erase(const_iterator pos) {
+            assert(pos != end() && _ctrl_is_full(*pos._ctrl));
+
+            size_type i = pos._ctrl - _ctrl;
+            erase_at(i);
+
+            iterator next = iterator_at(i);
+            next.skip_empty_or_deleted();
+            return next;
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            if (first == begin() && last == end()) {
+                clear();
+                return end();
+            }
+
+            while (first != last) {
+                first = erase(first);
+            }
+
+            return iterator_at(last._ctrl - _ctrl);
+        }
+
+        size_type erase(const key_type& key) {
+            size_type i = find_index(key, hash_of(key));
+            if (i == _capacity) return 0;
+
+            erase_at(i);
+            return 1;
+        }
+
+        void swap(_Hashtable& other) {
+            if (this != &other) {
+                MyStl::alloc_on_swap(_al, other._al);
+                MyStl::alloc_on_swap(_ctrl_al, other._ctrl_al);
+                swap_data(other);
+                std::swap(_hash, other._hash);
+                std::swap(_equal, other._equal);
+            }
+        }
+
+        /* Look up */
+        iterator find(const key_type& key) {
+            return iterator_at(find_index(key, hash_of(key)));
+        }
+
+        const_iterator find(const key_type& key) const {
+            return const_iterator(const_cast<_Self*>(this)->find(key));
+        }
+
+        size_type count_unique(const key_type& key) const {
+            return find_index(key, hash_of(key)) == _capacity ? 0 : 1;
+        }
+
+        std::pair<iterator, iterator>
+        equal_range_unique(const key_type& key) {
+            auto i = find(key);
+            auto j = i;
+            return i == end() ? std::make_pair(end(), end()) : std::make_pair(i, ++j);
+        }
+
+        std::pair<const_iterator, const_iterator>
+        equal_range_unique(const key_type& key) const {
+            auto i = find(key);
+            auto j = i;
+            return i == end() ? std::make_pair(end(), end()) : std::make_pair(i, ++j);
+        }
+
+        /* hash policy */
+        size_type bucket_count() const noexcept {
+            return _capacity;
+        }
+
+        float load_factor() const noexcept {
+            return _capacity ? static_cast<float>(_size) / _capacity : 0.0f;
+        }
+
+        float max_load_factor() const noexcept {
+            return 0.875f;
+        }
+
+        // makes room for count elements without any further rehash
+        void reserve(size_type count) {
+            if (count <= _size + _growth_left) return;
+
+            rehash(count + (count + 6) / 7);
+        }
+
+        // rehashes into at least count buckets, but never fewer than the elements need
+        void rehash(size_type count) {
+            if (count == 0 && _size == 0) {
+                destroy_table();
+                return;
+            }
+
+            size_type needed = _size + (_size + 6) / 7;
+            size_type new_cap = normalize_capacity(count > needed ? count : needed);
+            if (new_cap != _capacity || _growth_left != capacity_to_growth(_capacity) - _size) {
+                resize(new_cap);
+            }
+        }
+
+        /* Observers */
+        hasher hash_function() const {
+            return _hash;
+        }
+
+        key_equal key_eq() const {
+            return _equal;
+        }
+
+    private:
+        // the seed mixes the table's address into the probe start, so that iterating one table
+        // while inserting into another one doesn't fill the second one in its probe order
+        size_type probe_start(size_t hash) const {
+            return ((hash >> 7) ^ (reinterpret_cast<std::uintptr_t>(_ctrl) >> 12)) & _capacity;
+        }
+
+        static _Hash_ctrl_t h2(size_t hash) {
+            return static_cast<_Hash_ctrl_t>(hash & 0x7F);
+        }
+
+        // std::hash is the identity for integers, so the bits are spread before they are split
+        template <class K>
+        size_t hash_of(const K& key) const {
+            std::uint64_t x = static_cast<std::uint64_t>(_hash(key)) * 0x9E3779B97F4A7C15ULL;
+            return static_cast<size_t>(x ^ (x >> 32));
+        }
+
+        // returns _capacity if the key is not present
+        template <class K>
+        size_type find_index(const K& key, size_t hash) const {
+            _Hash_ctrl_t tag = h2(hash);
+            size_type pos = probe_start(hash);
+            size_type step = 0;
+
+            while (true) {
+                _Hash_group group(_ctrl + pos);
+                for (auto match = group.match(tag); match; ++match) {
+                    size_type i = (pos + match.lowest()) & _capacity;
+                    if (_equal(key, KeyofValue()(_slots[i]))) return i;
+                }
+
+                if (group.mask_empty()) return _capacity;
+
+                // triangular steps visit every group once the table is a power of two groups
+                step += _group_width;
+                pos = (pos + step) & _capacity;
+                assert(step <= _capacity + _group_width && "probing a full hash table");
+            }
+        }
+
+        size_type find_first_non_full(size_t hash) const {
+            size_type pos = probe_start(hash);
+            size_type step = 0;
+
+            while (true) {
+                auto mask = _Hash_group(_ctrl + pos).mask_empty_or_deleted();
+                if (mask) return (pos + mask.lowest()) & _capacity;
+
+                step += _group_width;
+                pos = (pos + step) & _capacity;
+            }
+        }
+
+        // slot for a new element with the given hash, rehashing first if the table is full.
+        // Nothing is recorded until commit_insert, so a throwing constructor leaves no trace.
+        size_type prepare_insert(size_t hash) {
+            size_type i = find_first_non_full(hash);
+            if (_growth_left == 0 && _ctrl[i] != _ctrl_deleted) {
+                rehash_and_grow_if_necessary();
+                i = find_first_non_full(hash);
+            }
+
+            return i;
+        }
+
+        void commit_insert(size_type i, size_t hash) {
+            _growth_left -= (_ctrl[i] == _ctrl_empty);
+            set_ctrl(i, h2(hash));
+            ++_size;
+        }
+
+        // a slot may become empty again if no probe has ever passed it while looking for
+        // an empty slot, i.e. it never was inside a window of width full or deleted slots
+        void erase_at(size_type i) {
+            _Slot_traits::destroy(_al, _slots + i);
+            --_size;
+
+            size_type before = (i - _group_width) & _capacity;
+            auto empty_after = _Hash_group(_ctrl + i).mask_empty();
+            auto empty_before = _Hash_group(_ctrl + before).mask_empty();
+            bool was_never_full = empty_before && empty_after &&
+                static_cast<size_type>(empty_after.trailing_zeros() + empty_before.leading_zeros()) < _group_width;
+
+            set_ctrl(i, was_never_full ? _ctrl_empty : _ctrl_deleted);
+            _growth_left += was_never_full;
+        }
+
+        // tombstones are dropped without growing if they take up a big part of the table
+        void rehash_and_grow_if_necessary() {
+            if (_capacity > _group_width && _size * 32 <= _capacity * 25) {
+                resize(_capacity);
+            } else {
+                resize(_capacity ? _capacity * 2 + 1 : _min_capacity);
+            }
+        }
+
+        // writes the byte and its copy behind the sentinel
+        void set_ctrl(size_type i, _Hash_ctrl_t c) {
+            _ctrl[i] = c;
+            _ctrl[((i - (_group_width - 1)) & _capacity) + ((_group_width - 1) & _capacity)] = c;
+        }
+
+        void reset_ctrl() {
+            std::memset(_ctrl, static_cast<unsigned char>(_ctrl_empty), _capacity + _group_width);
+            _ctrl[_capacity] = _ctrl_sentinel;
+        }
+
+        iterator iterator_at(size_type i) noexcept {
+            return iterator(_ctrl + i, _slots + i);
+        }
+
+        static size_type capacity_to_growth(size_type capacity) {
+            return capacity - capacity / 8;
+        }
+
+        // smallest 2^k - 1 that is at least count
+        static size_type normalize_capacity(size_type count) {
+            size_type cap = _min_capacity;
+            while (cap < count) cap = cap * 2 + 1;
+            return cap;
+        }
+
+        // control bytes of an empty table that never allocated, nothing is ever written to it
+        static _Hash_ctrl_t* empty_group() {
+            alignas(16) static const _Hash_ctrl_t group[16] = {
+                _ctrl_sentinel, _ctrl_empty, _ctrl_empty, _ctrl_empty,
+                _ctrl_empty, _ctrl_empty, _ctrl_empty, _ctrl_empty,
+                _ctrl_empty, _ctrl_empty, _ctrl_empty, _ctrl_empty,
+                _ctrl_empty, _ctrl_empty, _ctrl_empty, _ctrl_empty};
+            return const_cast<_Hash_ctrl_t*>(group);
+        }
+
+        void default_init() noexcept {
+            _ctrl = empty_group();
+            _slots = nullptr;
+            _capacity = 0;
+            _size = 0;
+            _growth_left = 0;
+        }
+
+        using can_relocate = MyStl::Is_Bitwise_Relocatable<_Slot_allocator, TVal>;
+
+        void transfer_slot(pointer to, pointer from, std::true_type) noexcept {
+            std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), sizeof(TVal));
+        }
+
+        // copies unless moving can't throw, so a failed resize leaves the old table as it was
+        void transfer_slot(pointer to, pointer from, std::false_type) {
+            _Slot_traits::construct(_al, to, std::move_if_noexcept(*from));
+        }
+
+        void destroy_old_slot(pointer, std::true_type) noexcept {}
+
+        void destroy_old_slot(pointer p, std::false_type) noexcept {
+            _Slot_traits::destroy(_al, p);
+        }
+
+        // bitwise copies must not be destroyed, the originals are still alive
+        void discard_new_slots(std::true_type) noexcept {}
+
+        void discard_new_slots(std::false_type) noexcept {
+            destroy_slots();
+        }
+
+        // moves every element into a new table of new_cap slots
+        void resize(size_type new_cap) {
+            _Hash_ctrl_t* old_ctrl = _ctrl;
+            pointer old_slots = _slots;
+            size_type old_cap = _capacity;
+            size_type old_size = _size;
+            size_type old_growth_left = _growth_left;
+
+            allocate_table(new_cap);
+            _growth_left = capacity_to_growth(new_cap) - _size;
+
+            size_type moved = 0;
+            try {
+                for (; moved != old_cap; ++moved) {
+                    if (!_ctrl_is_full(old_ctrl[moved])) continue;
+
+                    size_t hash = hash_of(KeyofValue()(old_slots[moved]));
+                    size_type i = find_first_non_full(hash);
+                    transfer_slot(_slots + i, old_slots + moved, can_relocate());
+                    set_ctrl(i, h2(hash));
+                }
+            } catch (...) {
+                // the old table is untouched, elements were only moved out if that could not throw
+                discard_new_slots(can_relocate());
+                deallocate_table();
+                _ctrl = old_ctrl;
+                _slots = old_slots;
+                _capacity = old_cap;
+                _size = old_size;
+                _growth_left = old_growth_left;
+                throw;
+            }
+
+            for (size_type i = 0; i != old_cap; ++i) {
+                if (_ctrl_is_full(old_ctrl[i])) destroy_old_slot(old_slots + i, can_relocate());
+            }
+
+            if (old_cap) {
+                _Ctrl_traits::deallocate(_ctrl_al, old_ctrl, old_cap + _group_width);
+                _Slot_traits::deallocate(_al, old_slots, old_cap);
+            }
+        }
+
+        // sets up empty control bytes for new_cap slots, the old arrays are left to the caller
+        void allocate_table(size_type new_cap) {
+            _Hash_ctrl_t* ctrl = _Ctrl_traits::allocate(_ctrl_al, new_cap + _group_width);
+            try {
+                _slots = _Slot_traits::allocate(_al, new_cap);
+            } catch (...) {
+                _Ctrl_traits::deallocate(_ctrl_al, ctrl, new_cap + _group_width);
+                throw;
+            }
+
+            _ctrl = ctrl;
+            _capacity = new_cap;
+            reset_ctrl();
+        }
+
+        void deallocate_table() noexcept {
+            if (_capacity) {
+                _Ctrl_traits::deallocate(_ctrl_al, _ctrl, _capacity + _group_width);
+                _Slot_traits::deallocate(_al, _slots, _capacity);
+            }
+            default_init();
+        }
+
+        void destroy_slots() noexcept {
+            for (size_type i = 0; i != _capacity; ++i) {
+                if (_ctrl_is_full(_ctrl[i])) _Slot_traits::destroy(_al, _slots + i);
+            }
+        }
+
+        void destroy_table() noexcept {
+            destroy_slots();
+            deallocate_table();
+        }
+
+        // table must be empty when called, values are moved out of rhs if Move is std::true_type
+        template <class Move = std::false_type>
+        void copy_table(const _Hashtable& rhs, Move move = Move()) {
+            reserve(rhs._size);
+            for (size_type i = 0; i != rhs._capacity; ++i) {
+                if (_ctrl_is_full(rhs._ctrl[i])) copy_slot(rhs._slots + i, move);
+            }
+        }
+
+        void copy_slot(const_pointer from, std::false_type) {
+            const key_type& key = KeyofValue()(*from);
+            size_t hash = hash_of(key);
+            size_type i = prepare_insert(hash);
+            _Slot_traits::construct(_al, _slots + i, *from);
+            commit_insert(i, hash);
+        }
+
+        void copy_slot(const_pointer from, std::true_type) {
+            const key_type& key = KeyofValue()(*from);
+            size_t hash = hash_of(key);
+            size_type i = prepare_insert(hash);
+            _Slot_traits::construct(_al, _slots + i, std::move(*const_cast<pointer>(from)));
+            commit_insert(i, hash);
+        }
+
+        void swap_data(_Hashtable& other) noexcept {
+            std::swap(_ctrl, other._ctrl);
+            std::swap(_slots, other._slots);
+            std::swap(_capacity, other._capacity);
+            std::swap(_size, other._size);
+            std::swap(_growth_left, other._growth_left);
+        }
+
+        // take over the table of rhs, which must be releasable by this allocator
+        void steal(_Hashtable& rhs) noexcept {
+            swap_data(rhs);
+            _hash = rhs._hash;
+            _equal = rhs._equal;
+        }
+
+        void move_assign(_Hashtable& rhs, std::true_type) {
+            destroy_table();
+            _al = std::move(rhs._al);
+            _ctrl_al = std::move(rhs._ctrl_al);
+            steal(rhs);
+        }
+
+        void move_assign(_Hashtable& rhs, std::false_type) {
+            destroy_table();
+            if (_al == rhs._al) {
+                steal(rhs);
+            } else {
+                _hash = rhs._hash;
+                _equal = rhs._equal;
+                copy_table(rhs, std::true_type());
+                rhs.destroy_table();
+            }
+        }
+    };
+} // namespace MyStl
+
+#endif
@@ -0,0 +1,539 @@
+#ifndef MYSTL_MAP_H
+#define MYSTL_MAP_H
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include "tree.h"
+
+namespace MyStl {
+template <class Key, class T, class Compare = std::less<Key>,
+          class Alloc = std::allocator<std::pair<const Key, T>>>
+class map {
+public:
+    typedef Key                 key_type;
+    typedef T                   mapped_type;
+    typedef std::pair<const Key, T> value_type;
+    typedef Compare             key_compare;
+    typedef Alloc                                                         allocator_type;
+    typedef typename std::allocator_traits<allocator_type>::pointer       pointer;
+    typedef typename std::allocator_traits<allocator_type>::const_pointer const_pointer;
+
+    // orders values by their keys
+    class value_compare {
+        friend class map;
+
+        protected:
+            Compare comp;
+
+            value_compare(Compare c): comp(c) {}
+
+        public:
+            bool operator()(const value_type& lhs, const value_type& rhs) const {
+                return comp(lhs.first, rhs.first);
+            }
+    };
+
+private:
+    typedef MyStl::_RB_tree<key_type, value_type, 
+        std::_Select1st<value_type>, key_compare, allocator_type> _Rep_type;
+
+public:
+    typedef typename _Rep_type::size_type               size_type;
+    typedef typename _Rep_type::difference_type         difference_type;
+    typedef typename _Rep_type::reference               reference;
+    typedef typename _Rep_type::const_reference         const_reference;
+    typedef typename _Rep_type::iterator                iterator;
+    typedef typename _Rep_type::const_iterator          const_iterator;
+    typedef typename _Rep_type::reverse_iterator        reverse_iterator;
+    typedef typename _Rep_type::const_reverse_iterator  const_reverse_iterator;
+
+private:
+    _Rep_type _tree;
+
+public:
+    /* constructors and destructors */
+    map() = default;
+
+    explicit map(const Compare& comp, const Alloc& al = Alloc()): _tree(comp, al) {}
+
+    explicit map(const Alloc& al): _tree(al) {}
+
+    template <class InputIt>
+    map(InputIt first, InputIt last, const Compare& comp = Compare(), const Alloc& al = Alloc())
+        : _tree(comp, al) {
+        _tree.insert_unique(first, last);
+    }
+
+    // [first, last) must already be sorted and free of duplicates, the tree is built in O(n)
+    template <class InputIt>
+    map(sorted_unique_t tag, InputIt first, InputIt last, const Compare& comp = Compare(), const Alloc& al = Alloc())
+        : _tree(comp, al) {
+        _tree.insert_unique(tag, first, last);
+    }
+
+    map(const map& other): _tree(other._tree) {}
+
+    map(const map& other, const Alloc& al): _tree(other._tree, al) {}
+
+    map(map&& other): _tree(std::move(other._tree)) {}
+
+    map(map&& other, const Alloc& al): _tree(std::move(other._tree), al) {}
+
+    map(std::initializer_list<value_type> ilist, const Compare& comp = Compare(), const Alloc& al = Alloc())
+        : _tree(comp, al) {
+        _tree.insert_unique(ilist);
+    }
+
+    map& operator=(const map& other) = default;
+
+    map& operator=(map&& other) = default;
+
+    map& operator=(std::initializer_list<value_type> ilist) {
+        _tree.clear();
+        _tree.insert_unique(ilist);
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept {return _tree.get_allocator();}
+
+    /* element access */
+    mapped_type& at(const key_type& key) {
+        auto i = _tree.find(key);
+        if (i == _tree.end()) throw std::out_of_range("key not found in map");
+
+        return i->second;
+    }
+
+    const mapped_type& at(const key_type& key) const {
+        auto i = _tree.find(key);
+        if (i == _tree.end()) throw std::out_of_range("key not found in map");
+
+        return i->second;
+    }
+
+    mapped_type& operator[](const key_type& key) {return try_emplace(key).first->second;}
+
+    mapped_type& operator[](key_type&& key) {return try_emplace(std::move(key)).first->second;}
+
+    /* iterators */
+    iterator begin() noexcept {return _tree.begin();}
+
+    const_iterator begin() const noexcept {return _tree.begin();}
+
+    const_iterator cbegin() const noexcept {return _tree.cbegin();}
+
+    iterator end() noexcept {return _tree.end();}
+
+    const_iterator end() const noexcept {return _tree.end();}
+
+    const_iterator cend() const noexcept {return _tree.cend();}
+
+    reverse_iterator rbegin() noexcept {return _tree.rbegin();}
+
+    const_reverse_iterator rbegin() const noexcept {return _tree.rbegin();}
+
+    const_reverse_iterator crbegin() const noexcept {return _tree.crbegin();}
+
+    reverse_iterator rend() noexcept {return _tree.rend();}
+
+    const_reverse_iterator rend() const noexcept {return _tree.rend();}
+
+    const_reverse_iterator crend() const noexcept {return _tree.crend();}
+
+    /* capacity */
+    bool empty() const noexcept {return _tree.empty();}
+
+    size_type size() const noexcept {return _tree.size();}
+
+    size_type max_size() const noexcept {return _tree.capacity();}
+
+    /* modifiers */
+    void clear() noexcept {_tree.clear();}
+
+    std::pair<iterator, bool> insert(const value_type& value) {return _tree.insert_unique(value);}
+
+    std::pair<iterator, bool> insert(value_type&& value) {return _tree.insert_unique(std::move(value));}
+
+    template <class P,
+              typename std::enable_if<std::is_constructible<value_type, P&&>::value, int>::type = 0>
+    std::pair<iterator, bool> insert(P&& value) {return _tree.insert_unique(std::forward<P>(value));}
+
+    iterator insert(const_iterator hint, const value_type& value) {return _tree.insert_unique(hint, value);}
+
+    template <class P,
+              typename std::enable_if<std::is_constructible<value_type, P&&>::value, int>::type = 0>
+    iterator insert(const_iterator hint, P&& value) {return _tree.insert_unique(hint, std::forward<P>(value));}
+
+    template <class InputIt>
+    void insert(InputIt first, InputIt last) {_tree.insert_unique(first, last);}
+
+    template <class InputIt>
+    void insert(sorted_unique_t tag, InputIt first, InputIt last) {_tree.insert_unique(tag, first, last);}
+
+    void insert(std::initializer_list<value_type> ilist) {_tree.insert_unique(ilist);}
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+        auto res = try_emplace(key, std::forward<M>(obj));
+        if (!res.second) res.first->second = std::forward<M>(obj);
+        return res;
+    }
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj) {
+        auto res = try_emplace(std::move(key), std::forward<M>(obj));
+        if (!res.second) res.first->second = std::forward<M>(obj);
+        return res;
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {return _tree.emplace_unique(std::forward<Args>(args)...);}
+
+    template <class... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        return _tree.emplace_hint(hint, std::forward<Args>(args)...);
+    }
+
+    // the mapped value is only constructed if key is not present
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+        return _tree.emplace_key_unique(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                        std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        return _tree.emplace_key_unique(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                                        std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    iterator erase(const_iterator pos) {return _tree.erase(pos);}
+
+    iterator erase(iterator pos) {return _tree.erase(pos);}
+
+    iterator erase(const_iterator first, const_iterator last) {return _tree.erase(first, last);}
+
+    size_type erase(const key_type& key) {return _tree.erase(key);}
+
+    void swap(map& other) {_tree.swap(other._tree);}
+
+    /* lookup, the template overloads take anything a transparent Compare can compare with a key */
+    size_type count(const key_type& key) const {return _tree.count_unique(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    size_type count(const K& x) const {return _tree.count_equal(x);}
+
+    iterator find(const key_type& key) {return _tree.find(key);}
+
+    const_iterator find(const key_type& key) const {return _tree.find(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator find(const K& x) {return _tree.find(x);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator find(const K& x) const {return _tree.find(x);}
+
+    bool contains(const key_type& key) const {return find(key) != end();}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    bool contains(const K& x) const {return find(x) != end();}
+
+    std::pair<iterator, iterator> equal_range(const key_type& key) {return _tree.equal_range_unique(key);}
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return _tree.equal_range_unique(key);
+    }
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K& x) {return _tree.equal_range_equal(x);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K& x) const {return _tree.equal_range_equal(x);}
+
+    iterator lower_bound(const key_type& key) {return _tree.lower_bound(key);}
+
+    const_iterator lower_bound(const key_type& key) const {return _tree.lower_bound(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator lower_bound(const K& x) {return _tree.lower_bound(x);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator lower_bound(const K& x) const {return _tree.lower_bound(x);}
+
+    iterator upper_bound(const key_type& key) {return _tree.upper_bound(key);}
+
+    const_iterator upper_bound(const key_type& key) const {return _tree.upper_bound(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator upper_bound(const K& x) {return _tree.upper_bound(x);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator upper_bound(const K& x) const {return _tree.upper_bound(x);}
+
+    /* observers */
+    key_compare key_comp() const {return _tree.key_comp();}
+
+    value_compare value_comp() const {return value_compare(_tree.key_comp());}
+};
+
+/* keys may appear several times, equal keys are kept in insertion order */
+template <class Key, class T, class Compare = std::less<Key>,
+          class Alloc = std::allocator<std::pair<const Key, T>>>
+class multimap {
+public:
+    typedef Key                 key_type;
+    typedef T                   mapped_type;
+    typedef std::pair<const Key, T> value_type;
+    typedef Compare             key_compare;
+    typedef Alloc                                                         allocator_type;
+    typedef typename std::allocator_traits<allocator_type>::pointer       pointer;
+    typedef typename std::allocator_traits<allocator_type>::const_pointer const_pointer;
+
+    // orders values by their keys
+    class value_compare {
+        friend class multimap;
+
+        protected:
+            Compare comp;
+
+            value_compare(Compare c): comp(c) {}
+
+        public:
+            bool operator()(const value_type& lhs, const value_type& rhs) const {
+                return comp(lhs.first, rhs.first);
+            }
+    };
+
+private:
+    typedef MyStl::_RB_tree<key_type, value_type, 
+        std::_Select1st<value_type>, key_compare, allocator_type> _Rep_type;
+
+public:
+    typedef typename _Rep_type::size_type               size_type;
+    typedef typename _Rep_type::difference_type         difference_type;
+    typedef typename _Rep_type::reference               reference;
+    typedef typename _Rep_type::const_reference         const_reference;
+    typedef typename _Rep_type::iterator                iterator;
+    typedef typename _Rep_type::const_iterator          const_iterator;
+    typedef typename _Rep_type::reverse_iterator        reverse_iterator;
+    typedef typename _Rep_type::const_reverse_iterator  const_reverse_iterator;
+
+private:
+    _Rep_type _tree;
+
+public:
+    /* constructors and destructors */
+    multimap() = default;
+
+    explicit multimap(const Compare& comp, const Alloc& al = Alloc()): _tree(comp, al) {}
+
+    explicit multimap(const Alloc& al): _tree(al) {}
+
+    template <class InputIt>
+    multimap(InputIt first, InputIt last, const Compare& comp = Compare(), const Alloc& al = Alloc())
+        : _tree(comp, al) {
+        _tree.insert_equal(first, last);
+    }
+
+    // [first, last) must already be sorted, the tree is built in O(n)
+    template <class InputIt>
+    multimap(sorted_equivalent_t tag, InputIt first, InputIt last, const Compare& comp = Compare(), const Alloc& al = Alloc())
+        : _tree(comp, al) {
+        _tree.insert_equal(tag, first, last);
+    }
+
+    multimap(const multimap& other): _tree(other._tree) {}
+
+    multimap(const multimap& other, const Alloc& al): _tree(other._tree, al) {}
+
+    multimap(multimap&& other): _tree(std::move(other._tree)) {}
+
+    multimap(multimap&& other, const Alloc& al): _tree(std::move(other._tree), al) {}
+
+    multimap(std::initializer_list<value_type> ilist, const Compare& comp = Compare(), const Alloc& al = Alloc())
+        : _tree(comp, al) {
+        _tree.insert_equal(ilist);
+    }
+
+    multimap& operator=(const multimap& other) = default;
+
+    multimap& operator=(multimap&& other) = default;
+
+    multimap& operator=(std::initializer_list<value_type> ilist) {
+        _tree.clear();
+        _tree.insert_equal(ilist);
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept {return _tree.get_allocator();}
+
+    /* iterators */
+    iterator begin() noexcept {return _tree.begin();}
+
+    const_iterator begin() const noexcept {return _tree.begin();}
+
+    const_iterator cbegin() const noexcept {return _tree.cbegin();}
+
+    iterator end() noexcept {return _tree.end();}
+
+    const_iterator end() const noexcept {return _tree.end();}
+
+    const_iterator cend() const noexcept {return _tree.cend();}
+
+    reverse_iterator rbegin() noexcept {return _tree.rbegin();}
+
+    const_reverse_iterator rbegin() const noexcept {return _tree.rbegin();}
+
+    const_reverse_iterator crbegin() const noexcept {return _tree.crbegin();}
+
+    reverse_iterator rend() noexcept {return _tree.rend();}
+
+    const_reverse_iterator rend() const noexcept {return _tree.rend();}
+
+    const_reverse_iterator crend() const noexcept {return _tree.crend();}
+
+    /* capacity */
+    bool empty() const noexcept {return _tree.empty();}
+
+    size_type size() const noexcept {return _tree.size();}
+
+    size_type max_size() const noexcept {return _tree.capacity();}
+
+    /* modifiers */
+    void clear() noexcept {_tree.clear();}
+
+    iterator insert(const value_type& value) {return _tree.insert_equal(value);}
+
+    iterator insert(value_type&& value) {return _tree.insert_equal(std::move(value));}
+
+    template <class P,
+              typename std::enable_if<std::is_constructible<value_type, P&&>::value, int>::type = 0>
+    iterator insert(P&& value) {return _tree.insert_equal(std::forward<P>(value));}
+
+    iterator insert(const_iterator hint, const value_type& value) {return _tree.insert_equal(hint, value);}
+
+    template <class P,
+              typename std::enable_if<std::is_constructible<value_type, P&&>::value, int>::type = 0>
+    iterator insert(const_iterator hint, P&& value) {return _tree.insert_equal(hint, std::forward<P>(value));}
+
+    template <class InputIt>
+    void insert(InputIt first, InputIt last) {_tree.insert_equal(first, last);}
+
+    template <class InputIt>
+    void insert(sorted_equivalent_t tag, InputIt first, InputIt last) {_tree.insert_equal(tag, first, last);}
+
+    void insert(std::initializer_list<value_type> ilist) {_tree.insert_equal(ilist);}
+
+    template <class... Args>
+    iterator emplace(Args&&... args) {return _tree.emplace_equal(std::forward<Args>(args)...);}
+
+    template <class... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        return _tree.emplace_hint_equal(hint, std::forward<Args>(args)...);
+    }
+
+    iterator erase(const_iterator pos) {return _tree.erase(pos);}
+
+    iterator erase(iterator pos) {return _tree.erase(pos);}
+
+    iterator erase(const_iterator first, const_iterator last) {return _tree.erase(first, last);}
+
+    size_type erase(const key_type& key) {return _tree.erase_equal(key);}
+
+    void swap(multimap& other) {_tree.swap(other._tree);}
+
+    /* lookup, the template overloads take anything a transparent Compare can compare with a key */
+    size_type count(const key_type& key) const {return _tree.count_equal(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    size_type count(const K& x) const {return _tree.count_equal(x);}
+
+    // any of the equal keys, not necessarily the first one
+    iterator find(const key_type& key) {return _tree.find(key);}
+
+    const_iterator find(const key_type& key) const {return _tree.find(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator find(const K& x) {return _tree.find(x);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator find(const K& x) const {return _tree.find(x);}
+
+    bool contains(const key_type& key) const {return find(key) != end();}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    bool contains(const K& x) const {return find(x) != end();}
+
+    std::pair<iterator, iterator> equal_range(const key_type& key) {return _tree.equal_range_equal(key);}
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return _tree.equal_range_equal(key);
+    }
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K& x) {return _tree.equal_range_equal(x);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K& x) const {return _tree.equal_range_equal(x);}
+
+    iterator lower_bound(const key_type& key) {return _tree.lower_bound(key);}
+
+    const_iterator lower_bound(const key_type& key) const {return _tree.lower_bound(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator lower_bound(const K& x) {return _tree.lower_bound(x);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator lower_bound(const K& x) const {return _tree.lower_bound(x);}
+
+    iterator upper_bound(const key_type& key) {return _tree.upper_bound(key);}
+
+    const_iterator upper_bound(const key_type& key) const {return _tree.upper_bound(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator upper_bound(const K& x) {return _tree.upper_bound(x);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    const_iterator upper_bound(const K& x) const {return _tree.upper_bound(x);}
+
+    /* observers */
+    key_compare key_comp() const {return _tree.key_comp();}
+
+    value_compare value_comp() const {return value_compare(_tree.key_comp());}
+};
+
+/* operators, both containers iterate in key order */
+template <class Key, class T, class Compare, class Alloc>
+bool operator==(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
+    return lhs.size() == rhs.size() && MyStl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class Key, class T, class Compare, class Alloc>
+bool operator!=(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare, class Alloc>
+bool operator<(const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
+    return MyStl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class Key, class T, class Compare, class Alloc>
+bool operator==(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs) {
+    return lhs.size() == rhs.size() && MyStl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class Key, class T, class Compare, class Alloc>
+bool operator!=(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class T, class Compare, class Alloc>
+bool operator<(const multimap<Key, T, Compare, Alloc>& lhs, const multimap<Key, T, Compare, Alloc>& rhs) {
+    return MyStl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+} // namespace MyStl
+
+#endif
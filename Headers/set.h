@@ -6,29 +6,30 @@
 #include "tree.h"
 
 namespace MyStl {
-template <class Key, class Compare = std::less<Key>>
+template <class Key, class Compare = std::less<Key>, class Alloc = std::allocator<Key>>
 class set {
 public:
     typedef Key                 key_type;
     typedef Key                 value_type;
     typedef Compare             key_compare;
     typedef Compare             value_compare;
-    typedef std::allocator<key_type>                             allocator_type;
-    typedef std::allocator_traits<allocator_type>::pointer       pointer;
-    typedef std::allocator_traits<allocator_type>::const_pointer const_pointer;
+    typedef Alloc                                                         allocator_type;
+    typedef typename std::allocator_traits<allocator_type>::pointer       pointer;
+    typedef typename std::allocator_traits<allocator_type>::const_pointer const_pointer;
 
 private:
     typedef MyStl::_RB_tree<key_type, value_type, 
-        std::_Identity<value_type>, key_compare> _Rep_type;
+        std::_Identity<value_type>, key_compare, allocator_type> _Rep_type;
 
 public:
     typedef typename _Rep_type::size_type               size_type;
     typedef typename _Rep_type::difference_type         difference_type;
-    typedef typename _Rep_type::reference_type          reference_type;
+    typedef typename _Rep_type::reference               reference;
     typedef typename _Rep_type::const_reference         const_reference;
-    typedef typename _Rep_type::iterator                iteraotr;
+    // keys must not be modified in place, their position depends on them
+    typedef typename _Rep_type::const_iterator          iterator;
     typedef typename _Rep_type::const_iterator          const_iterator;
-    typedef typename _Rep_type::reverse_iterator        reverse_iterator;
+    typedef typename _Rep_type::const_reverse_iterator  reverse_iterator;
     typedef typename _Rep_type::const_reverse_iterator  const_reverse_iterator;
 
 private:
@@ -38,23 +39,346 @@ public:
     /* constructors and destructors */
     set() = default;
 
-    explicit set(const Compare& comp): _tree(comp) {}
+    explicit set(const Compare& comp, const Alloc& al = Alloc()): _tree(comp, al) {}
+
+    explicit set(const Alloc& al): _tree(al) {}
 
     template <class InputIt>
-    set(InputIt first, InputIt last): _tree() {
+    set(InputIt first, InputIt last, const Compare& comp = Compare(), const Alloc& al = Alloc())
+        : _tree(comp, al) {
         _tree.insert_unique(first, last);
     }
 
+    // [first, last) must already be sorted and free of duplicates, the tree is built in O(n)
+    template <class InputIt>
+    set(sorted_unique_t tag, InputIt first, InputIt last, const Compare& comp = Compare(), const Alloc& al = Alloc())
+        : _tree(comp, al) {
+        _tree.insert_unique(tag, first, last);
+    }
+
     set(const set& other): _tree(other._tree) {}
 
+    set(const set& other, const Alloc& al): _tree(other._tree, al) {}
+
     set(set&& other): _tree(std::move(other._tree)) {}
 
-    set(std::initializer_list<value_type> ilist, const Compare& comp)
-        : _tree() {
-        _tree._key_compare = comp;
-        _tree.insert_unique(ilist.begin(), ilist.end());
+    set(set&& other, const Alloc& al): _tree(std::move(other._tree), al) {}
+
+    set(std::initializer_list<value_type> ilist, const Compare& comp = Compare(), const Alloc& al = Alloc())
+        : _tree(comp, al) {
+        _tree.insert_unique(ilist);
+    }
+
+    set& operator=(const set& other) = default;
+
+    set& operator=(set&& other) = default;
+
+    set& operator=(std::initializer_list<value_type> ilist) {
+        _tree.clear();
+        _tree.insert_unique(ilist);
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept {return _tree.get_allocator();}
+
+    /* iterators */
+    iterator begin() const noexcept {return _tree.begin();}
+
+    const_iterator cbegin() const noexcept {return _tree.cbegin();}
+
+    iterator end() const noexcept {return _tree.end();}
+
+    const_iterator cend() const noexcept {return _tree.cend();}
+
+    reverse_iterator rbegin() const noexcept {return _tree.rbegin();}
+
+    const_reverse_iterator crbegin() const noexcept {return _tree.crbegin();}
+
+    reverse_iterator rend() const noexcept {return _tree.rend();}
+
+    const_reverse_iterator crend() const noexcept {return _tree.crend();}
+
+    /* capacity */
+    bool empty() const noexcept {return _tree.empty();}
+
+    size_type size() const noexcept {return _tree.size();}
+
+    size_type max_size() const noexcept {return _tree.capacity();}
+
+    /* modifiers */
+    void clear() noexcept {_tree.clear();}
+
+    std::pair<iterator, bool> insert(const value_type& value) {return _tree.insert_unique(value);}
+
+    std::pair<iterator, bool> insert(value_type&& value) {return _tree.insert_unique(std::move(value));}
+
+    iterator insert(const_iterator hint, const value_type& value) {return _tree.insert_unique(hint, value);}
+
+    iterator insert(const_iterator hint, value_type&& value) {return _tree.insert_unique(hint, std::move(value));}
+
+    template <class InputIt>
+    void insert(InputIt first, InputIt last) {_tree.insert_unique(first, last);}
+
+    template <class InputIt>
+    void insert(sorted_unique_t tag, InputIt first, InputIt last) {_tree.insert_unique(tag, first, last);}
+
+    void insert(std::initializer_list<value_type> ilist) {_tree.insert_unique(ilist);}
+
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {return _tree.emplace_unique(std::forward<Args>(args)...);}
+
+    template <class... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        return _tree.emplace_hint(hint, std::forward<Args>(args)...);
     }
+
+    iterator erase(const_iterator pos) {return _tree.erase(pos);}
+
+    iterator erase(const_iterator first, const_iterator last) {return _tree.erase(first, last);}
+
+    size_type erase(const key_type& key) {return _tree.erase(key);}
+
+    void swap(set& other) {_tree.swap(other._tree);}
+
+    /* lookup, the template overloads take anything a transparent Compare can compare with a key */
+    size_type count(const key_type& key) const {return _tree.count_unique(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    size_type count(const K& x) const {return _tree.count_unique(x);}
+
+    iterator find(const key_type& key) const {return _tree.find(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator find(const K& x) const {return _tree.find(x);}
+
+    bool contains(const key_type& key) const {return find(key) != end();}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    bool contains(const K& x) const {return find(x) != end();}
+
+    std::pair<iterator, iterator> equal_range(const key_type& key) const {return _tree.equal_range_unique(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K& x) const {return _tree.equal_range_equal(x);}
+
+    iterator lower_bound(const key_type& key) const {return _tree.lower_bound(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator lower_bound(const K& x) const {return _tree.lower_bound(x);}
+
+    iterator upper_bound(const key_type& key) const {return _tree.upper_bound(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator upper_bound(const K& x) const {return _tree.upper_bound(x);}
+
+    /* observers */
+    key_compare key_comp() const {return _tree.key_comp();}
+
+    value_compare value_comp() const {return _tree.key_comp();}
 };
+
+/* keys may appear several times, equal keys are kept in insertion order */
+template <class Key, class Compare = std::less<Key>, class Alloc = std::allocator<Key>>
+class multiset {
+public:
+    typedef Key                 key_type;
+    typedef Key                 value_type;
+    typedef Compare             key_compare;
+    typedef Compare             value_compare;
+    typedef Alloc                                                         allocator_type;
+    typedef typename std::allocator_traits<allocator_type>::pointer       pointer;
+    typedef typename std::allocator_traits<allocator_type>::const_pointer const_pointer;
+
+private:
+    typedef MyStl::_RB_tree<key_type, value_type, 
+        std::_Identity<value_type>, key_compare, allocator_type> _Rep_type;
+
+public:
+    typedef typename _Rep_type::size_type               size_type;
+    typedef typename _Rep_type::difference_type         difference_type;
+    typedef typename _Rep_type::reference               reference;
+    typedef typename _Rep_type::const_reference         const_reference;
+    typedef typename _Rep_type::const_iterator          iterator;
+    typedef typename _Rep_type::const_iterator          const_iterator;
+    typedef typename _Rep_type::const_reverse_iterator  reverse_iterator;
+    typedef typename _Rep_type::const_reverse_iterator  const_reverse_iterator;
+
+private:
+    _Rep_type _tree;
+
+public:
+    /* constructors and destructors */
+    multiset() = default;
+
+    explicit multiset(const Compare& comp, const Alloc& al = Alloc()): _tree(comp, al) {}
+
+    explicit multiset(const Alloc& al): _tree(al) {}
+
+    template <class InputIt>
+    multiset(InputIt first, InputIt last, const Compare& comp = Compare(), const Alloc& al = Alloc())
+        : _tree(comp, al) {
+        _tree.insert_equal(first, last);
+    }
+
+    // [first, last) must already be sorted, the tree is built in O(n)
+    template <class InputIt>
+    multiset(sorted_equivalent_t tag, InputIt first, InputIt last, const Compare& comp = Compare(), const Alloc& al = Alloc())
+        : _tree(comp, al) {
+        _tree.insert_equal(tag, first, last);
+    }
+
+    multiset(const multiset& other): _tree(other._tree) {}
+
+    multiset(const multiset& other, const Alloc& al): _tree(other._tree, al) {}
+
+    multiset(multiset&& other): _tree(std::move(other._tree)) {}
+
+    multiset(multiset&& other, const Alloc& al): _tree(std::move(other._tree), al) {}
+
+    multiset(std::initializer_list<value_type> ilist, const Compare& comp = Compare(), const Alloc& al = Alloc())
+        : _tree(comp, al) {
+        _tree.insert_equal(ilist);
+    }
+
+    multiset& operator=(const multiset& other) = default;
+
+    multiset& operator=(multiset&& other) = default;
+
+    multiset& operator=(std::initializer_list<value_type> ilist) {
+        _tree.clear();
+        _tree.insert_equal(ilist);
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept {return _tree.get_allocator();}
+
+    /* iterators */
+    iterator begin() const noexcept {return _tree.begin();}
+
+    const_iterator cbegin() const noexcept {return _tree.cbegin();}
+
+    iterator end() const noexcept {return _tree.end();}
+
+    const_iterator cend() const noexcept {return _tree.cend();}
+
+    reverse_iterator rbegin() const noexcept {return _tree.rbegin();}
+
+    const_reverse_iterator crbegin() const noexcept {return _tree.crbegin();}
+
+    reverse_iterator rend() const noexcept {return _tree.rend();}
+
+    const_reverse_iterator crend() const noexcept {return _tree.crend();}
+
+    /* capacity */
+    bool empty() const noexcept {return _tree.empty();}
+
+    size_type size() const noexcept {return _tree.size();}
+
+    size_type max_size() const noexcept {return _tree.capacity();}
+
+    /* modifiers */
+    void clear() noexcept {_tree.clear();}
+
+    iterator insert(const value_type& value) {return _tree.insert_equal(value);}
+
+    iterator insert(value_type&& value) {return _tree.insert_equal(std::move(value));}
+
+    iterator insert(const_iterator hint, const value_type& value) {return _tree.insert_equal(hint, value);}
+
+    iterator insert(const_iterator hint, value_type&& value) {return _tree.insert_equal(hint, std::move(value));}
+
+    template <class InputIt>
+    void insert(InputIt first, InputIt last) {_tree.insert_equal(first, last);}
+
+    template <class InputIt>
+    void insert(sorted_equivalent_t tag, InputIt first, InputIt last) {_tree.insert_equal(tag, first, last);}
+
+    void insert(std::initializer_list<value_type> ilist) {_tree.insert_equal(ilist);}
+
+    template <class... Args>
+    iterator emplace(Args&&... args) {return _tree.emplace_equal(std::forward<Args>(args)...);}
+
+    template <class... Args>
+    iterator emplace_hint(const_iterator hint, Args&&... args) {
+        return _tree.emplace_hint_equal(hint, std::forward<Args>(args)...);
+    }
+
+    iterator erase(const_iterator pos) {return _tree.erase(pos);}
+
+    iterator erase(const_iterator first, const_iterator last) {return _tree.erase(first, last);}
+
+    size_type erase(const key_type& key) {return _tree.erase_equal(key);}
+
+    void swap(multiset& other) {_tree.swap(other._tree);}
+
+    /* lookup, the template overloads take anything a transparent Compare can compare with a key */
+    size_type count(const key_type& key) const {return _tree.count_equal(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    size_type count(const K& x) const {return _tree.count_equal(x);}
+
+    // any of the equal keys, not necessarily the first one
+    iterator find(const key_type& key) const {return _tree.find(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator find(const K& x) const {return _tree.find(x);}
+
+    bool contains(const key_type& key) const {return find(key) != end();}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    bool contains(const K& x) const {return find(x) != end();}
+
+    std::pair<iterator, iterator> equal_range(const key_type& key) const {return _tree.equal_range_equal(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K& x) const {return _tree.equal_range_equal(x);}
+
+    iterator lower_bound(const key_type& key) const {return _tree.lower_bound(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator lower_bound(const K& x) const {return _tree.lower_bound(x);}
+
+    iterator upper_bound(const key_type& key) const {return _tree.upper_bound(key);}
+
+    template <class K, class C = Compare, class = typename C::is_transparent>
+    iterator upper_bound(const K& x) const {return _tree.upper_bound(x);}
+
+    /* observers */
+    key_compare key_comp() const {return _tree.key_comp();}
+
+    value_compare value_comp() const {return _tree.key_comp();}
+};
+
+/* operators, both containers iterate in key order */
+template <class Key, class Compare, class Alloc>
+bool operator==(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
+    return lhs.size() == rhs.size() && MyStl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator!=(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator<(const set<Key, Compare, Alloc>& lhs, const set<Key, Compare, Alloc>& rhs) {
+    return MyStl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator==(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs) {
+    return lhs.size() == rhs.size() && MyStl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator!=(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class Key, class Compare, class Alloc>
+bool operator<(const multiset<Key, Compare, Alloc>& lhs, const multiset<Key, Compare, Alloc>& rhs) {
+    return MyStl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
 } // namespace MyStl
 
-#endif
\ No newline at end of file
+#endif
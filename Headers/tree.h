@@ -5,8 +5,12 @@
 #define MYSTL_TREE_H
 
 #include "Iterator.h"
+#include "Algorithm.h"
 #include <assert.h>
+#include <functional>
 #include <memory>
+#include <utility>
+#include <initializer_list>
 namespace MyStl
 {
     enum _RB_tree_color {
@@ -129,6 +133,16 @@ namespace MyStl
             _node_base = other._node_base;
         }
 
+        // iterator to const_iterator
+        template <class P, class R,
+                  typename std::enable_if<!std::is_same<P, pointer>::value &&
+                                          std::is_convertible<P, pointer>::value, int>::type = 0>
+        _RB_tree_iterator(const _RB_tree_iterator<T, P, R>& other) {
+            _node_base = other._node_base;
+        }
+
+        _RB_tree_iterator& operator=(const _RB_tree_iterator& other) = default;
+
         _Self& operator++() {
             increment();
             return *this;
@@ -151,14 +165,22 @@ namespace MyStl
             return tmp;
         }
 
-        pointer operator->() {
+        pointer operator->() const {
             return static_cast<_Node_Ptr>(_node_base)->_val_ptr();
         }
 
-        reference operator*() {
+        reference operator*() const {
             return *static_cast<_Node_Ptr>(_node_base)->_val_ptr();
         }
 
+        bool operator==(const _Self& rhs) const {
+            return _node_base == rhs._node_base;
+        }
+
+        bool operator!=(const _Self& rhs) const {
+            return _node_base != rhs._node_base;
+        }
+
     private:
         void increment() noexcept {
             if (_node_base->_right) {
@@ -180,7 +202,10 @@ namespace MyStl
         }
 
         void decrement() noexcept {
-            if (_node_base->_left) {
+            if (_node_base->_is_red() && _node_base->_parent && _node_base->_parent->_parent == _node_base) {
+                // the header is the only red node whose grandparent is itself, --end() is the maximum
+                _node_base = _node_base->_right;
+            } else if (_node_base->_left) {
                 _node_base = _Node_base::_max(_node_base->_left);
             } else {
                 auto p = _node_base->_parent;
@@ -196,7 +221,8 @@ namespace MyStl
         }
     }; 
 
-    template<typename TKey, typename TVal, typename KeyofValue, typename Compare>
+    template<typename TKey, typename TVal, typename KeyofValue, typename Compare, 
+             typename Alloc = std::allocator<TVal>>
     class _RB_tree {
     public:
         typedef TKey                 key_type;
@@ -208,7 +234,7 @@ namespace MyStl
         typedef size_t               size_type;
         typedef ptrdiff_t            difference_type;
         
-        typedef std::allocator<_RB_tree_node<TVal>> allocator_type;
+        typedef Alloc                allocator_type;
 
         typedef _RB_tree_iterator<TVal, pointer, reference> iterator;
         typedef _RB_tree_iterator<TVal, const_pointer, const_reference> const_iterator;
@@ -217,79 +243,123 @@ namespace MyStl
 
         static_assert(std::__is_invocable<Compare, const key_type&, const key_type&>{}, 
                         "Compare predicate must be invocable.");
-        static_assert(std::__is_invocable<KeyofValue, const key_type&, const key_type&>{}, 
+        static_assert(std::__is_invocable<KeyofValue, const value_type&>{}, 
                         "Key getter must be invocable.");
 
     private:
         typedef _RB_tree_node_base _Base_type;
         typedef _Base_type* _Base_ptr;
-        typedef const _Base_type _Const_Base_ptr;
+        typedef const _Base_type* _Const_Base_ptr;
         typedef _RB_tree_node<TVal> _Node_type;
         typedef _Node_type* _Node_ptr;
         typedef const _Node_type* _Const_Node_ptr;
-        typedef _RB_tree<TKey, TVal, KeyofValue, Compare> _Self;
-
-        inline allocator_type _get_al() {return allocator_type();}
+        typedef _RB_tree<TKey, TVal, KeyofValue, Compare, Alloc> _Self;
+        typedef typename std::allocator_traits<Alloc>::template rebind_alloc<_Node_type> _Node_allocator;
+        typedef std::allocator_traits<_Node_allocator> _Node_traits;
+
+        // nodes of a copied or bulk built tree come out of a single allocation,
+        // erased ones are reused by later inserts and the batch is given back once none is in use
+        struct _Node_batch {
+            _Node_ptr _nodes = nullptr;
+            size_type _capacity = 0;
+            size_type _used = 0;        // nodes past this index were never handed out
+            size_type _live = 0;
+            _Base_ptr _free = nullptr;  // erased nodes, linked through _left
+        };
 
     private:
+        _Node_allocator _al;    // nodes and the header are all allocated from here
         _Base_ptr _header;
         size_type _size;
         Compare _key_compare;
+        _Node_batch _batch;
 
         _Base_ptr& root() {return _header->_parent;}
         _Base_ptr& max_node() {return _header->_right;}
         _Base_ptr& min_node() {return _header->_left;}
 
+        _Base_ptr root() const {return _header->_parent;}
+        _Base_ptr max_node() const {return _header->_right;}
+        _Base_ptr min_node() const {return _header->_left;}
+
     public:
         /* constructors and destructors */
-        _RB_tree() {default_init();}
+        _RB_tree() : _RB_tree(Compare()) {}
 
-        _RB_tree(const Compare& comp) {
-            default_init();
-            _key_compare = comp;
+        explicit _RB_tree(const Compare& comp, const Alloc& al = Alloc()) 
+            : _al(al), _key_compare(comp) {
+            create_header();
         }
 
-        _RB_tree(const _RB_tree& rhs) {
-            default_init();
+        explicit _RB_tree(const Alloc& al) : _RB_tree(Compare(), al) {}
 
+        _RB_tree(const _RB_tree& rhs) 
+            : _RB_tree(rhs._key_compare, _Node_traits::select_on_container_copy_construction(rhs._al)) {
+            copy_tree(rhs);
+        }
+
+        _RB_tree(const _RB_tree& rhs, const Alloc& al) : _RB_tree(rhs._key_compare, al) {
             copy_tree(rhs);
         }
 
         _RB_tree(_RB_tree&& rhs)
-            : _header(std::move(rhs._header)),
+            : _al(std::move(rhs._al)),
+              _header(rhs._header),
               _size(rhs._size),
-              _key_compare(rhs._key_compare) {}
+              _key_compare(rhs._key_compare),
+              _batch(rhs._batch) {
+            rhs._header = nullptr;
+            rhs._size = 0;
+            rhs._batch = _Node_batch();
+        }
+
+        _RB_tree(_RB_tree&& rhs, const Alloc& al) : _RB_tree(rhs._key_compare, al) {
+            if (_al == rhs._al) {
+                steal(rhs);
+            } else {
+                // nodes of rhs can't be released by al, so values have to be moved one by one
+                copy_tree(rhs, std::true_type());
+            }
+        }
         
         ~_RB_tree() {
-            clear();
+            destroy_header();
         }
 
         _Self& operator=(const _RB_tree& rhs) {
-            reset();
-            copy_tree(rhs);
+            if (this != &rhs) {
+                // the header has to be given back as well before a different allocator takes over
+                MyStl::alloc_on_copy(_al, rhs._al, [this]() {destroy_header();});
+                if (!_header) create_header();
+
+                reset();
+                copy_tree(rhs);
+            }
             return *this;
         }
 
         _Self& operator=(_RB_tree&& rhs) {
-            reset();
-
-            _header = std::move(rhs._header);
-            _size = rhs._size;
-            _key_compare = rhs._key_compare;
+            if (this != &rhs) {
+                move_assign(rhs, typename _Node_traits::propagate_on_container_move_assignment());
+            }
 
             return *this;
         }
 
+        allocator_type get_allocator() const noexcept {
+            return allocator_type(_al);
+        }
+
         /* capacity */
-        size_type size() {
+        size_type size() const noexcept {
             return _size;
         }
 
-        bool empty() {
+        bool empty() const noexcept {
             return _size == 0;
         }
 
-        size_type capacity() {
+        size_type capacity() const noexcept {
             return -1;
         }
 
@@ -323,7 +393,7 @@ namespace MyStl
         }
 
         const_reverse_iterator rbegin() const noexcept {
-            return reverse_iterator(end());
+            return const_reverse_iterator(end());
         }
 
         reverse_iterator rend() noexcept {
@@ -331,7 +401,7 @@ namespace MyStl
         }
 
         const_reverse_iterator rend()  const noexcept {
-            return reverse_iterator(begin());
+            return const_reverse_iterator(begin());
         }
 
         const_reverse_iterator crbegin() const noexcept {
@@ -378,15 +448,25 @@ namespace MyStl
             return emplace_hint(hint, std::forward<P>(other));
         }
 
+        // a sorted range is built in O(n) if the tree is empty, which needs two passes over it
         template <class InputIt>
         void insert_unique(InputIt first, InputIt last) {
-            size_type num = MyStl::distance(first, last);
-            assert(size() + num <= capacity() && "number of nodes will exceed RB tree capacity");
+            if (empty() && is_sorted_range(first, last, std::true_type(), is_multi_pass<InputIt>())) {
+                build_sorted(first, last, is_multi_pass<InputIt>());
+            } else {
+                append_unique(first, last);
+            }
+        }
 
-            while (num) {
-                insert_unique(*first);
-                ++first;
-                --num;
+        // same as above without checking the order, [first, last) must be sorted and free of duplicates
+        template <class InputIt>
+        void insert_unique(sorted_unique_t, InputIt first, InputIt last) {
+            assert(!is_multi_pass<InputIt>::value || is_sorted_range(first, last, std::true_type(), std::true_type()));
+
+            if (empty()) {
+                build_sorted(first, last, is_multi_pass<InputIt>());
+            } else {
+                append_unique(first, last);
             }
         }
 
@@ -394,30 +474,120 @@ namespace MyStl
             insert_unique(ilist.begin(), ilist.end());
         }
 
+        // args are only used to construct the value if key is not present yet
         template <class...Args>
         std::pair<iterator, bool>
-        emplace_unique(Args&& ...args) {
+        emplace_key_unique(const key_type& key, Args&& ...args) {
             assert(size() < capacity() && "RB tree has reached capacity");
+
+            auto res = get_insert_unique_pos(key);
+            if (!res.second) return std::make_pair(iterator(res.first), false);
+
             auto n = construct_node(std::forward<Args>(args)...);
+            return std::make_pair(insert_at_pos(res.second, n, res.first != nullptr), true);
+        }
 
-            auto res = get_insert_unique_pos(get_key(n));
+        // equal keys are kept in insertion order, a new one goes behind the existing ones
+        iterator insert_equal(const_reference val) {
+            return emplace_equal(val);
+        }
 
-            if (res.second) {
-                return std::make_pair(insert_at_pos(res.second, n, res.first != nullptr), true);
+        template <class P, 
+                  typename std::enable_if<std::is_constructible<value_type, P&&>::value, int>::type = 0>
+        iterator insert_equal(P&& other) {
+            return emplace_equal(std::forward<P>(other));
+        }
+
+        iterator insert_equal(const_iterator hint, const_reference val) {
+            return emplace_hint_equal(hint, val);
+        }
+
+        template <class P,
+                  typename std::enable_if<std::is_constructible<value_type, P&&>::value, int>::type = 0>
+        iterator insert_equal(const_iterator hint, P&& other) {
+            return emplace_hint_equal(hint, std::forward<P>(other));
+        }
+
+        template <class InputIt>
+        void insert_equal(InputIt first, InputIt last) {
+            if (empty() && is_sorted_range(first, last, std::false_type(), is_multi_pass<InputIt>())) {
+                build_sorted(first, last, is_multi_pass<InputIt>());
+            } else {
+                append_equal(first, last);
             }
+        }
 
-            delete_node(n);
-            return std::make_pair(res.first, false);
+        template <class InputIt>
+        void insert_equal(sorted_equivalent_t, InputIt first, InputIt last) {
+            assert(!is_multi_pass<InputIt>::value || is_sorted_range(first, last, std::false_type(), std::true_type()));
+
+            if (empty()) {
+                build_sorted(first, last, is_multi_pass<InputIt>());
+            } else {
+                append_equal(first, last);
+            }
+        }
+
+        void insert_equal(std::initializer_list<value_type> ilist) {
+            insert_equal(ilist.begin(), ilist.end());
+        }
+
+        template <class...Args>
+        iterator emplace_equal(Args&& ...args) {
+            assert(size() < capacity() && "RB tree has reached capacity");
+            auto n = construct_node(std::forward<Args>(args)...);
+
+            try {
+                return insert_at_pos(get_insert_equal_pos(get_key(n)), n, false);
+            } catch (...) {
+                delete_node(n);
+                throw;
+            }
         }
 
         template <class...Args>
-        iterator emplace_hint(iterator hint, Args&& ...args) {
+        iterator emplace_hint_equal(const_iterator hint, Args&& ...args) {
             assert(size() < capacity() && "RB tree has reached capacity");
+            auto n = construct_node(std::forward<Args>(args)...);
+
+            try {
+                auto res = get_emplace_hint_equal_pos(const_cast<_Base_ptr>(hint._node_base), get_key(n));
+                return insert_at_pos(res.second, n, res.first != nullptr);
+            } catch (...) {
+                delete_node(n);
+                throw;
+            }
+        }
 
+        template <class...Args>
+        std::pair<iterator, bool>
+        emplace_unique(Args&& ...args) {
+            assert(size() < capacity() && "RB tree has reached capacity");
             auto n = construct_node(std::forward<Args>(args)...);
 
             try {
-                auto res = get_emplace_hint_unique_pos(hint, get_key(n));
+                auto res = get_insert_unique_pos(get_key(n));
+
+                if (res.second) {
+                    return std::make_pair(insert_at_pos(res.second, n, res.first != nullptr), true);
+                }
+
+                delete_node(n);
+                return std::make_pair(res.first, false);
+            } catch (...) {
+                delete_node(n);
+                throw;
+            }
+        }
+
+        template <class...Args>
+        iterator emplace_hint(const_iterator hint, Args&& ...args) {
+            assert(size() < capacity() && "RB tree has reached capacity");
+
+            auto n = construct_node(std::forward<Args>(args)...);
+
+            try {
+                auto res = get_emplace_hint_unique_pos(iterator(const_cast<_Base_ptr>(hint._node_base)), get_key(n));
                 if (res.second) {
                     return insert_at_pos(res.second, n, res.first != nullptr);
                 }
@@ -438,6 +608,7 @@ namespace MyStl
 
             delete_fix(n);
             delete_node(n);
+            --_size;
             return ret;
         }
 
@@ -464,66 +635,219 @@ namespace MyStl
             return 1;
         }
 
+        // removes every node with an equal key
+        size_type erase_equal(const key_type& key) {
+            auto range = equal_range_equal(key);
+            size_type count = MyStl::distance(range.first, range.second);
+            erase(range.first, range.second);
+            return count;
+        }
+
         void swap(_RB_tree& other) {
-            if (this != other) {
+            if (this != &other) {
+                MyStl::alloc_on_swap(_al, other._al);
                 std::swap(_header, other._header);
                 std::swap(_size, other._size);
                 std::swap(_key_compare, other._key_compare);
+                std::swap(_batch, other._batch);
             }
         }
 
         /* Look up */
-        size_type count_unique (const key_type& key) const {
+        // K is key_type, or anything a transparent Compare accepts next to it,
+        // the containers only forward other types if Compare::is_transparent exists
+        template <class K>
+        size_type count_unique(const K& key) const {
             return find(key) == end() ? 0 : 1;
         }
 
+        template <class K>
+        size_type count_equal(const K& key) const {
+            auto range = equal_range_equal(key);
+            return MyStl::distance(range.first, range.second);
+        }
+
+        template <class K>
         std::pair<iterator, iterator>
-        equal_range_unique(const key_type& key) {
+        equal_range_unique(const K& key) {
             auto i = find(key);
             auto j = i;
             return i == end() ? std::make_pair(end(), end()) : std::make_pair(i, ++j);
         }
 
+        template <class K>
         std::pair<const_iterator, const_iterator>
-        equal_range_unique(const key_type& key) const {
+        equal_range_unique(const K& key) const {
             auto i = find(key);
             auto j = i;
             return i == end() ? std::make_pair(end(), end()) : std::make_pair(i, ++j);
         }
 
-        iterator find(const key_type& key) {
-            auto i = lower_bound(key);
-            return (i == end() || _key_compare(key, get_key(i._base_node))) ? end() : i;
+        template <class K>
+        std::pair<iterator, iterator>
+        equal_range_equal(const K& key) {
+            return std::make_pair(lower_bound(key), upper_bound(key));
         }
 
-        const_iterator find(const key_type& key) const {
-            auto i = lower_bound(key);
-            return (i == end() || _key_compare(key, get_key(i._base_node))) ? end() : i;
+        template <class K>
+        std::pair<const_iterator, const_iterator>
+        equal_range_equal(const K& key) const {
+            return std::make_pair(lower_bound(key), upper_bound(key));
         }
 
-        iterator lower_bound(const key_type& key) {
-            _Base_ptr lb = _header;
-            _Base_ptr cur = root();
+        template <class K>
+        iterator find(const K& key) {
+            return iterator(find_node(key));
+        }
 
-            while (lb) {
-                if (_key_compare(get_key(cur), key)) {
-                    // cur.key < key
-                    cur = cur->_right;
-                } else {
-                    // cur.key >= key
-                    lb = cur;
-                    cur = cur->_left;
-                }
+        template <class K>
+        const_iterator find(const K& key) const {
+            return const_iterator(find_node(key));
+        }
+
+        template <class K>
+        iterator lower_bound(const K& key) {
+            return iterator(lower_bound_node(key));
+        }
+
+        template <class K>
+        const_iterator lower_bound(const K& key) const {
+            return const_iterator(lower_bound_node(key));
+        }
+
+        template <class K>
+        iterator upper_bound(const K& key) {
+            return iterator(upper_bound_node(key));
+        }
+
+        template <class K>
+        const_iterator upper_bound(const K& key) const {
+            return const_iterator(upper_bound_node(key));
+        }
+
+        /* Observers */
+        Compare key_comp() const {
+            return _key_compare;
+        }
+
+
+
+    private:
+        // ranges of single pass iterators can't be looked at twice
+        template <class InputIt>
+        using is_multi_pass = std::integral_constant<bool, MyStl::Is_Forward_Iterator<InputIt>::value>;
+
+        // keys strictly increasing if Unique is std::true_type, non-decreasing otherwise
+        template <class FwdIt, class Unique>
+        bool is_sorted_range(FwdIt first, FwdIt last, Unique unique, std::true_type) const {
+            if (first == last) return true;
+
+            for (FwdIt next = first; ++next != last; first = next) {
+                const key_type& prev_key = KeyofValue()(*first);
+                const key_type& next_key = KeyofValue()(*next);
+                if (unique ? !_key_compare(prev_key, next_key) : _key_compare(next_key, prev_key)) return false;
+            }
+
+            return true;
+        }
+
+        template <class InputIt, class Unique>
+        bool is_sorted_range(InputIt, InputIt, Unique, std::false_type) const {
+            return false;
+        }
+
+        // with the hint at end(), ascending input costs O(1) amortized per element
+        template <class InputIt>
+        void append_unique(InputIt first, InputIt last) {
+            for (; first != last; ++first) {
+                emplace_hint(cend(), *first);
             }
+        }
 
-            return iterator(lb);
+        template <class InputIt>
+        void append_equal(InputIt first, InputIt last) {
+            for (; first != last; ++first) {
+                emplace_hint_equal(cend(), *first);
+            }
         }
 
-        const_iterator lower_bound(const key_type& key) const {
+        // tree must be empty when called, [first, last) must be sorted
+        template <class FwdIt>
+        void build_sorted(FwdIt first, FwdIt last, std::true_type) {
+            size_type n = MyStl::distance(first, last);
+            if (n == 0) return;
+
+            // only the deepest level can be incomplete, its nodes are red and every other one is black
+            size_type red_depth = 0;
+            while ((size_type(2) << red_depth) <= n) ++red_depth;
+
+            reserve_batch(n);
+            try {
+                root() = build_from(first, n, 0, red_depth);
+            } catch (...) {
+                release_unused_batch();
+                throw;
+            }
+            root()->_parent = _header;
+            root()->_set_black();
+            min_node() = _Base_type::_min(root());
+            max_node() = _Base_type::_max(root());
+            _size = n;
+        }
+
+        // a single pass range can't be counted first, appending sorted values never misses the hint,
+        // and since the caller promised the order no value is rejected either
+        template <class InputIt>
+        void build_sorted(InputIt first, InputIt last, std::false_type) {
+            append_equal(first, last);
+        }
+
+        // Recursively builds a balanced subtree from the next n values of first, in order,
+        // the same way copy_from copies one. Returns its root, whose parent is left to the caller.
+        template <class FwdIt>
+        _Base_ptr build_from(FwdIt& first, size_type n, size_type depth, size_type red_depth) {
+            if (n == 0) return nullptr;
+
+            size_type left_count = (n - 1) / 2;
+            _Base_ptr left = build_from(first, left_count, depth + 1, red_depth);
+
+            _Base_ptr root;
+            try {
+                root = construct_node(*first);
+            } catch (...) {
+                if (left) erase_from(left);
+                throw;
+            }
+            ++first;
+
+            root->_color = depth == red_depth ? _RB_tree_color::_red : _RB_tree_color::_black;
+            root->_left = left;
+            if (left) left->_parent = root;
+
+            try {
+                root->_right = build_from(first, n - 1 - left_count, depth + 1, red_depth);
+            } catch (...) {
+                erase_from(root);
+                throw;
+            }
+            if (root->_right) root->_right->_parent = root;
+
+            return root;
+        }
+
+        template <class K>
+        _Base_ptr find_node(const K& key) const {
+            _Base_ptr lb = lower_bound_node(key);
+            return (lb == _header || _key_compare(key, get_key(lb))) ? _header : lb;
+        }
+
+        // first node whose key is not less than key, the header if there is none
+        template <class K>
+        _Base_ptr lower_bound_node(const K& key) const {
             _Base_ptr lb = _header;
             _Base_ptr cur = root();
 
-            while (lb) {
+            while (cur) {
                 if (_key_compare(get_key(cur), key)) {
                     // cur.key < key
                     cur = cur->_right;
@@ -534,14 +858,16 @@ namespace MyStl
                 }
             }
 
-            return const_iterator(lb);
+            return lb;
         }
 
-        iterator upper_bound(const key_type& key) {
+        // first node whose key is greater than key, the header if there is none
+        template <class K>
+        _Base_ptr upper_bound_node(const K& key) const {
             _Base_ptr ub = _header;
             _Base_ptr cur = root();
 
-            while (ub) {
+            while (cur) {
                 if (_key_compare(key, get_key(cur))) {
                     // cur.key > key
                     ub = cur;
@@ -552,35 +878,48 @@ namespace MyStl
                 }
             }
 
-            return iterator(ub);
+            return ub;
         }
 
-        const_iterator upper_bound(const key_type& key) const {
-            _Base_ptr ub = _header;
+        // parent of the insertion position behind all nodes with an equal key,
+        // insert_at_pos decides the side by comparing with the parent
+        _Base_ptr get_insert_equal_pos(const key_type& key) {
+            _Base_ptr p = _header;
             _Base_ptr cur = root();
 
-            while (ub) {
-                if (_key_compare(key, get_key(cur))) {
-                    // cur.key > key
-                    ub = cur;
-                    cur = cur->_left;
-                } else {
-                    // cur.key <= key
-                    cur = cur->_right;
-                }
+            while (cur) {
+                p = cur;
+                cur = _key_compare(key, get_key(cur)) ? cur->_left : cur->_right;
             }
 
-            return const_iterator(ub);
+            return p;
         }
 
-        /* Observers */
-        Compare key_comp() const {
-            return _key_compare;
-        }
+        // same convention as get_emplace_hint_unique_pos, the new node goes right before hint
+        // if that keeps the order, otherwise the hint is ignored
+        std::pair<_Base_ptr, _Base_ptr>
+        get_emplace_hint_equal_pos(_Base_ptr hint, const key_type& key) {
+            using Res = std::pair<_Base_ptr, _Base_ptr>;
 
+            if (hint != _header && _key_compare(get_key(hint), key))
+                return Res(nullptr, get_insert_equal_pos(key));
 
+            if (hint == min_node()) {
+                // also covers the empty tree, where the header is the minimum
+                return hint == _header ? Res(nullptr, _header) : Res(hint, hint);
+            }
+
+            iterator before(hint);
+            --before;
+            if (_key_compare(key, get_key(before._node_base)))
+                return Res(nullptr, get_insert_equal_pos(key));
+
+            // before <= key <= hint, one of the two has a free slot next to the other
+            if (!before._node_base->_right)
+                return Res(nullptr, before._node_base);
+            return Res(hint, hint);
+        }
 
-    private:
         // p is the parent of insertion position
         // left_indicator ==> insert left, but !left_indicator =\=> insert right
         iterator insert_at_pos(_Base_ptr p, _Base_ptr n, bool left_indicator) {
@@ -592,7 +931,7 @@ namespace MyStl
                 max_node() = n;
             }
 
-            bool insert_left = left_indicator || _key_compare(get_key(n), get_key(p));
+            bool insert_left = p == _header || left_indicator || _key_compare(get_key(n), get_key(p));
 
             if (insert_left) {
                 p->_left = n;
@@ -670,7 +1009,7 @@ namespace MyStl
                 iterator after = hint;
                 if (hint._node_base == max_node())
                     return Res(nullptr, max_node());
-                else if (_key_compare(key, get_key(key, (++after)._node_base))) {
+                else if (_key_compare(key, get_key((++after)._node_base))) {
                     // hint < key < after
                     if (!after._node_base->_left)
                         return Res(after._node_base, after._node_base);
@@ -681,7 +1020,7 @@ namespace MyStl
                 }
             } else {
                 // key == hint
-                return (hint._node_base, nullptr);
+                return Res(hint._node_base, nullptr);
             }
         }
 
@@ -764,11 +1103,13 @@ namespace MyStl
                     to_delete->_parent->_right = replacement;
                 }
 
+                // to_delete has no left child if it's the minimum, so the new minimum
+                // is either in the right subtree or the parent (header if tree becomes empty)
                 if (min_node() == to_delete) {
-                    min_node() = replacement;
+                    min_node() = replacement ? _Base_type::_min(replacement) : to_delete->_parent;
                 }
                 if (max_node() == to_delete) {
-                    max_node() == replacement;
+                    max_node() = replacement ? _Base_type::_max(replacement) : to_delete->_parent;
                 }
             } else {
                 // n has 2 children, replacement is the right child of to_delete (or nullptr)
@@ -782,7 +1123,8 @@ namespace MyStl
 
                     if (replacement) replacement->_parent = to_delete->_parent;
 
-                    to_delete->_parent->_right = replacement;
+                    // the successor is the leftmost node of n's right subtree
+                    to_delete->_parent->_left = replacement;
                     to_delete->_right = n->_right;
                     n->_right->_parent = to_delete;
                 } else {
@@ -813,7 +1155,7 @@ namespace MyStl
                     else
                         sibling = replacement_parent->_left;
                     
-                    if (sibling->_is_red) {
+                    if (sibling->_is_red()) {
                         // implies that both replacement_parent and sibling's children are black
                         sibling->_set_black();
                         replacement_parent->_set_red();
@@ -917,69 +1259,165 @@ namespace MyStl
 
         template<class...Args>
         _Node_ptr construct_node(Args&& ...args) {
-            _Node_ptr ptr = _get_al().allocate(1);
+            _Node_ptr ptr = allocate_node();
             try{
-                _get_al().construct(ptr->_val_ptr(), std::forward<Args>(args)...);
+                _Node_traits::construct(_al, ptr->_val_ptr(), std::forward<Args>(args)...);
                 ptr->_parent = ptr->_left = ptr->_right = 0;
             } catch (...) {
-                _get_al().deallocate(ptr);
+                deallocate_node(ptr);
                 throw;
             }
 
             return ptr;
         }
 
-        void delete_node(_Node_ptr n) {
-            _get_al().destroy(n->_val_ptr());
-            _get_al().deallocate(n);
+        void delete_node(_Base_ptr n) {
+            _Node_ptr node = get_node(n);
+            _Node_traits::destroy(_al, node->_val_ptr());
+            deallocate_node(node);
         }
 
-        // Recursively create a copy of the subtree with rhs as root and 
-        // return the root of the copied tree, where p is the copied root's 
-        // parent. Caller must ensure rhs != nullptr when calling.
-        _Base_ptr copy_from(_Base_ptr rhs, _Base_ptr p) {
-            _Base_ptr root = construct_node(get_node(rhs)->_val);
-            
-            try{
-                root->_parent = p;
+        _Node_ptr allocate_node() {
+            if (_batch._free) {
+                _Node_ptr ptr = get_node(_batch._free);
+                _batch._free = _batch._free->_left;
+                ++_batch._live;
+                return ptr;
+            }
 
-                if (rhs->_left) {
-                    root->_left = copy_from(rhs->_left, root);
-                }
+            if (_batch._used != _batch._capacity) {
+                ++_batch._live;
+                return _batch._nodes + _batch._used++;
+            }
 
-                if (rhs->_right) {
-                    root->_right = copy_from(rhs->_right, root);
-                }
+            return _Node_traits::allocate(_al, 1);
+        }
+
+        void deallocate_node(_Node_ptr ptr) noexcept {
+            if (!in_batch(ptr)) {
+                _Node_traits::deallocate(_al, ptr, 1);
+                return;
+            }
+
+            ptr->_left = _batch._free;
+            _batch._free = ptr;
+            if (--_batch._live == 0) release_batch();
+        }
 
-                return root;
+        bool in_batch(_Node_ptr ptr) const noexcept {
+            std::less<_Node_ptr> less;
+            return _batch._nodes && !less(ptr, _batch._nodes) && less(ptr, _batch._nodes + _batch._capacity);
+        }
+
+        // the next count nodes come out of one allocation, only called on an empty tree
+        void reserve_batch(size_type count) {
+            assert(_size == 0 && !_batch._nodes);
+            if (count < 2) return;
+
+            _batch._nodes = _Node_traits::allocate(_al, count);
+            _batch._capacity = count;
+        }
+
+        void release_batch() noexcept {
+            _Node_traits::deallocate(_al, _batch._nodes, _batch._capacity);
+            _batch = _Node_batch();
+        }
+
+        // a batch whose nodes were never handed out, e.g. because a copy threw early
+        void release_unused_batch() noexcept {
+            if (_batch._nodes && _batch._live == 0) release_batch();
+        }
+
+        _Node_ptr clone_node(_Base_ptr n, std::false_type) {
+            return construct_node(get_node(n)->_val);
+        }
+
+        _Node_ptr clone_node(_Base_ptr n, std::true_type) {
+            return construct_node(std::move(get_node(n)->_val));
+        }
+
+        // Create a copy of the subtree with rhs as root and return the root of 
+        // the copied tree, where p is the copied root's parent. Caller must 
+        // ensure rhs != nullptr when calling. Values are moved out of rhs if 
+        // Move is std::true_type. The source is walked through the parent 
+        // pointers, a node's children are copied once it's reached from above.
+        template <class Move>
+        _Base_ptr copy_from(_Base_ptr rhs, _Base_ptr p, Move move) {
+            _Base_ptr root = clone_node(rhs, move);
+            root->_color = rhs->_color;
+            root->_parent = p;
+
+            try{
+                _Base_ptr src = rhs;
+                _Base_ptr dst = root;
+                while (true) {
+                    if (src->_left && !dst->_left) {
+                        src = src->_left;
+                        dst = attach_clone(dst, dst->_left, src, move);
+                    } else if (src->_right && !dst->_right) {
+                        src = src->_right;
+                        dst = attach_clone(dst, dst->_right, src, move);
+                    } else if (src != rhs) {
+                        src = src->_parent;
+                        dst = dst->_parent;
+                    } else {
+                        return root;
+                    }
+                }
             } catch (...) {
                 erase_from(root);
                 throw;
             }
-            
         }
 
-        // recursively destroy the subtree rooted at n
-        void erase_from(_Base_ptr n) {
-            if (n->_left) erase_from(n->_left);
-            if (n->_right) erase_from(n->_right);
+        template <class Move>
+        _Base_ptr attach_clone(_Base_ptr parent, _Base_ptr& child, _Base_ptr src, Move move) {
+            child = clone_node(src, move);
+            child->_color = src->_color;
+            child->_parent = parent;
+            return child;
+        }
 
-            delete_node(n);
+        // destroy the subtree rooted at n, left children are rotated up
+        // until there is none, so no stack is needed
+        void erase_from(_Base_ptr n) {
+            while (n) {
+                if (n->_left) {
+                    _Base_ptr l = n->_left;
+                    n->_left = l->_right;
+                    l->_right = n;
+                    n = l;
+                } else {
+                    _Base_ptr r = n->_right;
+                    delete_node(n);
+                    n = r;
+                }
+            }
         }
 
         void reset() {
-            erase_from(root());
+            if (root()) erase_from(root());
 
             default_init();
         }
 
-        void copy_tree(const _RB_tree& rhs) {
-            root() = copy_from(rhs.root(), _header);
+        // tree must be empty when called
+        template <class Move = std::false_type>
+        void copy_tree(const _RB_tree& rhs, Move move = Move()) {
+            _key_compare = rhs._key_compare;
+            if (!rhs.root()) return;
+
+            reserve_batch(rhs._size);
+            try {
+                root() = copy_from(rhs.root(), _header, move);
+            } catch (...) {
+                release_unused_batch();
+                throw;
+            }
             max_node() = _Base_type::_max(root());
             min_node() = _Base_type::_min(root());
 
             _size = rhs._size;
-            _key_compare = rhs._key_compare;
         }
 
         void default_init() {
@@ -990,8 +1428,46 @@ namespace MyStl
 
             _header->_color = _RB_tree_color::_red;
             _size = 0;
-            _key_compare = Compare();
-        }        
+        }
+
+        // the header is a node whose value is never constructed
+        void create_header() {
+            _header = _Node_traits::allocate(_al, 1);
+            default_init();
+        }
+
+        void destroy_header() {
+            if (_header) {
+                reset();
+                _Node_traits::deallocate(_al, get_node(_header), 1);
+                _header = nullptr;
+            }
+        }
+
+        // take over the nodes of rhs, which must be releasable by this allocator
+        void steal(_RB_tree& rhs) noexcept {
+            std::swap(_header, rhs._header);
+            std::swap(_size, rhs._size);
+            std::swap(_batch, rhs._batch);
+            _key_compare = rhs._key_compare;
+        }
+
+        void move_assign(_RB_tree& rhs, std::true_type) {
+            destroy_header();
+            _al = std::move(rhs._al);
+            create_header();
+            steal(rhs);
+        }
+
+        void move_assign(_RB_tree& rhs, std::false_type) {
+            reset();
+            if (_al == rhs._al) {
+                steal(rhs);
+            } else {
+                copy_tree(rhs, std::true_type());
+                rhs.reset();
+            }
+        }
 
         static _Node_ptr get_node(_Base_ptr n) {
             return static_cast<_Node_ptr>(n);
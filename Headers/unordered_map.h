@@ -0,0 +1,228 @@
+#ifndef MYSTL_UNORDERED_MAP_H
+#define MYSTL_UNORDERED_MAP_H
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include "hashtable.h"
+
+namespace MyStl {
+template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+          class Alloc = std::allocator<std::pair<const Key, T>>>
+class unordered_map {
+public:
+    typedef Key                 key_type;
+    typedef T                   mapped_type;
+    typedef std::pair<const Key, T> value_type;
+    typedef Hash                hasher;
+    typedef KeyEqual            key_equal;
+    typedef Alloc                                                         allocator_type;
+    typedef typename std::allocator_traits<allocator_type>::pointer       pointer;
+    typedef typename std::allocator_traits<allocator_type>::const_pointer const_pointer;
+
+private:
+    typedef MyStl::_Hashtable<key_type, value_type,
+        std::_Select1st<value_type>, hasher, key_equal, allocator_type> _Rep_type;
+
+public:
+    typedef typename _Rep_type::size_type               size_type;
+    typedef typename _Rep_type::difference_type         difference_type;
+    typedef typename _Rep_type::reference               reference;
+    typedef typename _Rep_type::const_reference         const_reference;
+    typedef typename _Rep_type::iterator                iterator;
+    typedef typename _Rep_type::const_iterator          const_iterator;
+
+private:
+    _Rep_type _table;
+
+public:
+    /* constructors and destructors */
+    unordered_map() = default;
+
+    explicit unordered_map(size_type bucket_count, const Hash& hash = Hash(),
+                           const KeyEqual& equal = KeyEqual(), const Alloc& al = Alloc())
+        : _table(bucket_count, hash, equal, al) {}
+
+    explicit unordered_map(const Alloc& al) : _table(al) {}
+
+    template <class InputIt>
+    unordered_map(InputIt first, InputIt last, size_type bucket_count = 0, const Hash& hash = Hash(),
+                  const KeyEqual& equal = KeyEqual(), const Alloc& al = Alloc())
+        : _table(bucket_count, hash, equal, al) {
+        _table.insert_unique(first, last);
+    }
+
+    unordered_map(const unordered_map& other) = default;
+
+    unordered_map(const unordered_map& other, const Alloc& al) : _table(other._table, al) {}
+
+    unordered_map(unordered_map&& other) = default;
+
+    unordered_map(unordered_map&& other, const Alloc& al) : _table(std::move(other._table), al) {}
+
+    unordered_map(std::initializer_list<value_type> ilist, size_type bucket_count = 0,
+                  const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(), const Alloc& al = Alloc())
+        : _table(bucket_count, hash, equal, al) {
+        _table.insert_unique(ilist);
+    }
+
+    unordered_map& operator=(const unordered_map& other) = default;
+
+    unordered_map& operator=(unordered_map&& other) = default;
+
+    unordered_map& operator=(std::initializer_list<value_type> ilist) {
+        _table.clear();
+        _table.insert_unique(ilist);
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept {return _table.get_allocator();}
+
+    /* iterators */
+    iterator begin() noexcept {return _table.begin();}
+
+    const_iterator begin() const noexcept {return _table.begin();}
+
+    const_iterator cbegin() const noexcept {return _table.cbegin();}
+
+    iterator end() noexcept {return _table.end();}
+
+    const_iterator end() const noexcept {return _table.end();}
+
+    const_iterator cend() const noexcept {return _table.cend();}
+
+    /* capacity */
+    bool empty() const noexcept {return _table.empty();}
+
+    size_type size() const noexcept {return _table.size();}
+
+    size_type max_size() const noexcept {return _table.max_size();}
+
+    /* element access */
+    mapped_type& at(const key_type& key) {
+        auto i = _table.find(key);
+        if (i == _table.end()) throw std::out_of_range("key not found in unordered_map");
+
+        return i->second;
+    }
+
+    const mapped_type& at(const key_type& key) const {
+        auto i = _table.find(key);
+        if (i == _table.end()) throw std::out_of_range("key not found in unordered_map");
+
+        return i->second;
+    }
+
+    mapped_type& operator[](const key_type& key) {return try_emplace(key).first->second;}
+
+    mapped_type& operator[](key_type&& key) {return try_emplace(std::move(key)).first->second;}
+
+    /* modifiers */
+    void clear() noexcept {_table.clear();}
+
+    std::pair<iterator, bool> insert(const value_type& value) {return _table.insert_unique(value);}
+
+    std::pair<iterator, bool> insert(value_type&& value) {return _table.insert_unique(std::move(value));}
+
+    template <class P,
+              typename std::enable_if<std::is_constructible<value_type, P&&>::value, int>::type = 0>
+    std::pair<iterator, bool> insert(P&& value) {return _table.insert_unique(std::forward<P>(value));}
+
+    template <class InputIt>
+    void insert(InputIt first, InputIt last) {_table.insert_unique(first, last);}
+
+    void insert(std::initializer_list<value_type> ilist) {_table.insert_unique(ilist);}
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+        auto res = try_emplace(key, std::forward<M>(obj));
+        if (!res.second) res.first->second = std::forward<M>(obj);
+        return res;
+    }
+
+    template <class M>
+    std::pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj) {
+        auto res = try_emplace(std::move(key), std::forward<M>(obj));
+        if (!res.second) res.first->second = std::forward<M>(obj);
+        return res;
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {return _table.emplace_unique(std::forward<Args>(args)...);}
+
+    // the mapped value is only constructed if key is not present, no temporary pair is built
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+        return _table.emplace_key_unique(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                         std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        return _table.emplace_key_unique(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                                         std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+
+    iterator erase(const_iterator pos) {return _table.erase(pos);}
+
+    iterator erase(iterator pos) {return _table.erase(const_iterator(pos));}
+
+    iterator erase(const_iterator first, const_iterator last) {return _table.erase(first, last);}
+
+    size_type erase(const key_type& key) {return _table.erase(key);}
+
+    void swap(unordered_map& other) {_table.swap(other._table);}
+
+    /* lookup */
+    size_type count(const key_type& key) const {return _table.count_unique(key);}
+
+    iterator find(const key_type& key) {return _table.find(key);}
+
+    const_iterator find(const key_type& key) const {return _table.find(key);}
+
+    bool contains(const key_type& key) const {return _table.count_unique(key) != 0;}
+
+    std::pair<iterator, iterator> equal_range(const key_type& key) {return _table.equal_range_unique(key);}
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& key) const {
+        return _table.equal_range_unique(key);
+    }
+
+    /* hash policy */
+    size_type bucket_count() const noexcept {return _table.bucket_count();}
+
+    float load_factor() const noexcept {return _table.load_factor();}
+
+    float max_load_factor() const noexcept {return _table.max_load_factor();}
+
+    void rehash(size_type count) {_table.rehash(count);}
+
+    void reserve(size_type count) {_table.reserve(count);}
+
+    /* observers */
+    hasher hash_function() const {return _table.hash_function();}
+
+    key_equal key_eq() const {return _table.key_eq();}
+};
+
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+bool operator==(const unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs) {
+    if (lhs.size() != rhs.size()) return false;
+
+    for (const auto& kv : lhs) {
+        auto i = rhs.find(kv.first);
+        if (i == rhs.end() || !(i->second == kv.second)) return false;
+    }
+    return true;
+}
+
+template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+bool operator!=(const unordered_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_map<Key, T, Hash, KeyEqual, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+} // namespace MyStl
+
+#endif
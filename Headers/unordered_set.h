@@ -0,0 +1,163 @@
+#ifndef MYSTL_UNORDERED_SET_H
+#define MYSTL_UNORDERED_SET_H
+
+#include <functional>
+#include <memory>
+#include "hashtable.h"
+
+namespace MyStl {
+template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
+          class Alloc = std::allocator<Key>>
+class unordered_set {
+public:
+    typedef Key                 key_type;
+    typedef Key                 value_type;
+    typedef Hash                hasher;
+    typedef KeyEqual            key_equal;
+    typedef Alloc                                                         allocator_type;
+    typedef typename std::allocator_traits<allocator_type>::pointer       pointer;
+    typedef typename std::allocator_traits<allocator_type>::const_pointer const_pointer;
+
+private:
+    typedef MyStl::_Hashtable<key_type, value_type,
+        std::_Identity<value_type>, hasher, key_equal, allocator_type> _Rep_type;
+
+public:
+    typedef typename _Rep_type::size_type               size_type;
+    typedef typename _Rep_type::difference_type         difference_type;
+    typedef typename _Rep_type::reference               reference;
+    typedef typename _Rep_type::const_reference         const_reference;
+    // elements must not be modified in place, their position depends on them
+    typedef typename _Rep_type::const_iterator          iterator;
+    typedef typename _Rep_type::const_iterator          const_iterator;
+
+private:
+    _Rep_type _table;
+
+public:
+    /* constructors and destructors */
+    unordered_set() = default;
+
+    explicit unordered_set(size_type bucket_count, const Hash& hash = Hash(),
+                           const KeyEqual& equal = KeyEqual(), const Alloc& al = Alloc())
+        : _table(bucket_count, hash, equal, al) {}
+
+    explicit unordered_set(const Alloc& al) : _table(al) {}
+
+    template <class InputIt>
+    unordered_set(InputIt first, InputIt last, size_type bucket_count = 0, const Hash& hash = Hash(),
+                  const KeyEqual& equal = KeyEqual(), const Alloc& al = Alloc())
+        : _table(bucket_count, hash, equal, al) {
+        _table.insert_unique(first, last);
+    }
+
+    unordered_set(const unordered_set& other) = default;
+
+    unordered_set(const unordered_set& other, const Alloc& al) : _table(other._table, al) {}
+
+    unordered_set(unordered_set&& other) = default;
+
+    unordered_set(unordered_set&& other, const Alloc& al) : _table(std::move(other._table), al) {}
+
+    unordered_set(std::initializer_list<value_type> ilist, size_type bucket_count = 0,
+                  const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual(), const Alloc& al = Alloc())
+        : _table(bucket_count, hash, equal, al) {
+        _table.insert_unique(ilist);
+    }
+
+    unordered_set& operator=(const unordered_set& other) = default;
+
+    unordered_set& operator=(unordered_set&& other) = default;
+
+    unordered_set& operator=(std::initializer_list<value_type> ilist) {
+        _table.clear();
+        _table.insert_unique(ilist);
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept {return _table.get_allocator();}
+
+    /* iterators */
+    iterator begin() const noexcept {return _table.begin();}
+
+    const_iterator cbegin() const noexcept {return _table.cbegin();}
+
+    iterator end() const noexcept {return _table.end();}
+
+    const_iterator cend() const noexcept {return _table.cend();}
+
+    /* capacity */
+    bool empty() const noexcept {return _table.empty();}
+
+    size_type size() const noexcept {return _table.size();}
+
+    size_type max_size() const noexcept {return _table.max_size();}
+
+    /* modifiers */
+    void clear() noexcept {_table.clear();}
+
+    std::pair<iterator, bool> insert(const value_type& value) {return _table.insert_unique(value);}
+
+    std::pair<iterator, bool> insert(value_type&& value) {return _table.insert_unique(std::move(value));}
+
+    template <class InputIt>
+    void insert(InputIt first, InputIt last) {_table.insert_unique(first, last);}
+
+    void insert(std::initializer_list<value_type> ilist) {_table.insert_unique(ilist);}
+
+    template <class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args) {return _table.emplace_unique(std::forward<Args>(args)...);}
+
+    iterator erase(const_iterator pos) {return _table.erase(pos);}
+
+    iterator erase(const_iterator first, const_iterator last) {return _table.erase(first, last);}
+
+    size_type erase(const key_type& key) {return _table.erase(key);}
+
+    void swap(unordered_set& other) {_table.swap(other._table);}
+
+    /* lookup */
+    size_type count(const key_type& key) const {return _table.count_unique(key);}
+
+    iterator find(const key_type& key) const {return _table.find(key);}
+
+    bool contains(const key_type& key) const {return _table.count_unique(key) != 0;}
+
+    std::pair<iterator, iterator> equal_range(const key_type& key) const {return _table.equal_range_unique(key);}
+
+    /* hash policy */
+    size_type bucket_count() const noexcept {return _table.bucket_count();}
+
+    float load_factor() const noexcept {return _table.load_factor();}
+
+    float max_load_factor() const noexcept {return _table.max_load_factor();}
+
+    void rehash(size_type count) {_table.rehash(count);}
+
+    void reserve(size_type count) {_table.reserve(count);}
+
+    /* observers */
+    hasher hash_function() const {return _table.hash_function();}
+
+    key_equal key_eq() const {return _table.key_eq();}
+};
+
+template <class Key, class Hash, class KeyEqual, class Alloc>
+bool operator==(const unordered_set<Key, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_set<Key, Hash, KeyEqual, Alloc>& rhs) {
+    if (lhs.size() != rhs.size()) return false;
+
+    for (const auto& key : lhs) {
+        if (!rhs.contains(key)) return false;
+    }
+    return true;
+}
+
+template <class Key, class Hash, class KeyEqual, class Alloc>
+bool operator!=(const unordered_set<Key, Hash, KeyEqual, Alloc>& lhs,
+                const unordered_set<Key, Hash, KeyEqual, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+} // namespace MyStl
+
+#endif
@@ -0,0 +1,70 @@
+#include <string>
+
+#include "common_test_funcs.h"
+#include "../Headers/Vector.h"
+#include "../Headers/Deque.h"
+#include "../Headers/List.h"
+#include "../Headers/UnrolledList.h"
+
+// stateful allocator that keeps track of how many bytes each arena handed out
+template <typename T>
+struct Counting_Allocator{
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    long* bytes;
+
+    explicit Counting_Allocator(long* counter): bytes(counter){}
+
+    template <typename U>
+    Counting_Allocator(const Counting_Allocator<U>& other): bytes(other.bytes){}
+
+    T* allocate(std::size_t n){
+        *bytes += n * sizeof(T);
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n){
+        *bytes -= n * sizeof(T);
+        ::operator delete(p);
+    }
+
+    template <typename U>
+    bool operator==(const Counting_Allocator<U>& other) const {return bytes == other.bytes;}
+
+    template <typename U>
+    bool operator!=(const Counting_Allocator<U>& other) const {return bytes != other.bytes;}
+};
+
+int main(){
+    long arena_1 = 0, arena_2 = 0;
+    {
+        Counting_Allocator<std::string> al_1(&arena_1), al_2(&arena_2);
+
+        MyStl::Vector<std::string, Counting_Allocator<std::string>> v_1({"hello", "world"}, al_1);
+        MyStl::Vector<std::string, Counting_Allocator<std::string>> v_2(al_2);
+        v_2 = v_1;      //allocator propagates on copy assignment
+        MyStl::Tests::print(v_2, "vector_2");
+        std::cout << "arena_1: " << arena_1 << " arena_2: " << arena_2 << std::endl;
+
+        MyStl::List<std::string, Counting_Allocator<std::string>> l_1({"I", "am", "Fred"}, al_2);
+        MyStl::List<std::string, Counting_Allocator<std::string>> l_2(std::move(l_1), al_1);
+        MyStl::Tests::print(l_2, "list_2");
+
+        MyStl::Deque<std::string, Counting_Allocator<std::string>> d_1(3, "deque", al_2);
+        MyStl::Tests::print(d_1, "deque_1");
+        std::cout << "arena_1: " << arena_1 << " arena_2: " << arena_2 << std::endl;
+
+        MyStl::UnrolledList<std::string, Counting_Allocator<std::string>> u_1({"chunked", "list"}, al_1);
+        MyStl::UnrolledList<std::string, Counting_Allocator<std::string>> u_2(al_2);
+        u_2.swap(u_1);  //allocators propagate on swap
+        u_1 = u_2;
+        MyStl::Tests::print(u_1, "unrolled_1");
+        std::cout << "arena_1: " << arena_1 << " arena_2: " << arena_2 << std::endl;
+    }
+    std::cout << "arena_1: " << arena_1 << " arena_2: " << arena_2 << std::endl;
+
+    return 0;
+}
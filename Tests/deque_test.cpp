@@ -62,6 +62,16 @@ int main(){
         d_8.push_front(j);
     }
     MyStl::Tests::print(d_8, "deque_8");
+
+    //used as a queue the deque drifts through its map, which is recentered instead of growing
+    MyStl::Deque<int, std::allocator<int>, 64> d_9;
+    for (int i = 0; i < 100000; ++i){
+        d_9.push_back(i);
+        if (d_9.size() > 20) d_9.pop_front();
+    }
+    MyStl::Tests::print(d_9, "deque_9");
+    std::cout << "map size: " << d_9.map_size() << ", recenters: " << d_9.map_stats().recenters
+              << ", reallocations: " << d_9.map_stats().reallocations << std::endl;
     
     return 0;
 }
\ No newline at end of file
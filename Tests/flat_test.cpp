@@ -0,0 +1,69 @@
+#include <string>
+#include <string_view>
+
+#include "common_test_funcs.h"
+#include "../Headers/set.h"
+#include "../Headers/flat_set.h"
+#include "../Headers/flat_map.h"
+#include "../Headers/SmallVector.h"
+
+template<typename Map> void
+print_map(const Map& m, std::string name){
+    cout << name << ": ";
+    for (const auto& kv : m) cout << kv.first << "=" << kv.second << " ";
+    cout << endl;
+}
+
+int main(){
+    MyStl::flat_set<int> fs_1{5, 3, 9, 3, 1};
+    MyStl::Tests::print(fs_1, "fs_1");
+
+    fs_1.insert(4);
+    fs_1.erase(9);
+    fs_1.insert(fs_1.end(), 12);
+    MyStl::Tests::print(fs_1, "fs_1");
+    cout << "fs_1 contains 4: " << fs_1.contains(4) << ", lower_bound(2): " << *fs_1.lower_bound(2)
+         << ", upper_bound(4): " << *fs_1.upper_bound(4) << ", count(7): " << fs_1.count(7) << endl;
+
+    //the new keys are sorted on their own and merged with the old ones, duplicates are dropped
+    int more[] = {10, 2, 4, 7, 2, 0, 12};
+    fs_1.insert(more, more + 7);
+    MyStl::Tests::print(fs_1, "fs_1");
+
+    //same keys in the same order as set
+    MyStl::set<int> s_1(fs_1.begin(), fs_1.end());
+    cout << "fs_1 matches s_1: " << MyStl::equal(fs_1.begin(), fs_1.end(), s_1.begin()) << endl;
+
+    //string keys are searched with the ordinary binary search
+    MyStl::flat_set<std::string, std::less<>> fs_2{"pear", "apple", "fig", "kiwi"};
+    MyStl::Tests::print(fs_2, "fs_2");
+    cout << "fs_2 find(string_view): " << *fs_2.find(std::string_view("kiwi"))
+         << ", contains(\"plum\"): " << fs_2.contains(std::string_view("plum")) << endl;
+
+    //the storage can be any container with pointer iterators
+    int sorted[] = {1, 2, 4, 8, 16};
+    MyStl::flat_set<int, std::less<int>, MyStl::SmallVector<int, 8>> fs_3(MyStl::sorted_unique, sorted, sorted + 5);
+    MyStl::Tests::print(fs_3, "fs_3");
+    cout << "fs_3 capacity: " << fs_3.capacity() << endl;
+
+    MyStl::flat_map<std::string, int> fm_1{{"one", 1}, {"two", 2}, {"three", 3}};
+    fm_1["four"] = 4;
+    fm_1.try_emplace("one", 100);
+    fm_1.insert_or_assign("two", 22);
+    print_map(fm_1, "fm_1");
+    cout << "fm_1 at(three): " << fm_1.at("three") << ", count(five): " << fm_1.count("five") << endl;
+
+    fm_1.erase(fm_1.find("one"));
+    auto range = fm_1.equal_range("three");
+    cout << "fm_1 size: " << fm_1.size() << ", equal_range(three): " << range.first->second
+         << ", " << (range.second - range.first) << endl;
+
+    MyStl::flat_map<std::string, int> fm_2(fm_1);
+    fm_2["zero"] = 0;
+    cout << "fm_1 == fm_2: " << (fm_1 == fm_2) << ", fm_1 < fm_2: " << (fm_1 < fm_2) << endl;
+
+    for (auto it = fm_2.rbegin(); it != fm_2.rend(); ++it) cout << it->first << " ";
+    cout << endl;
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <string>
+
+#include "common_test_funcs.h"
+#include "../Headers/IntrusiveList.h"
+
+struct Job{
+    int id;
+    std::string name;
+    MyStl::Node_Base<Job> hook{};         //null links, unlinked
+    MyStl::Node_Base<Job> done_hook{};    //a second hook, for a second list
+};
+
+std::ostream& operator<<(std::ostream& os, const Job& job){
+    return os << job.name << "(" << job.id << ")";
+}
+
+bool operator<(const Job& lhs, const Job& rhs){return lhs.id < rhs.id;}
+
+bool operator==(const Job& lhs, const Job& rhs){return lhs.id == rhs.id;}
+
+bool operator!=(const Job& lhs, const Job& rhs){return lhs.id != rhs.id;}
+
+int main(){
+    //the objects live in an array, the lists only link them
+    Job jobs[] = {{5, "build"}, {2, "test"}, {8, "deploy"}, {1, "fetch"}, {7, "lint"}, {3, "pack"}};
+
+    MyStl::IntrusiveList<Job, &Job::hook> l_1(jobs, jobs + 6);
+    MyStl::Tests::print(l_1, "list_1");
+
+    l_1.sort();
+    MyStl::Tests::print(l_1, "list_1 sorted");
+
+    //taken out by the object alone
+    l_1.unlink(jobs[2]);
+    l_1.unlink(jobs[3]);
+    MyStl::Tests::print(l_1, "list_1");
+
+    MyStl::IntrusiveList<Job, &Job::hook> l_2;
+    l_2.push_back(jobs[3]);
+    l_2.push_back(jobs[2]);
+    l_1.merge(std::move(l_2));
+    MyStl::Tests::print(l_1, "list_1 merged");
+    MyStl::Tests::print(l_2, "list_2");
+
+    //the same objects in a second list through the other hook
+    MyStl::IntrusiveList<Job, &Job::done_hook> done;
+    done.push_front(jobs[0]);
+    done.push_front(jobs[4]);
+    MyStl::Tests::print(done, "done");
+
+    l_2.splice(l_2.end(), std::move(l_1), l_1.iterator_to(jobs[5]), l_1.end());
+    MyStl::Tests::print(l_1, "list_1");
+    MyStl::Tests::print(l_2, "list_2 spliced");
+
+    l_2.remove_if([](const Job& job) -> bool{return job.id % 2 == 0;});
+    l_2.reverse();
+    MyStl::Tests::print(l_2, "list_2");
+
+    MyStl::IntrusiveList<Job, &Job::hook> l_3(std::move(l_2));
+    cout << l_3.size() << " " << l_3.front() << " " << l_3.back() << " " << l_2.empty() << endl;
+
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <string>
+#include <string_view>
+
+#include "common_test_funcs.h"
+#include "../Headers/set.h"
+#include "../Headers/map.h"
+
+template<typename Map> void
+print_map(const Map& m, std::string name){
+    cout << name << ": ";
+    for (const auto& kv : m) cout << kv.first << "=" << kv.second << " ";
+    cout << endl;
+}
+
+int main(){
+    MyStl::set<int> s_1{5, 3, 9, 3, 1};
+    MyStl::multiset<int> ms_1{5, 3, 9, 3, 1, 3};
+    MyStl::Tests::print(s_1, "s_1");
+    MyStl::Tests::print(ms_1, "ms_1");
+
+    s_1.insert(4);
+    s_1.erase(9);
+    ms_1.erase(3);
+    MyStl::Tests::print(s_1, "s_1");
+    MyStl::Tests::print(ms_1, "ms_1");
+    cout << "s_1 contains 4: " << s_1.contains(4) << ", lower_bound(2): " << *s_1.lower_bound(2) << endl;
+
+    MyStl::map<std::string, int> m_1{{"one", 1}, {"two", 2}, {"three", 3}};
+    m_1["four"] = 4;
+    m_1.try_emplace("one", 100);
+    m_1.insert_or_assign("two", 22);
+    print_map(m_1, "m_1");
+    cout << "m_1 at(three): " << m_1.at("three") << ", count(five): " << m_1.count("five") << endl;
+
+    //equal keys keep their insertion order
+    MyStl::multimap<int, std::string> mm_1;
+    mm_1.insert({2, "b"});
+    mm_1.insert({1, "a"});
+    mm_1.insert({2, "bb"});
+    mm_1.emplace(2, "bbb");
+    print_map(mm_1, "mm_1");
+    auto range = mm_1.equal_range(2);
+    cout << "mm_1 count(2): " << mm_1.count(2) << ", first of 2: " << range.first->second << endl;
+
+    //a transparent comparator lets string_view look up string keys without building a temporary
+    MyStl::map<std::string, int, std::less<>> m_2{{"hello", 1}, {"world", 2}};
+    std::string_view key("world");
+    cout << "m_2 find(string_view): " << m_2.find(key)->second
+         << ", contains(\"planet\"): " << m_2.contains(std::string_view("planet")) << endl;
+
+    //sorted input is built directly instead of being inserted one by one
+    int sorted[] = {1, 2, 4, 8, 16};
+    MyStl::set<int> s_2(MyStl::sorted_unique, sorted, sorted + 5);
+    MyStl::multiset<int> ms_2(sorted, sorted + 5);
+    MyStl::Tests::print(s_2, "s_2");
+    cout << "s_2 == ms_2 content: " << MyStl::equal(s_2.begin(), s_2.end(), ms_2.begin()) << endl;
+
+    for (auto it = m_1.rbegin(); it != m_1.rend(); ++it) cout << it->first << " ";
+    cout << endl;
+
+    return 0;
+}
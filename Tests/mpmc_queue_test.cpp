@@ -0,0 +1,66 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common_test_funcs.h"
+#include "../Headers/MpmcQueue.h"
+
+int main(){
+    MyStl::MpmcQueue<std::string> q_1;
+    cout << "slots per block: " << q_1.block_size << endl;
+
+    q_1.push("hello");
+    q_1.emplace(3, '!');
+    std::string s;
+    q_1.try_pop(s);
+    cout << s << " ";
+    q_1.try_pop(s);
+    cout << s << " " << q_1.try_pop(s) << endl;
+
+    //elements left in the queue are destroyed with it
+    MyStl::MpmcQueue<std::string, std::allocator<std::string>, 64> q_2;
+    for (int i = 0; i < 100; ++i) q_2.push(std::to_string(i));
+    for (int i = 0; i < 50; ++i) q_2.try_pop(s);
+    cout << "50th popped: " << s << endl;
+
+    //stress: every value comes out exactly once, and the values of one producer reach each consumer in order
+    constexpr int producers = 4, consumers = 4, per_producer = 100000;
+    MyStl::MpmcQueue<int, std::allocator<int>, 256> q_3;
+    std::vector<std::atomic<int>> seen(producers * per_producer);
+    std::atomic<int> popped{0};
+    std::atomic<bool> in_order{true};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p){
+        threads.emplace_back([&, p](){
+            for (int i = 0; i < per_producer; ++i) q_3.push(p * per_producer + i);
+        });
+    }
+    for (int c = 0; c < consumers; ++c){
+        threads.emplace_back([&](){
+            std::vector<int> last(producers, -1);
+            int value;
+            while (popped.load() < producers * per_producer){
+                if (!q_3.try_pop(value)){
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                ++popped;
+                ++seen[value];
+                if (value <= last[value / per_producer]) in_order = false;
+                last[value / per_producer] = value;
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    bool once = true;
+    for (auto& count : seen) once = once && count == 1;
+    int rest;
+    cout << "popped: " << popped << ", each once: " << once << ", in order: " << in_order
+         << ", empty after: " << !q_3.try_pop(rest) << endl;
+
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include <string>
+
+#include "common_test_funcs.h"
+#include "../Headers/List.h"
+#include "../Headers/NodePool.h"
+
+int main(){
+    MyStl::List<std::string, MyStl::NodePool<std::string>> l_1{"hello", "world", "I", "am", "Fred"};
+    MyStl::Tests::print(l_1, "list_1");
+
+    //erased nodes go back to the free list and are handed out again
+    l_1.pop_front();
+    l_1.pop_front();
+    l_1.push_back("Huang");
+    l_1.push_front("!!!");
+    MyStl::Tests::print(l_1, "list_1");
+
+    //a copy gets a pool of its own, a move takes the pool along with the nodes
+    MyStl::List<std::string, MyStl::NodePool<std::string>> l_2(l_1);
+    l_1.clear();
+    MyStl::List<std::string, MyStl::NodePool<std::string>> l_3(std::move(l_2));
+    MyStl::Tests::print(l_3, "list_3");
+
+    //more nodes than a single slab holds
+    MyStl::List<int, MyStl::NodePool<int, 4>> l_4;
+    for (int i = 0; i < 10; ++i) l_4.push_back(i);
+    l_4.remove_if([](const int& x) -> bool{return x % 2 == 0;});
+    MyStl::Tests::print(l_4, "list_4");
+
+    //built on list_4's allocator, so the two share pools and can trade nodes
+    MyStl::List<int, MyStl::NodePool<int, 4>> l_5(l_4.get_allocator());
+    for (int i = 10; i < 16; ++i) l_5.push_back(i);
+    l_5.splice(l_5.begin(), std::move(l_4));
+    l_4.push_back(-1);
+    l_4.merge(std::move(l_5));
+    MyStl::Tests::print(l_4, "list_4 merged");
+
+    MyStl::Slab_Pool pool(sizeof(int), 2);
+    void* p_1 = pool.allocate();
+    void* p_2 = pool.allocate();
+    pool.deallocate(p_1);
+    std::cout << (pool.allocate() == p_1) << " " << (p_1 != p_2) << std::endl;
+
+    return 0;
+}
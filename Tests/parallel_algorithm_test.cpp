@@ -0,0 +1,71 @@
+#include <atomic>
+#include <stdexcept>
+#include <string>
+
+// more threads than the machine may have, so the pieces really do run on the workers
+#define MYSTL_DEFAULT_POOL_THREADS 4
+#define MYSTL_PARALLEL_MIN_CHUNK 1000
+
+#include "common_test_funcs.h"
+#include "../Headers/ParallelAlgorithm.h"
+#include "../Headers/Array.h"
+#include "../Headers/Deque.h"
+#include "../Headers/Vector.h"
+
+int main(){
+    cout << "threads: " << MyStl::Thread_Pool::default_pool().concurrency() << endl;
+
+    const int n = 100000;
+    MyStl::Vector<int> v_1(n);
+    MyStl::fill(MyStl::execution::par, v_1.begin(), v_1.end(), 7);
+    long long sum = 0;
+    MyStl::for_each(MyStl::execution::seq, v_1.begin(), v_1.end(), [&sum](int x){sum += x;});
+    cout << "sum after fill: " << sum << endl;
+
+    //each piece has its own copy of the function, shared state has to be atomic
+    for (int i = 0; i < n; ++i) v_1[i] = i;
+    std::atomic<long long> total{0};
+    MyStl::for_each(MyStl::execution::par, v_1.begin(), v_1.end(), [&total](int x){total += x;});
+    cout << "parallel sum: " << total << endl;
+
+    //copy from a vector into a deque and back, the deque is still copied per block
+    MyStl::Deque<int> d_1(n);
+    MyStl::copy(MyStl::execution::par_unseq, v_1.begin(), v_1.end(), d_1.begin());
+    cout << "deque equal: " << MyStl::equal(MyStl::execution::par, d_1.begin(), d_1.end(), v_1.begin()) << endl;
+    d_1[n - 3] = -1;
+    cout << "after a change: " << MyStl::equal(MyStl::execution::par, d_1.begin(), d_1.end(), v_1.begin()) << endl;
+
+    //matches keep their order
+    MyStl::Vector<int> v_2(n);
+    auto end = MyStl::copy_if(MyStl::execution::par, v_1.begin(), v_1.end(), v_2.begin(), [](int x){return x % 7 == 3;});
+    v_2.erase(end, v_2.end());
+    bool in_order = true;
+    for (std::size_t i = 0; i < v_2.size(); ++i) in_order = in_order && v_2[i] == static_cast<int>(7 * i + 3);
+    cout << "copy_if kept " << v_2.size() << " in order: " << in_order << endl;
+
+    //short ranges and iterators without random access run on the calling thread
+    MyStl::Array<int, 5> a_1{{1, 2, 3, 4, 5}};
+    MyStl::Array<int, 5> a_2{};
+    MyStl::copy_if(MyStl::execution::par, a_1.begin(), a_1.end(), a_2.begin(), [](int x){return x % 2;});
+    MyStl::Tests::print(a_2, "odd");
+
+    //the first exception gets to the caller
+    try {
+        MyStl::for_each(MyStl::execution::par, v_1.begin(), v_1.end(), [](int x){
+            if (x == 54321) throw std::runtime_error("bad element " + std::to_string(x));
+        });
+    } catch (const std::runtime_error& e) {
+        cout << "caught: " << e.what() << endl;
+    }
+
+    //a parallel algorithm inside another one runs its pieces itself
+    MyStl::Vector<MyStl::Vector<int>> rows(8, MyStl::Vector<int>(n / 8));
+    MyStl::for_each(MyStl::execution::par, rows.begin(), rows.end(), [](MyStl::Vector<int>& row){
+        MyStl::fill(MyStl::execution::par, row.begin(), row.end(), 1);
+    });
+    sum = 0;
+    for (auto& row : rows) for (int x : row) sum += x;
+    cout << "nested fill: " << sum << endl;
+
+    return 0;
+}
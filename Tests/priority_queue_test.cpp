@@ -0,0 +1,59 @@
+#include <functional>
+#include <string>
+
+#include "common_test_funcs.h"
+#include "../Headers/PriorityQueue.h"
+#include "../Headers/Algorithm.h"
+#include "../Headers/Deque.h"
+#include "../Headers/Vector.h"
+
+int main(){
+    //heap algorithms on a plain range
+    MyStl::Vector<int> v_1{5, 3, 9, 3, 1, 8, 0, 7};
+    MyStl::make_heap(v_1.begin(), v_1.end());
+    cout << "v_1 is heap: " << MyStl::is_heap(v_1.begin(), v_1.end()) << ", top " << v_1.front() << endl;
+
+    v_1.push_back(11);
+    MyStl::push_heap(v_1.begin(), v_1.end());
+    MyStl::pop_heap(v_1.begin(), v_1.end());
+    cout << "popped " << v_1.back() << ", top " << v_1.front() << endl;
+    v_1.pop_back();
+
+    MyStl::sort_heap(v_1.begin(), v_1.end());
+    MyStl::Tests::print(v_1, "v_1 sorted");
+
+    //binary max queue
+    MyStl::priority_queue<std::string> q_1{"pear", "fig", "apple", "kiwi"};
+    q_1.push("zucchini");
+    q_1.emplace(3, 'b');
+    cout << "q_1: ";
+    while (!q_1.empty()){
+        cout << q_1.top() << " ";
+        q_1.pop();
+    }
+    cout << endl;
+
+    //4-ary min queue over a deque, filled in bulk
+    MyStl::priority_queue<int, MyStl::Deque<int>, std::greater<int>, 4> q_2;
+    MyStl::Vector<int> v_2;
+    for (int i = 0; i < 1000; ++i) v_2.push_back((i * 7919) % 1009);
+    q_2.push_range(v_2.begin(), v_2.end());
+    q_2.push_range(v_2.begin(), v_2.begin() + 3);
+    cout << "q_2 size " << q_2.size() << ", smallest: ";
+    for (int i = 0; i < 5; ++i){
+        cout << q_2.top() << " ";
+        q_2.pop();
+    }
+    cout << endl;
+
+    //a timer: the earliest deadline runs and goes back in a period later
+    MyStl::quaternary_priority_queue<long, MyStl::Vector<long>, std::greater<long>> timers{30, 10, 20};
+    for (int i = 0; i < 5; ++i){
+        long deadline = timers.top();
+        cout << deadline << " ";
+        timers.replace_top(deadline + 25);
+    }
+    cout << "next " << timers.top() << endl;
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include <string>
+
+#include "common_test_funcs.h"
+#include "../Headers/SmallVector.h"
+
+using MyStl::SmallVector;
+
+int main(){
+    SmallVector<int, 4> sv_1;
+    SmallVector<char, 4> sv_2(3, 'a');
+    SmallVector<std::string, 2> sv_3{"hello", "world", "I'm", "Fred"};
+    SmallVector<int, 4> sv_4{1, 2, 3};
+
+    MyStl::Tests::print(sv_1, "sv_1");
+    MyStl::Tests::print(sv_2, "sv_2");
+    MyStl::Tests::print(sv_3, "sv_3");
+    cout << "sv_2 inline: " << sv_2.is_inline() << ", sv_3 inline: " << sv_3.is_inline() << endl;
+
+    //spills to the heap once the inline buffer is full
+    for (int i = 0; i < 6; ++i) sv_1.push_back(i);
+    MyStl::Tests::print(sv_1, "sv_1");
+    cout << "sv_1 inline: " << sv_1.is_inline() << ", capacity: " << sv_1.capacity() << endl;
+
+    //and comes back once the elements fit again
+    sv_1.erase(sv_1.begin() + 1, sv_1.end() - 1);
+    sv_1.shrink_to_fit();
+    MyStl::Tests::print(sv_1, "sv_1");
+    cout << "sv_1 inline: " << sv_1.is_inline() << ", capacity: " << sv_1.capacity() << endl;
+
+    sv_4.insert(sv_4.begin(), 0);
+    sv_4.insert(sv_4.end(), 2, 9);
+    sv_4.emplace(sv_4.begin() + 2, 7);
+    sv_4.insert(sv_4.begin() + 1, {-1, -2});
+    MyStl::Tests::print(sv_4, "sv_4");
+
+    //moving an inline vector moves the elements, moving a spilled one takes the buffer
+    SmallVector<char, 4> sv_5(std::move(sv_2));
+    SmallVector<std::string, 2> sv_6(std::move(sv_3));
+    MyStl::Tests::print(sv_5, "sv_5");
+    MyStl::Tests::print(sv_6, "sv_6");
+    MyStl::Tests::print(sv_3, "sv_3");
+
+    SmallVector<std::string, 2> sv_7{"tiny"};
+    sv_7.swap(sv_6);
+    MyStl::Tests::print(sv_6, "sv_6");
+    MyStl::Tests::print(sv_7, "sv_7");
+
+    sv_6 = sv_7;
+    sv_7.resize(1);
+    cout << "sv_6 == sv_7: " << (sv_6 == sv_7) << ", sv_7 < sv_6: " << (sv_7 < sv_6) << endl;
+
+    for (auto it = sv_4.rbegin(); it != sv_4.rend(); ++it) cout << *it << " ";
+    cout << endl;
+
+    return 0;
+}
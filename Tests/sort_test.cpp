@@ -0,0 +1,96 @@
+#include <functional>
+#include <string>
+
+#include "common_test_funcs.h"
+#include "../Headers/Sort.h"
+#include "../Headers/Array.h"
+#include "../Headers/Deque.h"
+#include "../Headers/Vector.h"
+
+template<typename It> bool
+is_sorted(It first, It last){
+    if (first == last) return true;
+    for (It next = first + 1; next != last; ++first, ++next){
+        if (*next < *first) return false;
+    }
+    return true;
+}
+
+int main(){
+    MyStl::Vector<int> v_1{5, 3, 9, 3, 1, 8, 0, 7};
+    MyStl::sort(v_1.begin(), v_1.end());
+    MyStl::Tests::print(v_1, "v_1");
+
+    MyStl::sort(v_1.begin(), v_1.end(), std::greater<int>());
+    MyStl::Tests::print(v_1, "v_1 descending");
+
+    MyStl::Array<std::string, 4> a_1{{"pear", "fig", "apple", "kiwi"}};
+    MyStl::sort(a_1.begin(), a_1.end(), [](const std::string& l, const std::string& r){return l.size() < r.size();});
+    MyStl::Tests::print(a_1, "a_1 by length");
+
+    //long enough for the partitioning to kick in, on a deque's blocks
+    MyStl::Deque<long> d_1;
+    for (long i = 0; i < 100000; ++i) d_1.push_back((i * 7919) % 100003);
+    MyStl::sort(d_1.begin(), d_1.end());
+    cout << "d_1 sorted: " << is_sorted(d_1.begin(), d_1.end()) << ", front " << d_1.front() << ", back " << d_1.back() << endl;
+
+    //sorted, reversed and all equal input
+    MyStl::Vector<int> v_2;
+    for (int i = 0; i < 50000; ++i) v_2.push_back(i);
+    MyStl::sort(v_2.begin(), v_2.end());
+    MyStl::sort(v_2.begin(), v_2.end(), std::greater<int>());
+    cout << "v_2 reversed: " << (v_2.front() == 49999 && v_2.back() == 0) << endl;
+    MyStl::fill(v_2.begin(), v_2.end(), 4);
+    MyStl::sort(v_2.begin(), v_2.end());
+    cout << "v_2 all equal sorted: " << is_sorted(v_2.begin(), v_2.end()) << endl;
+
+    //radix sort by a key, equal keys keep their order
+    struct Item {std::string name; int rank;};
+    MyStl::Vector<Item> items{{"c", 2}, {"a", -1}, {"d", 2}, {"b", 0}, {"e", -1}};
+    MyStl::radix_sort(items.begin(), items.end(), [](const Item& item){return item.rank;});
+    cout << "items by rank: ";
+    for (const Item& item : items) cout << item.name << item.rank << " ";
+    cout << endl;
+
+    MyStl::Deque<double> d_2{2.5, -0.5, 1e300, -3.0, 0.0, -1e-300};
+    MyStl::radix_sort(d_2.begin(), d_2.end());
+    MyStl::Tests::print(d_2, "d_2");
+
+    MyStl::Vector<unsigned> v_3;
+    for (unsigned i = 0; i < 100000; ++i) v_3.push_back(i * 2654435761u);
+    MyStl::radix_sort(v_3.begin(), v_3.end());
+    cout << "v_3 sorted: " << is_sorted(v_3.begin(), v_3.end()) << endl;
+
+    //stable sort keeps equal elements in order, a sorted range with a few appended is merged in linear time
+    MyStl::Deque<Item> d_3{{"x", 3}, {"y", 1}, {"z", 3}, {"w", 1}, {"v", 2}};
+    MyStl::stable_sort(d_3.begin(), d_3.end(), [](const Item& l, const Item& r){return l.rank < r.rank;});
+    cout << "d_3 by rank: ";
+    for (const Item& item : d_3) cout << item.name << item.rank << " ";
+    cout << endl;
+
+    MyStl::Vector<int> v_4;
+    for (int i = 0; i < 100000; ++i) v_4.push_back(2 * i);
+    for (int i = 0; i < 1000; ++i) v_4.push_back((i * 7919) % 200000);
+    MyStl::stable_sort(v_4.begin(), v_4.end());
+    cout << "v_4 sorted: " << is_sorted(v_4.begin(), v_4.end()) << endl;
+
+    //selection: the median, the 3 smallest in order, and the 3 largest of a stream
+    MyStl::Deque<int> d_4{7, 2, 9, 4, 4, 1, 8, 6, 3};
+    MyStl::nth_element(d_4.begin(), d_4.begin() + 4, d_4.end());
+    cout << "d_4 median: " << *(d_4.begin() + 4) << endl;
+
+    MyStl::Vector<int> v_5{7, 2, 9, 4, 4, 1, 8, 6, 3};
+    MyStl::partial_sort(v_5.begin(), v_5.begin() + 3, v_5.end());
+    MyStl::Tests::print(v_5, "v_5 smallest 3 first");
+
+    MyStl::Array<int, 3> a_2;
+    MyStl::partial_sort_copy(d_4.begin(), d_4.end(), a_2.begin(), a_2.end(), std::greater<int>());
+    MyStl::Tests::print(a_2, "a_2 largest 3");
+
+    MyStl::Top_K<int> top(3);
+    for (int i = 0; i < 100000; ++i) top.push((i * 7919) % 100003);
+    MyStl::Vector<int> v_6 = top.sorted();
+    MyStl::Tests::print(v_6, "v_6 largest 3 pushed");
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include <string>
+#include <thread>
+
+#include "common_test_funcs.h"
+#include "../Headers/SpscRing.h"
+#include "../Headers/Vector.h"
+#include "../Headers/Deque.h"
+
+int main(){
+    //capacity is rounded up to a power of two
+    MyStl::SpscRing<std::string> r_1(5);
+    cout << "capacity: " << r_1.capacity() << endl;
+
+    r_1.try_push("hello");
+    r_1.try_emplace(3, '!');
+    std::string s;
+    r_1.try_pop(s);
+    cout << s << " " << r_1.size() << endl;
+    r_1.try_pop(s);
+    cout << s << " " << r_1.empty() << " " << r_1.try_pop(s) << endl;
+
+    //a batch stops at the first element that doesn't fit
+    MyStl::Vector<std::string> v{"hello", "world", "I", "am", "Fred", "Huang", "!!!", "from", "the", "ring"};
+    auto rest = r_1.try_push(v.begin(), v.end());
+    v.erase(v.begin(), rest);
+    MyStl::Tests::print(v, "left in vector");
+
+    MyStl::Deque<std::string> d;
+    r_1.try_pop(d, 3);
+    MyStl::Tests::print(d, "deque after 3");
+    r_1.try_pop(d);
+    MyStl::Tests::print(d, "deque after all");
+
+    //one producer, one consumer
+    MyStl::SpscRing<int> r_2(64);
+    long long sum = 0;
+    std::thread consumer([&](){
+        int x, seen = 0;
+        while (seen < 100000){
+            if (r_2.try_pop(x)){
+                sum += x;
+                ++seen;
+            }
+        }
+    });
+    for (int i = 0; i < 100000; ++i){
+        while (!r_2.try_push(i)) {}
+    }
+    consumer.join();
+    cout << "sum: " << sum << endl;
+
+    return 0;
+}
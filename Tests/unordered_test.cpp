@@ -0,0 +1,47 @@
+#include <string>
+
+#include "common_test_funcs.h"
+#include "../Headers/unordered_set.h"
+#include "../Headers/unordered_map.h"
+
+int main(){
+    MyStl::unordered_set<int> us_1;
+    MyStl::unordered_set<std::string> us_2{"hello", "world", "hello", "Fred"};
+
+    MyStl::Tests::print(us_1, "us_1");
+    cout << "us_2 size: " << us_2.size() << ", contains world: " << us_2.contains("world") << endl;
+
+    //grows past several rehashes and drops erased keys again
+    for (int i = 0; i < 1000; ++i) us_1.insert(i);
+    for (int i = 0; i < 1000; i += 2) us_1.erase(i);
+    cout << "us_1 size: " << us_1.size() << ", buckets: " << us_1.bucket_count()
+         << ", count(3): " << us_1.count(3) << ", count(4): " << us_1.count(4) << endl;
+
+    MyStl::unordered_set<int> us_3(us_1);
+    us_3.erase(us_3.find(999));
+    cout << "us_1 == us_3: " << (us_1 == us_3) << endl;
+
+    MyStl::unordered_map<std::string, int> um_1{{"one", 1}, {"two", 2}};
+    um_1["three"] = 3;
+    um_1.try_emplace("one", 100);
+    um_1.insert_or_assign("two", 22);
+    um_1.emplace("four", 4);
+
+    int sum = 0;
+    for (auto& kv : um_1) sum += kv.second;
+    cout << "um_1 size: " << um_1.size() << ", one: " << um_1.at("one")
+         << ", two: " << um_1["two"] << ", sum: " << sum << endl;
+
+    MyStl::unordered_map<std::string, int> um_2(std::move(um_1));
+    um_2.erase("three");
+    cout << "um_1 size: " << um_1.size() << ", um_2 size: " << um_2.size()
+         << ", um_2 contains three: " << um_2.contains("three") << endl;
+
+    try{
+        um_2.at("three");
+    }catch(const std::out_of_range& e){
+        cout << "at: " << e.what() << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include <string>
+
+#include "common_test_funcs.h"
+#include "../Headers/UnrolledList.h"
+#include "../Headers/Vector.h"
+
+int main(){
+    MyStl::UnrolledList<std::string> l_1{"hello", "world", "I", "am", "Fred"};
+    MyStl::Tests::print(l_1, "list_1");
+    cout << "chunk size: " << l_1.chunk_size << endl;
+
+    //small chunks to show the splits and merges
+    MyStl::UnrolledList<int, std::allocator<int>, 4> l_2;
+    for (int i = 0; i < 10; ++i) l_2.push_back(i);
+    auto it = l_2.begin();
+    for (int i = 0; i < 5; ++i) ++it;
+    it = l_2.insert(it, 100);
+    l_2.insert(it, 3, -1);
+    MyStl::Tests::print(l_2, "list_2");
+
+    l_2.remove_if([](const int& x) -> bool{return x < 0 || x % 2 == 1;});
+    MyStl::Tests::print(l_2, "list_2");
+
+    //whole chunks move over, iterators into the other list stay valid
+    MyStl::Vector<int> v{7, 7, 7, 7, 7};
+    MyStl::UnrolledList<int, std::allocator<int>, 4> l_3(v.begin(), v.end());
+    auto seven = ++l_3.begin();
+    l_2.splice(++l_2.begin(), std::move(l_3));
+    MyStl::Tests::print(l_2, "list_2 spliced");
+    MyStl::Tests::print(l_3, "list_3");
+    cout << *seven << " " << l_2.size() << " " << l_2.front() << " " << l_2.back() << endl;
+
+    //bulk algorithms run chunk by chunk
+    MyStl::Vector<int> out(l_2.size());
+    MyStl::copy(l_2.begin(), l_2.end(), out.begin());
+    MyStl::Tests::print(out, "copied out");
+
+    MyStl::UnrolledList<std::string> l_4(l_1);
+    l_4.pop_front();
+    l_4.push_front("hi");
+    cout << (l_1 == l_4) << " ";
+    l_4 = l_1;
+    cout << (l_1 == l_4) << endl;
+
+    return 0;
+}
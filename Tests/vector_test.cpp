@@ -3,6 +3,19 @@
 
 using MyStl::Vector;
 
+// not trivially copyable, but its bytes can be moved around, so Vector may relocate it with memcpy
+struct Handle{
+    std::string* p;
+    Handle(const char* s): p(new std::string(s)){}
+    Handle(Handle&& other) noexcept : p(other.p){other.p = nullptr;}
+    Handle& operator=(Handle&& other) noexcept {std::swap(p, other.p); return *this;}
+    ~Handle(){delete p;}
+};
+
+namespace MyStl{
+    template <> struct is_trivially_relocatable<Handle> : std::true_type {};
+}
+
 int main(){
     Vector<int> v1;
     Vector<char> v2(9, 'a');
@@ -33,6 +46,10 @@ int main(){
 
     v7.resize(18, "hello");
     MyStl::Tests::print(v7, "vector_7");
+
+    Vector<Handle> v11;
+    for (int i = 0; i < 20; ++i) v11.emplace_back(i % 2 ? "odd" : "even");
+    std::cout << *v11.front().p << *v11.back().p << " " << v11.capacity() << std::endl;
     
     return 0;
 }